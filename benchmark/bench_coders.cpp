@@ -1,5 +1,6 @@
 #include <filesystem>
 #include <iostream>
+#include <span>
 #include <sstream>
 
 #include <tdc/code/binary_coder.hpp>
@@ -8,10 +9,22 @@
 #include <tdc/io/load_file.hpp>
 #include <tdc/math/idiv.hpp>
 #include <tdc/stat/phase.hpp>
+#include <tdc/util/literals.hpp>
 
 #include <tdc/code/binary_coder.hpp>
+#include <tdc/code/delta_coder.hpp>
 #include <tdc/code/delta0_coder.hpp>
 #include <tdc/code/rice_coder.hpp>
+#include <tdc/code/arith/context_mixing_coder.hpp>
+#include <tdc/code/ans/rans_coder.hpp>
+#include <tdc/code/ans/tans_coder.hpp>
+#include <tdc/code/huff/block_adaptive_huffman_coder.hpp>
+#include <tdc/code/huff/forward_coder.hpp>
+#include <tdc/code/huff/huffman_coder.hpp>
+#include <tdc/code/huff/hybrid_forward_coder.hpp>
+#include <tdc/code/huff/knuth_coder.hpp>
+#include <tdc/code/huff/multi_stream_huffman_coder.hpp>
+#include <tdc/code/huff/vitter_coder.hpp>
 
 #include <tlx/cmdline_parser.hpp>
 
@@ -32,29 +45,162 @@ stat::Phase benchmark_phase(std::string&& title) {
     return phase;
 }
 
+// logs the throughput of a phase in MB/s
+void log_throughput(stat::Phase& result, std::string&& key, const double time_ms) {
+    result.log(std::move(key), time_ms > 0 ? (double)(options.input.size() * sizeof(char_type)) / (time_ms * 1e3) : 0.0);
+}
+
+// logs the throughput of a phase in GB/s
+void log_throughput_gb(stat::Phase& result, std::string&& key, const double time_ms) {
+    result.log(std::move(key), time_ms > 0 ? (double)(options.input.size() * sizeof(char_type)) / (time_ms * 1e6) : 0.0);
+}
+
+// logs the number of values processed per second in a phase
+void log_values_per_s(stat::Phase& result, std::string&& key, const double time_ms) {
+    result.log(std::move(key), time_ms > 0 ? (double)options.input.size() / (time_ms * 1e-3) : 0.0);
+}
+
+void log_output(stat::Phase& result, const size_t bits_written) {
+    result.log("bits_written", bits_written);
+    result.log("output_size", math::idiv_ceil(bits_written, CHAR_BIT));
+    result.log("ratio", (double)bits_written / (double)(options.input.size() * CHAR_BIT * sizeof(char_type)));
+    result.log("bits_per_value", options.input.size() > 0 ? (double)bits_written / (double)options.input.size() : 0.0);
+}
+
 template<typename C>
 void bench(C constructor, stat::Phase& result) {
-    std::string enc;
+    std::ostringstream oss;
     {
         auto coder = constructor();
-
-        std::ostringstream oss;
         io::BitOStream out(oss);
         
+        // the initialization is part of encoding, coders may do most of their work there
+        stat::Phase phase("encode");
         stat::Phase::wrap("init", [&](){
             coder.encode_init(out, options.input.data(), options.input.size());
         });
         
-        stat::Phase::wrap("encode", [&](){
-            for(size_t i = 0; i < options.input.size(); i++) {
-                coder.encode(out, options.input[i]);
-            }
-        });
+        for(size_t i = 0; i < options.input.size(); i++) {
+            coder.encode(out, options.input[i]);
+        }
+        coder.encode_finalize(out);
+        log_throughput(result, "encode_mb_per_s", phase.time_info().elapsed());
+        log_values_per_s(result, "encode_values_per_s", phase.time_info().elapsed());
+        log_output(result, out.bits_written());
+    }
+
+    {
+        // the batch encoding must be identical, so it is not kept
+        auto coder = constructor();
+        std::ostringstream batch_oss;
+        io::BitOStream out(batch_oss);
+
+        stat::Phase phase("batch_encode");
+        coder.encode_init(out, options.input.data(), options.input.size());
+        coder.encode(out, std::span<const char_type>(options.input));
+        coder.encode_finalize(out);
+        log_values_per_s(result, "batch_encode_values_per_s", phase.time_info().elapsed());
+    }
+
+    const auto enc = oss.str();
+    size_t errors = 0;
+    {
+        auto coder = constructor();
+        io::BitIStream in(enc.data(), enc.size());
+        coder.decode_init(in);
+
+        stat::Phase phase("decode");
+        for(size_t i = 0; i < options.input.size(); i++) {
+            if(coder.template decode<char_type>(in) != options.input[i]) ++errors;
+        }
+        log_throughput(result, "decode_mb_per_s", phase.time_info().elapsed());
+        log_values_per_s(result, "decode_values_per_s", phase.time_info().elapsed());
+    }
+
+    {
+        auto coder = constructor();
+        io::BitIStream in(enc.data(), enc.size());
+        coder.decode_init(in);
+
+        std::vector<char_type> dec(options.input.size());
+        {
+            stat::Phase phase("batch_decode");
+            coder.decode(in, std::span<char_type>(dec));
+            log_values_per_s(result, "batch_decode_values_per_s", phase.time_info().elapsed());
+        }
+        if(dec != options.input) ++errors;
+    }
+    result.log("errors", errors);
+}
 
-        result.log("bits_written", out.bits_written());
-        result.log("output_size", math::idiv_ceil(out.bits_written(), CHAR_BIT));
-        result.log("ratio", (double)out.bits_written() / (double)(options.input.size() * CHAR_BIT * sizeof(char_type)));
-    }    
+// Huffman coders write their header on construction
+template<typename C>
+void bench_huffman(stat::Phase& result) {
+    const std::string s(options.input.begin(), options.input.end());
+
+    std::ostringstream oss;
+    {
+        io::BitOStream out(oss);
+
+        stat::Phase phase("encode");
+        C coder(s, out);
+        result.log("header_bits", out.bits_written());
+        for(size_t i = 0; i < options.input.size(); i++) {
+            coder.encode(out, options.input[i]);
+        }
+        log_throughput(result, "encode_mb_per_s", phase.time_info().elapsed());
+        log_output(result, out.bits_written());
+    }
+
+    {
+        const auto enc = oss.str();
+        io::BitIStream in(enc.data(), enc.size());
+
+        stat::Phase phase("decode");
+        C coder(in);
+        size_t errors = 0;
+        for(size_t i = 0; i < options.input.size(); i++) {
+            if(coder.decode(in) != options.input[i]) ++errors;
+        }
+        log_throughput(result, "decode_mb_per_s", phase.time_info().elapsed());
+        log_throughput_gb(result, "decode_gb_per_s", phase.time_info().elapsed());
+        result.log("errors", errors);
+    }
+}
+
+// block coders encode the input in independent blocks
+template<typename C>
+void bench_block(stat::Phase& result, const size_t block_size = 128_Ki) {
+    const size_t n = options.input.size();
+
+    std::ostringstream oss;
+    {
+        C coder;
+        stat::Phase phase("encode");
+        size_t bytes = 0;
+        for(size_t i = 0; i < n; i += block_size) {
+            bytes += coder.encode(options.input.data() + i, std::min(block_size, n - i), oss);
+        }
+        log_throughput(result, "encode_mb_per_s", phase.time_info().elapsed());
+        log_output(result, bytes * CHAR_BIT);
+    }
+
+    {
+        const auto enc = oss.str();
+        C coder;
+        std::vector<char_type> block;
+        size_t errors = 0;
+
+        stat::Phase phase("decode");
+        size_t pos = 0;
+        for(size_t i = 0; i < n; i += block_size) {
+            pos += coder.decode(enc.data() + pos, enc.size() - pos, block);
+            if(!std::equal(block.begin(), block.end(), options.input.begin() + i)) ++errors;
+        }
+        log_throughput(result, "decode_mb_per_s", phase.time_info().elapsed());
+        log_throughput_gb(result, "decode_gb_per_s", phase.time_info().elapsed());
+        result.log("errors", errors);
+    }
 }
 
 int main(int argc, char** argv) {
@@ -71,7 +217,7 @@ int main(int argc, char** argv) {
     {
         auto result = benchmark_phase("BinaryCoder");
      
-        bench([](){ return code::BinaryCoder(CHAR_BIT * sizeof(char_type)); }, result);
+        bench([](){ return code::BinaryCoder<CHAR_BIT * sizeof(char_type)>(); }, result);
         
         result.suppress([&](){
             std::cout << "RESULT algo=BinaryCoder " << result.to_keyval() << " " << result.subphases_keyval() << std::endl;
@@ -97,4 +243,103 @@ int main(int argc, char** argv) {
             std::cout << "RESULT algo=RiceCoder(" << e << ") " << result.to_keyval() << " " << result.subphases_keyval() << std::endl;
         });
     }
+
+    {
+        auto result = benchmark_phase("RANSCoder");
+        bench([](){ return code::RANSCoder<>(); }, result);
+        result.suppress([&](){
+            std::cout << "RESULT algo=RANSCoder " << result.to_keyval() << " " << result.subphases_keyval() << std::endl;
+        });
+    }
+
+    {
+        auto result = benchmark_phase("RANSCoder");
+        bench_block<code::RANSCoder<>>(result);
+        result.suppress([&](){
+            std::cout << "RESULT algo=RANSCoder(block) " << result.to_keyval() << " " << result.subphases_keyval() << std::endl;
+        });
+    }
+
+    {
+        auto result = benchmark_phase("TANSCoder");
+        bench([](){ return code::TANSCoder<>(); }, result);
+        result.suppress([&](){
+            std::cout << "RESULT algo=TANSCoder " << result.to_keyval() << " " << result.subphases_keyval() << std::endl;
+        });
+    }
+
+    {
+        auto result = benchmark_phase("ContextMixingCoder");
+        bench([](){ return code::ContextMixingCoder<>(); }, result);
+        result.suppress([&](){
+            std::cout << "RESULT algo=ContextMixingCoder " << result.to_keyval() << " " << result.subphases_keyval() << std::endl;
+        });
+    }
+
+    using SymCoder = code::BinaryCoder<CHAR_BIT * sizeof(char_type)>;
+    using FreqCoder = code::DeltaCoder;
+
+    {
+        auto result = benchmark_phase("HuffmanCoder");
+        bench_huffman<code::HuffmanCoder<SymCoder>>(result);
+        result.suppress([&](){
+            std::cout << "RESULT algo=HuffmanCoder " << result.to_keyval() << " " << result.subphases_keyval() << std::endl;
+        });
+    }
+
+    {
+        auto result = benchmark_phase("MultiStreamHuffmanCoder");
+        bench_block<code::MultiStreamHuffmanCoder<1>>(result);
+        result.suppress([&](){
+            std::cout << "RESULT algo=MultiStreamHuffmanCoder(1) " << result.to_keyval() << " " << result.subphases_keyval() << std::endl;
+        });
+    }
+
+    {
+        auto result = benchmark_phase("MultiStreamHuffmanCoder");
+        bench_block<code::MultiStreamHuffmanCoder<4>>(result);
+        result.suppress([&](){
+            std::cout << "RESULT algo=MultiStreamHuffmanCoder(4) " << result.to_keyval() << " " << result.subphases_keyval() << std::endl;
+        });
+    }
+
+    {
+        auto result = benchmark_phase("ForwardCoder");
+        bench_huffman<code::ForwardCoder<SymCoder, FreqCoder>>(result);
+        result.suppress([&](){
+            std::cout << "RESULT algo=ForwardCoder " << result.to_keyval() << " " << result.subphases_keyval() << std::endl;
+        });
+    }
+
+    {
+        auto result = benchmark_phase("HybridForwardCoder");
+        bench_huffman<code::HybridForwardCoder<SymCoder, FreqCoder>>(result);
+        result.suppress([&](){
+            std::cout << "RESULT algo=HybridForwardCoder " << result.to_keyval() << " " << result.subphases_keyval() << std::endl;
+        });
+    }
+
+    {
+        auto result = benchmark_phase("KnuthCoder");
+        bench_huffman<code::KnuthCoder<SymCoder>>(result);
+        result.suppress([&](){
+            std::cout << "RESULT algo=KnuthCoder " << result.to_keyval() << " " << result.subphases_keyval() << std::endl;
+        });
+    }
+
+    {
+        auto result = benchmark_phase("VitterCoder");
+        bench_huffman<code::VitterCoder<SymCoder>>(result);
+        result.suppress([&](){
+            std::cout << "RESULT algo=VitterCoder " << result.to_keyval() << " " << result.subphases_keyval() << std::endl;
+        });
+    }
+
+    {
+        auto result = benchmark_phase("BlockAdaptiveHuffmanCoder");
+        bench_huffman<code::BlockAdaptiveHuffmanCoder<>>(result);
+        result.suppress([&](){
+            std::cout << "RESULT algo=BlockAdaptiveHuffmanCoder " << result.to_keyval() << " " << result.subphases_keyval() << std::endl;
+        });
+    }
 }
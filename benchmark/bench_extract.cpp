@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <tdc/comp/lz77/factor_stream_index.hpp>
+#include <tdc/comp/lz77/factor_stream_index_output.hpp>
+#include <tdc/comp/lz77/lz77_sa.hpp>
+#include <tdc/comp/lz77/lz77_sst.hpp>
+#include <tdc/io/input_source.hpp>
+#include <tdc/io/mmap_file.hpp>
+#include <tdc/random/seed.hpp>
+#include <tdc/stat/phase.hpp>
+#include <tdc/util/literals.hpp>
+
+#include <tlx/cmdline_parser.hpp>
+
+using namespace tdc;
+using namespace tdc::comp::lz77;
+
+struct {
+    std::string filename;
+    std::string output;
+    std::string algo = "sa";
+    size_t window = 64_Ki;
+    size_t interval = 1_Mi;
+    size_t max_window = 64_Ki;
+    size_t len = 1_Ki;
+    size_t queries = 10'000;
+    uint64_t seed = random::DEFAULT_SEED;
+
+    bool check = false;
+} options;
+
+int main(int argc, char** argv) {
+    tlx::CmdlineParser cp;
+    cp.add_param_string("file", options.filename, "The input file.");
+    cp.add_string('o', "output", options.output, "The prefix of the factor and index files (default: the input file name).");
+    cp.add_string('a', "algo", options.algo, "The compressor, either sa or sliding (default: sa).");
+    cp.add_bytes('w', "window", options.window, "The window length for the sliding compressor (default: 64 KiB).");
+    cp.add_bytes('i', "interval", options.interval, "The minimum distance between checkpoints (default: 1 MiB).");
+    cp.add_bytes("max-window", options.max_window, "The maximum window length stored for each checkpoint (default: 64 KiB).");
+    cp.add_bytes('l', "length", options.len, "The length of extracted substrings (default: 1 KiB).");
+    cp.add_bytes('q', "queries", options.queries, "The number of random substrings to extract (default: 10,000).");
+    cp.add_bytes("seed", options.seed, "The random seed for queries.");
+    cp.add_flag("check", options.check, "Check extracted substrings for correctness.");
+    if(!cp.process(argc, argv)) {
+        return -1;
+    }
+
+    if(options.output.empty()) options.output = options.filename;
+    const std::string factors_filename = options.output + ".factors";
+    const std::string index_filename = options.output + ".index";
+
+    io::MMapReadOnlyFile file(options.filename);
+    const char_t* text = (const char_t*)file.data();
+    const size_t n = file.size() / sizeof(char_t);
+    if(n == 0 || text == nullptr) {
+        std::cerr << "input file is empty or could not be mapped to memory" << std::endl;
+        return -1;
+    }
+
+    stat::Phase result("result");
+
+    stat::Phase::wrap("compress", [&](){
+        std::ofstream factors(factors_filename);
+        std::ofstream index(index_filename);
+        FactorStreamIndexOutput out(text, factors, index, options.interval, options.max_window);
+
+        io::InputSource input(file);
+        if(options.algo == "sliding") {
+            LZ77SlidingSuffixTree(options.window).compress(input, out);
+        } else {
+            LZ77SA().compress(input, out);
+        }
+        out.finish();
+    });
+
+    io::MMapReadOnlyFile factors_file(factors_filename);
+    io::MMapReadOnlyFile index_file(index_filename);
+    FactorStreamIndex index(factors_file, index_file);
+
+    // extract random substrings
+    const size_t len = std::min(std::max(options.len, size_t(1)), n);
+    std::vector<char_t> buf(len);
+    std::vector<size_t> positions(options.queries);
+    {
+        std::mt19937_64 gen(options.seed);
+        for(auto& pos : positions) pos = gen() % (n - len + 1);
+    }
+
+    double extract_time;
+    {
+        stat::Phase phase("extract");
+        for(const size_t pos : positions) index.extract(pos, len, buf.data());
+        extract_time = phase.time_info().elapsed();
+    }
+
+    if(options.check) {
+        size_t errors = 0;
+        for(const size_t pos : positions) {
+            index.extract(pos, len, buf.data());
+            if(!std::equal(buf.begin(), buf.end(), text + pos)) ++errors;
+        }
+        result.log("errors", errors);
+    }
+
+    result.log("factor_bytes", std::filesystem::file_size(factors_filename));
+    result.log("index_bytes", std::filesystem::file_size(index_filename));
+    result.log("checkpoints", index.num_checkpoints());
+    result.log("queries", options.queries);
+    result.log("extract_len", len);
+    result.log("extract_us", options.queries > 0 ? extract_time * 1e3 / (double)options.queries : 0.0);
+
+    result.suppress([&](){
+        std::cout << "RESULT algo=" << options.algo << " input=" << options.filename << " n=" << n
+            << " interval=" << options.interval << " max_window=" << options.max_window
+            << " " << result.to_keyval() << " " << result.subphases_keyval() << std::endl;
+    });
+}
@@ -0,0 +1,154 @@
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include <unistd.h>
+
+#include <tdc/io/async_buffered_reader.hpp>
+#include <tdc/io/async_buffered_writer.hpp>
+#include <tdc/io/buffered_reader.hpp>
+#include <tdc/io/buffered_writer.hpp>
+#include <tdc/io/file_reader.hpp>
+#include <tdc/io/file_writer.hpp>
+#include <tdc/stat/phase.hpp>
+#include <tdc/util/literals.hpp>
+
+#include <tlx/cmdline_parser.hpp>
+
+using namespace tdc;
+
+using item_type = uint64_t;
+
+struct {
+    std::string input_file;
+    std::string output_file;
+    size_t input_size;
+    size_t bufsize = 64_Ki;
+    size_t queue_depth = 4;
+} options;
+
+stat::Phase benchmark_phase(std::string&& title) {
+    stat::Phase phase(std::move(title));
+    phase.log("input", options.input_file);
+    phase.log("input_size", options.input_size);
+    phase.log("bufsize", options.bufsize);
+    phase.log("queue_depth", options.queue_depth);
+    return phase;
+}
+
+// logs the throughput of a phase in MB/s
+void log_throughput(stat::Phase& result, std::string&& key, const double time_ms) {
+    result.log(std::move(key), time_ms > 0 ? (double)options.input_size / (time_ms * 1e3) : 0.0);
+}
+
+template<typename reader_t>
+item_type consume(reader_t& reader) {
+    item_type checksum = 0;
+    while(reader) checksum += reader.read();
+    return checksum;
+}
+
+template<typename writer_t>
+void produce(writer_t& writer) {
+    const size_t num = options.input_size / sizeof(item_type);
+    for(size_t i = 0; i < num; i++) writer.write(item_type(i) * 0x9E3779B97F4A7C15ULL);
+    writer.flush();
+}
+
+// benchmarks a function reading the input file and returning a checksum
+template<typename F>
+void bench_read(std::string&& algo, F read) {
+    auto result = benchmark_phase(std::string(algo));
+    {
+        stat::Phase phase("read");
+        result.log("checksum", read());
+        log_throughput(result, "read_mb_per_s", phase.time_info().elapsed());
+    }
+    result.suppress([&](){
+        std::cout << "RESULT algo=" << algo << " " << result.to_keyval() << " " << result.subphases_keyval() << std::endl;
+    });
+}
+
+// benchmarks a function writing the output file
+template<typename F>
+void bench_write(std::string&& algo, F write) {
+    // write back dirty pages of previous runs, which would otherwise throttle this one
+    sync();
+
+    auto result = benchmark_phase(std::string(algo));
+    {
+        stat::Phase phase("write");
+        write();
+        log_throughput(result, "write_mb_per_s", phase.time_info().elapsed());
+    }
+    std::filesystem::remove(options.output_file);
+    result.suppress([&](){
+        std::cout << "RESULT algo=" << algo << " " << result.to_keyval() << " " << result.subphases_keyval() << std::endl;
+    });
+}
+
+int main(int argc, char** argv) {
+    tlx::CmdlineParser cp;
+    cp.add_param_string("file", options.input_file, "The input filename.");
+    cp.add_bytes('b', "bufsize", options.bufsize, "The number of items to buffer (default: 64Ki).");
+    cp.add_bytes('q', "queue-depth", options.queue_depth, "The number of buffers in flight for io_uring (default: 4).");
+    if(!cp.process(argc, argv)) {
+        return -1;
+    }
+
+    options.input_size = std::filesystem::file_size(options.input_file);
+    options.output_file = options.input_file + ".bench-io";
+
+    const struct {
+        const char* name;
+        io::FileBackend backend;
+        bool direct;
+    } file_variants[] = {
+        { "FileThread", io::FileBackend::thread, false },
+        { "FileThreadDirect", io::FileBackend::thread, true },
+        { "FileUring", io::FileBackend::automatic, false },
+        { "FileUringDirect", io::FileBackend::automatic, true },
+    };
+
+    // reading
+    bench_read("BufferedReader", [](){
+        std::ifstream stream(options.input_file);
+        io::BufferedReader<item_type> reader(stream, options.bufsize);
+        return consume(reader);
+    });
+
+    bench_read("AsyncBufferedReader", [](){
+        std::ifstream stream(options.input_file);
+        io::AsyncBufferedReader<item_type> reader(stream, options.bufsize);
+        return consume(reader);
+    });
+
+    for(auto& v : file_variants) {
+        bench_read(v.name, [&](){
+            io::FileReader<item_type> reader(options.input_file, options.bufsize, options.queue_depth, v.direct, v.backend);
+            return consume(reader);
+        });
+    }
+
+    // writing
+    bench_write("BufferedWriter", [](){
+        std::ofstream stream(options.output_file);
+        io::BufferedWriter<item_type> writer(stream, options.bufsize);
+        produce(writer);
+    });
+
+    bench_write("AsyncBufferedWriter", [](){
+        std::ofstream stream(options.output_file);
+        io::AsyncBufferedWriter<item_type> writer(stream, options.bufsize);
+        produce(writer);
+        writer.close();
+    });
+
+    for(auto& v : file_variants) {
+        bench_write(v.name, [&](){
+            io::FileWriter<item_type> writer(options.output_file, options.bufsize, options.queue_depth, v.direct, v.backend);
+            produce(writer);
+            writer.flush();
+        });
+    }
+}
@@ -9,17 +9,23 @@
 #include <tdc/code/binary_coder.hpp>
 #include <tdc/code/delta_coder.hpp>
 #include <tdc/code/rice_coder.hpp>
+#include <tdc/code/arith/context_mixing_coder.hpp>
+#include <tdc/code/huff/block_adaptive_huffman_coder.hpp>
 #include <tdc/code/huff/knuth_coder.hpp>
 
 #include <tdc/comp/lz77/factor_buffer.hpp>
-#include <tdc/comp/lz77/factor_file_output.hpp>
+#include <tdc/comp/lz77/factor_coder.hpp>
 #include <tdc/comp/lz77/factor_multi_output.hpp>
 #include <tdc/comp/lz77/factor_readable_output.hpp>
 #include <tdc/comp/lz77/factor_stats_output.hpp>
+#include <tdc/comp/lz77/factor_stream_output.hpp>
+#include <tdc/comp/lz77/factor_stream_reader.hpp>
 
 #include <tdc/comp/lz77/gzip.hpp>
 #include <tdc/comp/lz77/noop.hpp>
+#include <tdc/comp/lz77/lz77_optimal.hpp>
 #include <tdc/comp/lz77/lz77_sa.hpp>
+#include <tdc/comp/lz77/lz77_sst.hpp>
 #include <tdc/comp/lz77/lz77_sw.hpp>
 #include <tdc/comp/lz77/lzfp.hpp>
 #include <tdc/comp/lz77/lzfptop.hpp>
@@ -27,7 +33,8 @@
 
 #include <tdc/uint/uint128.hpp>
 #include <tdc/uint/uint256.hpp>
-#include <tdc/io/buffered_reader.hpp>
+#include <tdc/io/input_source.hpp>
+#include <tdc/io/mmap_file.hpp>
 #include <tdc/io/null_ostream.hpp>
 #include <tdc/stat/phase.hpp>
 #include <tdc/util/literals.hpp>
@@ -60,6 +67,8 @@ struct {
     std::string roundtrip;
     std::string encode;
     bool bzip2 = false;
+    bool block_huffman = false;
+    bool context_mixing = false;
     std::unordered_set<std::string> groups;
     
     bool do_bench(const std::string& group) {
@@ -119,20 +128,12 @@ double encode(const FactorBuffer& buf, const std::string& filename) {
     std::ofstream fenc(filename);
     tdc::io::BitOStream enc(fenc);
 
-    tdc::code::KnuthCoder<tdc::code::BinaryCoder<tdc::CHAR_BITS>> knuth;
-    size_t pos = 0;
-    for(size_t i = 0; i < buf.size(); i++) {
-        const auto& f = buf.factors()[i];
-        if(f.is_literal()) {
-            enc.write_bit(0);
-            knuth.encode(enc, f.literal());
-        } else {
-            assert(pos > f.src);
-            enc.write_bit(1);
-            enc.write_delta(pos - f.src);
-            enc.write_rice(f.len, 4);
-        }
-        pos += f.decoded_length();
+    if(options.context_mixing) {
+        FactorCoder<tdc::code::ContextMixingCoder<>>::encode(buf.factors(), enc);
+    } else if(options.block_huffman) {
+        FactorCoder<tdc::code::BlockAdaptiveHuffmanCoder<>>::encode(buf.factors(), enc);
+    } else {
+        FactorCoder<tdc::code::KnuthCoder<tdc::code::BinaryCoder<tdc::CHAR_BITS>>>::encode(buf.factors(), enc);
     }
     return phase.time_info().elapsed();
 }
@@ -142,7 +143,7 @@ void bench(const std::string& group, std::string&& name, ctor_t ctor, bool can_m
     if(!options.do_bench(group)) return;
 
     const size_t file_size = std::filesystem::file_size(options.filename);
-    std::ifstream input(options.filename);
+    tdc::io::InputSource input(options.filename);
     tdc::io::NullOStream devnull;
     
     {
@@ -150,6 +151,7 @@ void bench(const std::string& group, std::string&& name, ctor_t ctor, bool can_m
 
         FactorStatsOutput factors;
         double encode_time = 0.0;
+        size_t encode_size = 0;
 
         {
             auto c = ctor();
@@ -171,12 +173,16 @@ void bench(const std::string& group, std::string&& name, ctor_t ctor, bool can_m
                 FactorBuffer buf;
                 c.compress(input, buf);
                 encode_time = encode(buf, options.encode + "." + name);
+                encode_size = std::filesystem::file_size(options.encode + "." + name);
             } else if(options.merge && can_merge) {
                 std::ofstream fout(name);
-                tdc::io::BufferedWriter<Factor> factors_writer(fout, 10_Ki);
-                FactorFileOutput file_output(factors_writer);
-                FactorMultiOutput multi(factors, file_output);
+                FactorStreamOutput stream_output(fout);
+                FactorMultiOutput multi(factors, stream_output);
                 c.compress(input, multi);
+                stream_output.flush();
+
+                auto guard = phase.suppress();
+                phase.log("stream_size", stream_output.bytes_written());
             } else {
                 c.compress(input, factors);
             }
@@ -199,6 +205,7 @@ void bench(const std::string& group, std::string&& name, ctor_t ctor, bool can_m
         phase.log("max_ref_dist", stats.max_ref_dist);
         phase.log("avg_ref_dist", std::lround((double)stats.total_ref_dist / (double)stats.num_refs));
         if(encode_time > 0.0) phase.log("encode_time", encode_time);
+        if(encode_size > 0) phase.log("encode_size", encode_size);
         std::cout << "RESULT algo=" << name << " group=" << group << " input=" << options.filename << " " << phase.to_keyval() << std::endl;
 
         assert(stats.input_size == file_size);
@@ -209,17 +216,6 @@ void bench(const std::string& group, std::string&& name, ctor_t ctor, bool can_m
     }
 }
 
-FactorBuffer read_factors(const std::string& file) {
-    std::ifstream in(file);
-    tdc::io::BufferedReader<Factor> r(in, 1_Mi);
-
-    FactorBuffer buf;
-    while(r) {        
-        buf.emplace_back(r.read());
-    }
-    return buf;
-}
-
 void print_merge_result(const FactorStatsOutput& factors) {
     const auto& stats = factors.stats();
     std::cout << " input_size=" << stats.input_size;
@@ -239,13 +235,13 @@ void merge(const std::string& file1, const std::string& file2) {
         double encode_time = 0.0;
         FactorStatsOutput factors;
         {
-            auto f1 = read_factors(file1);
-            auto f2 = read_factors(file2);
-            FactorBuffer::merge(f1, f2, factors);
+            tdc::io::MMapReadOnlyFile f1(file1);
+            tdc::io::MMapReadOnlyFile f2(file2);
+            FactorBuffer::merge(FactorStreamReader(f1), FactorStreamReader(f2), factors);
 
             if(options.encode.length() > 0) {
                 FactorBuffer buf;
-                FactorBuffer::merge(f1, f2, buf);
+                FactorBuffer::merge(FactorStreamReader(f1), FactorStreamReader(f2), buf);
                 encode_time = encode(buf, options.encode + ".Merge(" + file1 + "," + file2 + ")");
             }
         }
@@ -261,10 +257,10 @@ void merge(const std::string& file1, const std::string& file2, const std::string
     if(std::filesystem::is_regular_file(file1) && std::filesystem::is_regular_file(file2) && std::filesystem::is_regular_file(file3)) {
         FactorStatsOutput factors;
         {
-            auto f1 = read_factors(file1);
-            auto f2 = read_factors(file2);
-            auto f3 = read_factors(file3);
-            FactorBuffer::merge(f1, f2, f3, factors);
+            tdc::io::MMapReadOnlyFile f1(file1);
+            tdc::io::MMapReadOnlyFile f2(file2);
+            tdc::io::MMapReadOnlyFile f3(file3);
+            FactorBuffer::merge(FactorStreamReader(f1), FactorStreamReader(f2), FactorStreamReader(f3), factors);
         }
         
         std::cout << "RESULT algo=Merge(" << file1 << "," << file2 << "," << file3 << ") input=" << options.filename;
@@ -292,6 +288,8 @@ int main(int argc, char** argv) {
         cp.add_string("roundtrip", options.roundtrip, "Outputs the factorization to the specified file and decodes it afterwards.");
         cp.add_string("encode", options.encode, "Encodes the factorization to the specified file.");
         cp.add_flag("bzip2", options.bzip2, "Encoding is done using bzip2 (if available).");
+        cp.add_flag("block-huffman", options.block_huffman, "Literals are encoded using block-adaptive instead of Knuth's adaptive Huffman codes.");
+        cp.add_flag("cm", options.context_mixing, "Literals are encoded using context mixing and arithmetic coding.");
         
         if(!cp.process(argc, argv)) {
             return -1;
@@ -315,7 +313,12 @@ int main(int argc, char** argv) {
     //~ bench("base", "Noop", [](){ return Noop(); });
     bench("base", "SA", [](){ return LZ77SA(); }, false);
     bench("gzip", "gzip", [](){ return GZip(); });
+    bench("optimal", "Optimal", [](){ return LZ77Optimal(tdc::code::DeltaCoder(), tdc::code::RiceCoder(4)); });
+    for(size_t level = 1; level <= 9; level++) {
+        bench("gzip-levels", "gzip(level=" + std::to_string(level) + ")", [level](){ return GZip(level); });
+    }
     bench("sliding", "Sliding", [](){ return LZ77SlidingWindow<false>(options.window); });
+    bench("sliding", "SlidingST", [](){ return LZ77SlidingSuffixTree(options.window); });
     bench("fp", "FP", [](){ return LZFingerprinting(options.tau_min, options.tau_max); });
     bench("fptop", "FPTop", [](){ return LZFingerprintingTop(options.filter_min_size, options.filter_size, 1ULL << options.cm_width, options.cm_height, options.tau_min, options.tau_max); });
 
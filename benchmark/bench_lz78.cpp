@@ -1,12 +1,18 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <sstream>
 
 #include <tdc/comp/lz78/binary_trie.hpp>
+#include <tdc/comp/lz78/bounded_lz78.hpp>
+#include <tdc/comp/lz78/hash_trie.hpp>
+#include <tdc/comp/lz78/hybrid_trie.hpp>
 #include <tdc/comp/lz78/lz78.hpp>
+#include <tdc/comp/lz78/lzw.hpp>
 #include <tdc/comp/lz78/stats.hpp>
 
+#include <tdc/io/input_source.hpp>
 #include <tdc/io/null_ostream.hpp>
 #include <tdc/stat/phase.hpp>
 #include <tdc/util/literals.hpp>
@@ -20,47 +26,107 @@ using char_t = unsigned char;
 struct {
     std::string filename;
     std::string ds;
+    size_t max_dict_size = SIZE_MAX;
+    bool reset = false;
+    bool check = false;
+
+    DictionaryPolicy policy() const {
+        return reset ? DictionaryPolicy::reset : DictionaryPolicy::freeze;
+    }
     
     bool do_bench(const std::string& group) {
         return ds.length() == 0 || ds == group;
     }
 } options;
 
-template<typename ctor_t>
-void bench(const std::string& group, std::string&& name, ctor_t ctor) {
+template<typename ctor_t, typename decoder_t>
+void bench(const std::string& group, std::string&& name, ctor_t ctor, decoder_t decoder) {
     if(!options.do_bench(group)) return;
     
-    std::ifstream input(options.filename);
-    tdc::io::NullOStream devnull;
+    tdc::io::InputSource input(options.filename);
     
+    tdc::stat::Phase result("result");
+    Stats stats;
+    std::ostringstream compressed;
+    double compress_time;
     {
         tdc::stat::Phase phase("compress");
-        Stats stats;
         {
             auto c = ctor();
-            // c.compress(input, std::cout);
-            c.compress(input, devnull);
+            c.compress(input, compressed);
             stats = c.stats();
         }
-        
-        auto guard = phase.suppress();
-        phase.log("input_size", stats.input_size);
-        phase.log("trie_size", stats.trie_size);
-        phase.log("num_refs", stats.trie_size);
-        phase.log("num_literals", 0); // for comparison to LZ77
-        // std::cout << std::endl;
-        std::cout << "RESULT algo=" << name << " group=" << group << " input=" << options.filename << " " << phase.to_keyval() << std::endl;
+        compress_time = phase.time_info().elapsed();
     }
+
+    std::string decompressed;
+    double decompress_time;
+    {
+        tdc::stat::Phase phase("decompress");
+        std::istringstream in(compressed.str());
+        if(options.check) {
+            std::ostringstream out;
+            decoder().decompress(in, out);
+            decompressed = out.str();
+        } else {
+            tdc::io::NullOStream devnull;
+            decoder().decompress(in, devnull);
+        }
+        decompress_time = phase.time_info().elapsed();
+    }
+
+    if(options.check) {
+        std::ifstream f(options.filename, std::ios::binary);
+        const std::string text((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+        result.log("errors", text == decompressed ? 0 : 1);
+    }
+
+    const size_t compressed_size = compressed.str().size();
+    result.log("input_size", stats.input_size);
+    result.log("trie_size", stats.trie_size);
+    result.log("num_refs", stats.num_factors);
+    result.log("num_literals", 0); // for comparison to LZ77
+    result.log("num_resets", stats.num_resets);
+    result.log("num_evictions", stats.num_evictions);
+    result.log("max_dict_size", options.max_dict_size);
+    result.log("compressed_size", compressed_size);
+    result.log("ratio", stats.input_size > 0 ? (double)compressed_size / (double)stats.input_size : 0.0);
+    result.log("compress_mb_per_s", compress_time > 0 ? (double)stats.input_size / (compress_time * 1e3) : 0.0);
+    result.log("decompress_mb_per_s", decompress_time > 0 ? (double)stats.input_size / (decompress_time * 1e3) : 0.0);
+
+    result.suppress([&](){
+        std::cout << "RESULT algo=" << name << " group=" << group << " input=" << options.filename
+            << " " << result.to_keyval() << " " << result.subphases_keyval() << std::endl;
+    });
 }
 
 int main(int argc, char** argv) {
     tlx::CmdlineParser cp;
     cp.add_param_string("file", options.filename, "The input file.");
     cp.add_string('a', "group", options.ds, "The algorithm group to benchmark.");
+    cp.add_bytes('d', "dict-size", options.max_dict_size, "The maximum number of dictionary phrases (default: unbounded).");
+    cp.add_flag("reset", options.reset, "Reset the dictionary when it is full instead of freezing it.");
+    cp.add_flag("check", options.check, "Check the decompressed output for correctness.");
     if(!cp.process(argc, argv)) {
         return -1;
     }
     
-    bench("base", "LZ78(FIFO)", [](){ return LZ78<BinaryTrie<char>, true>(); });
-    bench("base", "LZ78(MTF)", [](){ return LZ78<BinaryTrie<char, true>, true>(); });
+    const auto d = options.max_dict_size;
+    const auto p = options.policy();
+    auto lz78_decoder = [&](){ return LZ78Decoder(d, p); };
+    auto lzw_decoder = [&](){ return LZWDecoder(d, p); };
+
+    bench("base", "LZ78(FIFO)", [&](){ return LZ78<BinaryTrie<char>, true>(d, p); }, lz78_decoder);
+    bench("base", "LZ78(MTF)", [&](){ return LZ78<BinaryTrie<char, true>, true>(d, p); }, lz78_decoder);
+    bench("hash", "LZ78(Hash)", [&](){ return LZ78<HashTrie<char>, true>(d, p); }, lz78_decoder);
+    bench("hash", "LZ78(Hybrid)", [&](){ return LZ78<HybridTrie<char>, true>(d, p); }, lz78_decoder);
+    bench("lzw", "LZW(FIFO)", [&](){ return LZW<BinaryTrie<char>, true>(d, p); }, lzw_decoder);
+    bench("lzw", "LZW(Hash)", [&](){ return LZW<HashTrie<char>, true>(d, p); }, lzw_decoder);
+    bench("lzw", "LZW(Hybrid)", [&](){ return LZW<HybridTrie<char>, true>(d, p); }, lzw_decoder);
+
+    // bounded dictionaries, compare to LZ78(Hash) with the same dictionary size and the freeze or reset policy
+    if(options.max_dict_size < SIZE_MAX) {
+        bench("bounded", "LZ78(LRU)", [&](){ return BoundedLZ78<LRUEviction, true>(d); }, [&](){ return BoundedLZ78Decoder<LRUEviction>(d); });
+        bench("bounded", "LZ78(LFU)", [&](){ return BoundedLZ78<LFUEviction, true>(d); }, [&](){ return BoundedLZ78Decoder<LFUEviction>(d); });
+    }
 }
@@ -1,6 +1,8 @@
+#include <algorithm>
 #include <iostream>
 #include <vector>
 
+#include <tdc/io/load_file.hpp>
 #include <tdc/random/permutation.hpp>
 #include <tdc/random/vector.hpp>
 #include <tdc/stat/phase.hpp>
@@ -26,6 +28,9 @@ struct {
 
     uint64_t seed = random::DEFAULT_SEED;
 
+    std::string keys_filename;
+    bool keys_text = false;
+
     bool check = false;
 } options;
 
@@ -97,17 +102,32 @@ int main(int argc, char** argv) {
     cp.add_bytes('u', "universe", options.universe, "The size of the universe to draw from (default: 10 * n)");
     cp.add_bytes('q', "queries", options.num_queries, "The number to draw from the universe (default: 10M).");
     cp.add_bytes('s', "seed", options.seed, "The random seed.");
+    cp.add_string('k', "keys", options.keys_filename, "A file of 64-bit keys to use instead of random numbers.");
+    cp.add_flag("text", options.keys_text, "The keys file contains one decimal key per line.");
     cp.add_flag("check", options.check, "Check results for correctness.");
     if(!cp.process(argc, argv)) {
         return -1;
     }
 
-    if(!options.universe) {
-        options.universe = 10 * options.num;
-    }
+    if(!options.keys_filename.empty()) {
+        // load numbers
+        options.data = options.keys_text
+            ? io::load_file_lines_as_vector<uint64_t>(options.keys_filename)
+            : io::load_file_as_vector_parallel<uint64_t>(options.keys_filename);
+
+        std::sort(options.data.begin(), options.data.end());
+        options.num = options.data.size();
+        if(options.num < 2) {
+            std::cerr << "the keys file must contain at least two keys" << std::endl;
+            return -1;
+        }
+        options.universe = options.data[options.num - 1] + 1;
+    } else {
+        if(!options.universe) {
+            options.universe = 10 * options.num;
+        }
 
-    // generate numbers
-    {
+        // generate numbers
         auto perm = random::Permutation(options.universe, options.seed);
         options.data = perm.vector(options.num);
         std::sort(options.data.begin(), options.data.end());
@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <tdc/comp/rlz/rlz.hpp>
+#include <tdc/io/mmap_file.hpp>
+#include <tdc/random/seed.hpp>
+#include <tdc/stat/phase.hpp>
+#include <tdc/util/literals.hpp>
+
+#include <tlx/cmdline_parser.hpp>
+
+using namespace tdc;
+using namespace tdc::comp::rlz;
+
+struct {
+    std::string filename;
+    size_t prefix = SIZE_MAX;
+    size_t ref_size = 1_Mi;
+    size_t sample_len = 1_Ki;
+    size_t doc_size = 64_Ki;
+    std::string separator;
+    size_t min_len = 3;
+    size_t queries = 10'000;
+    uint64_t seed = random::DEFAULT_SEED;
+
+    bool check = false;
+} options;
+
+// splits the text into documents, given as pairs of offset and length
+std::vector<std::pair<size_t, size_t>> split(const char_t* text, const size_t n) {
+    std::vector<std::pair<size_t, size_t>> docs;
+    if(options.separator.length() > 0) {
+        // documents end with the separator character
+        const char_t sep = char_t(options.separator[0]);
+        size_t begin = 0;
+        for(size_t i = 0; i < n; i++) {
+            if(text[i] == sep) {
+                docs.emplace_back(begin, i + 1 - begin);
+                begin = i + 1;
+            }
+        }
+        if(begin < n) docs.emplace_back(begin, n - begin);
+    } else {
+        const size_t doc_size = std::max(options.doc_size, size_t(1));
+        for(size_t begin = 0; begin < n; begin += doc_size) {
+            docs.emplace_back(begin, std::min(doc_size, n - begin));
+        }
+    }
+    return docs;
+}
+
+int main(int argc, char** argv) {
+    tlx::CmdlineParser cp;
+    cp.add_param_string("file", options.filename, "The input file.");
+    cp.add_bytes('p', "prefix", options.prefix, "Only consider the given prefix of the input file.");
+    cp.add_bytes('r', "reference", options.ref_size, "The reference size (default: 1 MiB).");
+    cp.add_bytes('s', "sample", options.sample_len, "The length of each reference sample (default: 1 KiB).");
+    cp.add_bytes('d', "doc-size", options.doc_size, "The document size if no separator is given (default: 64 KiB).");
+    cp.add_string("separator", options.separator, "The character terminating each document, e.g., a newline.");
+    cp.add_bytes("min-len", options.min_len, "The minimum reference length (default: 3).");
+    cp.add_bytes('q', "queries", options.queries, "The number of random documents to decode (default: 10,000).");
+    cp.add_bytes("seed", options.seed, "The random seed for queries.");
+    cp.add_flag("check", options.check, "Check decoded documents for correctness.");
+    if(!cp.process(argc, argv)) {
+        return -1;
+    }
+
+    io::MMapReadOnlyFile file(options.filename);
+    if(file.data() == nullptr && file.size() > 0) {
+        std::cerr << "input file could not be mapped to memory" << std::endl;
+        return -1;
+    }
+    const char_t* text = (const char_t*)file.data();
+    const size_t n = std::min(file.size() / sizeof(char_t), options.prefix);
+    const auto docs = split(text, n);
+
+    stat::Phase result("result");
+
+    RLZ rlz = stat::Phase::wrap("reference", [&](){
+        auto ref = RLZ::sample_reference(text, n, options.ref_size, options.sample_len);
+        return RLZ(std::move(ref), options.min_len);
+    });
+
+    stat::Phase::wrap("compress", [&](){
+        for(const auto& [begin, len] : docs) rlz.add(text + begin, len);
+    });
+
+    // decode random documents
+    std::vector<char_t> buf(docs.empty() ? 0 : std::max_element(docs.begin(), docs.end(), [](const auto& a, const auto& b){ return a.second < b.second; })->second);
+    size_t decoded = 0;
+    double decode_time = 0;
+    if(!docs.empty()) {
+        std::mt19937_64 gen(options.seed);
+        stat::Phase phase("decode");
+        for(size_t k = 0; k < options.queries; k++) {
+            const size_t i = gen() % docs.size();
+            rlz.decode(i, buf.data());
+            decoded += docs[i].second;
+        }
+        decode_time = phase.time_info().elapsed();
+    }
+
+    if(options.check) {
+        size_t errors = 0;
+        for(size_t i = 0; i < docs.size(); i++) {
+            rlz.decode(i, buf.data());
+            if(!std::equal(buf.data(), buf.data() + docs[i].second, text + docs[i].first)) ++errors;
+        }
+        result.log("errors", errors);
+    }
+
+    // the compressed size includes the reference and, for each document, the offset of its factors and its size
+    const size_t compressed_size = rlz.reference().size() + rlz.encoded_size() + 2 * docs.size() * sizeof(uint64_t);
+    rlz.log_stats(result);
+    result.log("compressed_size", compressed_size);
+    result.log("ratio", n > 0 ? (double)compressed_size / (double)n : 0.0);
+    result.log("queries", options.queries);
+    result.log("decode_ns_per_doc", options.queries > 0 ? decode_time * 1e6 / (double)options.queries : 0.0);
+    result.log("decode_mb_per_s", decode_time > 0 ? (double)decoded / (decode_time * 1e3) : 0.0);
+
+    result.suppress([&](){
+        std::cout << "RESULT algo=RLZ input=" << options.filename << " n=" << n << " docs=" << docs.size()
+            << " " << result.to_keyval() << " " << result.subphases_keyval() << std::endl;
+    });
+}
@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <divsufsort.h>
+
+#include <tdc/stat/phase.hpp>
+#include <tdc/util/lcp.hpp>
+#include <tdc/util/literals.hpp>
+#include <tdc/util/parallel_sa.hpp>
+
+#include <tlx/cmdline_parser.hpp>
+
+using namespace tdc;
+
+struct {
+    std::string filename;
+    size_t prefix = SIZE_MAX;
+    std::vector<std::string> threads;
+
+    bool check = false;
+} options;
+
+std::string text;
+std::vector<saidx_t> ref_sa, ref_lcp;
+
+template<typename SAFunc, typename LCPFunc>
+void bench(const std::string& name, const size_t num_threads, SAFunc sa_func, LCPFunc lcp_func) {
+    const size_t n = text.length();
+    std::vector<saidx_t> sa(n), lcp(n), plcp(n);
+
+    stat::Phase result("result");
+    stat::Phase::wrap("sa", [&](){
+        sa_func(sa.data());
+    });
+    stat::Phase::wrap("lcp", [&](){
+        lcp_func(sa.data(), lcp.data(), plcp.data());
+    });
+
+    if(options.check) {
+        size_t sa_errors = 0, lcp_errors = 0;
+        for(size_t i = 0; i < n; i++) {
+            if(sa[i] != ref_sa[i]) ++sa_errors;
+            if(lcp[i] != ref_lcp[i]) ++lcp_errors;
+        }
+        result.log("sa_errors", sa_errors);
+        result.log("lcp_errors", lcp_errors);
+    }
+
+    result.suppress([&](){
+        std::cout << "RESULT algo=" << name << " threads=" << num_threads << " input=" << options.filename << " n=" << n
+            << " " << result.to_keyval() << " " << result.subphases_keyval() << std::endl;
+    });
+}
+
+int main(int argc, char** argv) {
+    tlx::CmdlineParser cp;
+    cp.add_param_string("file", options.filename, "The input file.");
+    cp.add_bytes('p', "prefix", options.prefix, "Only consider the given prefix of the input file.");
+    cp.add_stringlist('t', "threads", options.threads, "The thread counts to benchmark (default: powers of two up to the number of hardware threads).");
+    cp.add_flag("check", options.check, "Check results for correctness.");
+    if(!cp.process(argc, argv)) {
+        return -1;
+    }
+
+    // load input and terminate it
+    {
+        std::ifstream in(options.filename);
+        text = std::string(std::istreambuf_iterator<char>(in), {});
+        if(text.length() > options.prefix) text.resize(options.prefix);
+        std::replace(text.begin(), text.end(), char(0), char(1));
+        text.push_back(0);
+    }
+    const size_t n = text.length();
+    const auto* utext = (const sauchar_t*)text.data();
+
+    // determine thread counts
+    std::vector<size_t> thread_counts;
+    if(options.threads.empty()) {
+        const size_t max_threads = std::max(1U, std::thread::hardware_concurrency());
+        for(size_t t = 1; t < max_threads; t *= 2) thread_counts.push_back(t);
+        thread_counts.push_back(max_threads);
+    } else {
+        for(const auto& t : options.threads) thread_counts.push_back(std::stoull(t));
+    }
+
+    // sequential baseline
+    if(options.check) {
+        ref_sa.resize(n);
+        ref_lcp.resize(n);
+        std::vector<saidx_t> plcp(n);
+        divsufsort(utext, ref_sa.data(), (saidx_t)n);
+        lcp_kasai(utext, n, ref_sa.data(), ref_lcp.data(), plcp.data());
+    }
+
+    bench("divsufsort+kasai", 1,
+        [&](saidx_t* sa){ divsufsort(utext, sa, (saidx_t)n); },
+        [&](const saidx_t* sa, saidx_t* lcp, saidx_t* plcp){ lcp_kasai(utext, n, sa, lcp, plcp); });
+
+    // parallel
+    for(const size_t t : thread_counts) {
+        bench("prefix-doubling+phi", t,
+            [&](saidx_t* sa){ parallel_suffix_array(utext, n, sa, t); },
+            [&](const saidx_t* sa, saidx_t* lcp, saidx_t* plcp){ lcp_phi_parallel(utext, n, sa, lcp, plcp, t); });
+    }
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include <tdc/code/coder.hpp>
+#include <tdc/math/ilog2.hpp>
+
+namespace tdc {
+namespace code {
+
+/// \brief Symbol frequencies normalized to a power of two, as needed by asymmetric numeral system (ANS) coders.
+///
+/// Symbols are integers and mapped to dense indices in ascending order. Every occurring symbol receives a frequency of at least one.
+/// The symbols and their normalized frequencies can be written to and read from a bit stream as a header.
+class FrequencyTable {
+private:
+    size_t scale_bits_ = 0;
+    std::vector<uint64_t> syms_;  // symbol values in ascending order
+    std::vector<uint32_t> freq_;  // normalized frequency of each symbol index
+    std::vector<uint32_t> start_; // cumulative frequency of each symbol index
+    std::vector<uint32_t> index_; // symbol index of each symbol value
+
+    // scales counts so they sum up to 2^scale_bits_
+    void normalize(const std::vector<uint64_t>& counts, const uint64_t total) {
+        const uint64_t target = 1ULL << scale_bits_;
+        const size_t sigma = counts.size();
+
+        freq_.resize(sigma);
+        uint64_t sum = 0;
+        for(size_t i = 0; i < sigma; i++) {
+            freq_[i] = uint32_t(std::max(uint64_t(1), (counts[i] * target) / total));
+            sum += freq_[i];
+        }
+
+        // rounding down leaves a remainder, which is assigned to the most frequent symbol
+        const size_t max_i = std::max_element(counts.begin(), counts.end()) - counts.begin();
+        if(sum < target) {
+            freq_[max_i] += uint32_t(target - sum);
+        } else if(sum > target) {
+            // raising rare symbols to one may exceed the target, take the excess from the most frequent symbols
+            std::vector<size_t> order(sigma);
+            std::iota(order.begin(), order.end(), 0);
+            std::sort(order.begin(), order.end(), [&](const size_t a, const size_t b){ return freq_[a] > freq_[b]; });
+            while(sum > target) {
+                for(size_t k = 0; k < sigma && sum > target && freq_[order[k]] > 1; k++) {
+                    --freq_[order[k]];
+                    --sum;
+                }
+            }
+        }
+
+        start_.resize(sigma);
+        uint32_t c = 0;
+        for(size_t i = 0; i < sigma; i++) {
+            start_[i] = c;
+            c += freq_[i];
+        }
+        assert(c == target);
+    }
+
+    void build_index() {
+        index_.assign(syms_.empty() ? 0 : syms_.back() + 1, 0);
+        for(size_t i = 0; i < syms_.size(); i++) index_[syms_[i]] = uint32_t(i);
+    }
+
+public:
+    /// \brief The maximum supported symbol value, bounded because symbols are indexed in a dense array.
+    static constexpr uint64_t MAX_SYMBOL = (1ULL << 24) - 1;
+
+    /// \brief Counts the symbols of an array and normalizes their frequencies.
+    ///
+    /// The scale is raised beyond the requested number of bits if needed, so that every symbol can receive a frequency of at least one.
+    ///
+    /// \tparam array_t the array type
+    /// \param array the array
+    /// \param num the number of items in the array
+    /// \param scale_bits the requested logarithm of the sum of the normalized frequencies
+    template<typename array_t>
+    void count(const array_t& array, const size_t num, const size_t scale_bits) {
+        // histogram over symbol values
+        std::vector<uint64_t> hist;
+        for(size_t i = 0; i < num; i++) {
+            const uint64_t c = uint64_t(array[i]);
+            assert(c <= MAX_SYMBOL);
+            if(c >= hist.size()) hist.resize(c + 1, 0);
+            ++hist[c];
+        }
+
+        syms_.clear();
+        std::vector<uint64_t> counts;
+        for(size_t c = 0; c < hist.size(); c++) {
+            if(hist[c]) {
+                syms_.push_back(c);
+                counts.push_back(hist[c]);
+            }
+        }
+
+        scale_bits_ = std::max(scale_bits, math::ilog2_ceil(syms_.size()));
+        if(num > 0) normalize(counts, num);
+        build_index();
+    }
+
+    /// \brief Writes the symbols and their normalized frequencies.
+    /// \param out the bit output stream to write to
+    void encode_header(BitOStream& out) const {
+        out.write_delta(syms_.size() + 1);
+        if(!syms_.empty()) {
+            out.write_delta(scale_bits_ + 1);
+            uint64_t prev = 0;
+            for(size_t i = 0; i < syms_.size(); i++) {
+                out.write_delta(syms_[i] - prev + 1); // gap to the previous symbol
+                out.write_delta(freq_[i]);
+                prev = syms_[i];
+            }
+        }
+    }
+
+    /// \brief Reads the symbols and their normalized frequencies written by \ref encode_header.
+    /// \param in the bit input stream to read from
+    void decode_header(BitIStream& in) {
+        const size_t sigma = in.read_delta<>() - 1;
+        syms_.resize(sigma);
+        freq_.resize(sigma);
+        start_.resize(sigma);
+        if(sigma > 0) {
+            scale_bits_ = in.read_delta<>() - 1;
+            uint64_t prev = 0;
+            uint32_t c = 0;
+            for(size_t i = 0; i < sigma; i++) {
+                syms_[i] = prev + in.read_delta<>() - 1;
+                freq_[i] = in.read_delta<uint32_t>();
+                start_[i] = c;
+                c += freq_[i];
+                prev = syms_[i];
+            }
+        }
+        build_index();
+    }
+
+    /// \brief The logarithm of the sum of the normalized frequencies.
+    inline size_t scale_bits() const { return scale_bits_; }
+
+    /// \brief The number of distinct symbols.
+    inline size_t size() const { return syms_.size(); }
+
+    /// \brief The index of a symbol value, which must have been counted.
+    inline uint32_t index(const uint64_t c) const { return index_[c]; }
+
+    /// \brief The symbol value with the given index.
+    inline uint64_t symbol(const size_t i) const { return syms_[i]; }
+
+    /// \brief The normalized frequency of the symbol with the given index.
+    inline uint32_t freq(const size_t i) const { return freq_[i]; }
+
+    /// \brief The sum of the normalized frequencies of all symbols with a smaller index.
+    inline uint32_t start(const size_t i) const { return start_[i]; }
+};
+
+}} // namespace tdc::code
@@ -0,0 +1,348 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <sstream>
+#include <vector>
+
+#include <tdc/code/coder.hpp>
+#include <tdc/code/ans/frequency_table.hpp>
+
+namespace tdc {
+namespace code {
+
+/// \brief Static range asymmetric numeral system (rANS) coder [Duda, 2013].
+///
+/// The coder keeps 32-bit states in the range <tt>[2^16, 2^32)</tt> and renormalizes by 16-bit words.
+/// Consecutive symbols are assigned to a fixed number of interleaved states in round-robin fashion,
+/// so the state updates of neighbouring symbols are independent, which the batch decoder exploits.
+///
+/// Because rANS encodes in reverse order, the whole array announced via \ref encode_init is encoded at once,
+/// and \ref encode writes the renormalization output belonging to the next symbol in forward order.
+/// That way, the decoder reads exactly the bits of one symbol when decoding it, and the code can be mixed with other data on the same bit stream.
+///
+/// Reading the 16-bit words through a \ref BitIStream costs more than the state arithmetic, however.
+/// For bytes, the block interface (\ref encode(const Char*, size_t, std::ostream&) and \ref decode(const void*, size_t, std::vector<Char>&))
+/// stores the words byte-aligned after a header, so that the decoder renormalizes by reading them from a raw pointer.
+///
+/// \tparam scale_bits_ the logarithm of the sum of the normalized frequencies, at most 16
+/// \tparam num_states_ the number of interleaved states
+template<size_t scale_bits_ = 14, size_t num_states_ = 4>
+class RANSCoder : public Coder {
+private:
+    static_assert(scale_bits_ <= 16, "scale must not exceed the renormalization word size");
+    static_assert(num_states_ > 0);
+
+    static constexpr uint32_t LOWER = 1U << 16; // lower bound of the state interval
+    static constexpr size_t WORD_BITS = 16;
+    static constexpr uint32_t HAS_WORD = 1U << WORD_BITS;
+
+    struct Slot {
+        uint32_t sym;   // the symbol value
+        uint32_t freq;  // the normalized frequency of the symbol
+        uint32_t start; // the first slot of the symbol
+    };
+
+    FrequencyTable freqs_;
+    std::vector<Slot> slots_; // decoding information for each slot in [0, 2^scale)
+    uint32_t slot_mask_;
+    size_t scale_;
+
+    std::vector<uint32_t> words_; // renormalization output of each symbol, flagged with HAS_WORD
+    size_t pos_;
+
+    uint32_t states_[num_states_];
+    size_t cur_state_;
+
+    // renormalizes a decoder state
+    inline void renormalize(BitIStream& in, uint32_t& x) const {
+        if(x < LOWER) x = (x << WORD_BITS) | in.template read_binary<uint32_t>(WORD_BITS);
+    }
+
+    // renormalizes a decoder state from a little endian word in memory, without branching; two bytes must be readable
+    static inline void renormalize(const uint8_t*& p, uint32_t& x) {
+        const uint32_t word = uint32_t(p[0]) | (uint32_t(p[1]) << 8);
+        const uint32_t renorm = (x < LOWER);
+        x = (x << (renorm * WORD_BITS)) | (word & -renorm);
+        p += 2 * renorm;
+    }
+
+    // reads the frequencies and the initial decoder states
+    void read_header(BitIStream& in) {
+        freqs_.decode_header(in);
+        scale_ = freqs_.scale_bits();
+        slot_mask_ = (1U << scale_) - 1;
+
+        if(freqs_.size() > 0) {
+            for(size_t k = 0; k < num_states_; k++) states_[k] = in.template read_binary<uint32_t>(32);
+        }
+        cur_state_ = 0;
+    }
+
+    // builds the decoding slots from the frequency table
+    void build_slots() {
+        slots_.resize(freqs_.size() > 0 ? (1ULL << scale_) : 0);
+        for(size_t s = 0; s < freqs_.size(); s++) {
+            const Slot e { uint32_t(freqs_.symbol(s)), freqs_.freq(s), freqs_.start(s) };
+            std::fill(slots_.begin() + e.start, slots_.begin() + e.start + e.freq, e);
+        }
+    }
+
+    static void write_u32(std::ostream& out, const uint32_t x) {
+        for(size_t i = 4; i > 0; i--) out.put(char(x >> ((i - 1) * 8)));
+    }
+
+    static uint32_t read_u32(const uint8_t* p) {
+        return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+    }
+
+    // advances a decoder state past the symbol encoded in its low bits and returns the symbol
+    inline uint32_t advance(uint32_t& x) const {
+        const uint32_t slot = x & slot_mask_;
+        const Slot& e = slots_[slot];
+        x = e.freq * (x >> scale_) + slot - e.start;
+        return e.sym;
+    }
+
+public:
+    /// \brief The symbol type of the block interface.
+    using Char = uint8_t;
+
+private:
+    static constexpr size_t MAX_SYMS = UINT8_MAX + 1;
+
+public:
+
+    /// \brief Default constructor.
+    inline RANSCoder() : slot_mask_(0), scale_(0), pos_(0), cur_state_(0) {
+    }
+
+    RANSCoder(const RANSCoder& other) = default;
+    RANSCoder(RANSCoder&& other) = default;
+    RANSCoder& operator=(const RANSCoder& other) = default;
+    RANSCoder& operator=(RANSCoder&& other) = default;
+
+    /// \brief Initializes the coder for encoding and writes the header.
+    ///
+    /// The header consists of the normalized frequencies followed by the initial decoder states.
+    ///
+    /// \tparam array_t the array type
+    /// \param out the bit output stream into which to write the header
+    /// \param array the array to be encoded
+    /// \param num the number of items in the array
+    template<typename array_t>
+    void encode_init(BitOStream& out, const array_t& array, const size_t num) {
+        freqs_.count(array, num, scale_bits_);
+        assert(freqs_.scale_bits() <= 16);
+        freqs_.encode_header(out);
+
+        // encode backwards
+        const size_t scale = freqs_.scale_bits();
+        for(size_t k = 0; k < num_states_; k++) states_[k] = LOWER;
+
+        words_.resize(num);
+        for(size_t i = num; i > 0; i--) {
+            uint32_t& x = states_[(i - 1) % num_states_];
+            const uint32_t s = freqs_.index(uint64_t(array[i - 1]));
+            const uint32_t f = freqs_.freq(s);
+
+            // renormalize, so the state after encoding the symbol stays in range
+            const uint64_t x_max = (uint64_t(LOWER >> scale) << WORD_BITS) * f;
+            uint32_t word = 0;
+            if(x >= x_max) {
+                word = HAS_WORD | (x & (HAS_WORD - 1));
+                x >>= WORD_BITS;
+            }
+            words_[i - 1] = word;
+
+            x = ((x / f) << scale) + (x % f) + freqs_.start(s);
+        }
+
+        // the final encoder states are the initial decoder states
+        if(freqs_.size() > 0) {
+            for(size_t k = 0; k < num_states_; k++) out.write_binary(states_[k], 32);
+        }
+        pos_ = 0;
+    }
+
+    /// \brief Encodes the next symbol.
+    ///
+    /// The symbol must be the next one of the array announced via \ref encode_init.
+    ///
+    /// \tparam T the symbol type
+    /// \param out the bit output stream to write to
+    /// \param value the symbol
+    template<typename T>
+    void encode(BitOStream& out, T value) {
+        assert(pos_ < words_.size());
+        const uint32_t word = words_[pos_++];
+        if(word & HAS_WORD) out.write_binary(word & (HAS_WORD - 1), WORD_BITS);
+    }
+
+    /// \brief Encodes the next symbols.
+    ///
+    /// The symbols must be the next ones of the array announced via \ref encode_init.
+    ///
+    /// \tparam T the symbol type
+    /// \param out the bit output stream to write to
+    /// \param values the symbols
+    template<typename T>
+    void encode(BitOStream& out, std::span<T> values) {
+        for(const auto v : values) encode(out, v);
+    }
+
+    /// \brief Initializes the coder for decoding by reading the header.
+    /// \param in the bit input stream to read the header from
+    void decode_init(BitIStream& in) {
+        read_header(in);
+        build_slots();
+    }
+
+    /// \brief Decodes the next symbol.
+    /// \tparam T the symbol type
+    /// \param in the bit input stream to read from
+    template<typename T = uint64_t>
+    T decode(BitIStream& in) {
+        uint32_t& x = states_[cur_state_];
+        cur_state_ = (cur_state_ + 1) % num_states_;
+
+        const uint32_t c = advance(x);
+        renormalize(in, x);
+        return T(c);
+    }
+
+    /// \brief Decodes the next symbols.
+    ///
+    /// Groups of symbols belonging to different states are decoded together, before renormalizing the states in order.
+    ///
+    /// \tparam T the symbol type
+    /// \param in the bit input stream to read from
+    /// \param values the span to decode into, its size determines the number of symbols
+    template<typename T>
+    void decode(BitIStream& in, std::span<T> values) {
+        size_t i = 0;
+
+        // align to the first state
+        if constexpr(num_states_ > 1) {
+            while(i < values.size() && cur_state_ != 0) values[i++] = decode<T>(in);
+        }
+
+        while(i + num_states_ <= values.size()) {
+            for(size_t k = 0; k < num_states_; k++) values[i + k] = T(advance(states_[k]));
+            for(size_t k = 0; k < num_states_; k++) renormalize(in, states_[k]);
+            i += num_states_;
+        }
+
+        while(i < values.size()) values[i++] = decode<T>(in);
+    }
+
+    /// \brief Encodes a block of bytes and writes it to the output stream.
+    ///
+    /// A block consists of the header size as a 32-bit big endian integer, the header, and the renormalization words as 16-bit little endian integers.
+    /// The header contains the block length, the normalized frequencies, the initial decoder states and the number of words.
+    ///
+    /// \param block the block
+    /// \param num the length of the block
+    /// \param out the output stream
+    /// \return the number of bytes written
+    size_t encode(const Char* block, const size_t num, std::ostream& out) {
+        std::ostringstream header;
+        size_t num_words = 0;
+        {
+            BitOStream hout(header);
+            hout.write_delta(num + 1);
+            encode_init(hout, block, num);
+
+            for(const uint32_t word : words_) num_words += (word & HAS_WORD) ? 1 : 0;
+            hout.write_delta(num_words + 1);
+        }
+
+        const auto h = header.view();
+        write_u32(out, uint32_t(h.size()));
+        out.write(h.data(), h.size());
+
+        // the words in the order the decoder reads them
+        for(const uint32_t word : words_) {
+            if(word & HAS_WORD) {
+                out.put(char(word & 0xFF));
+                out.put(char((word >> 8) & 0xFF));
+            }
+        }
+        pos_ = words_.size();
+        return 4 + h.size() + 2 * num_words;
+    }
+
+    /// \brief Decodes a block of bytes from memory.
+    /// \param data the encoded block
+    /// \param size the number of available bytes, which may exceed the size of the block
+    /// \param block receives the decoded block
+    /// \return the number of bytes consumed
+    size_t decode(const void* data, const size_t size, std::vector<Char>& block) {
+        const uint8_t* p = (const uint8_t*)data;
+        assert(size >= 4);
+        const size_t header_size = read_u32(p);
+        p += 4;
+
+        size_t num, num_words;
+        {
+            BitIStream hin(p, header_size);
+            num = hin.read_delta<>() - 1;
+            read_header(hin);
+            num_words = hin.read_delta<>() - 1;
+        }
+        p += header_size;
+
+        const uint8_t* end = p + 2 * num_words;
+        assert(end <= (const uint8_t*)data + size);
+
+        block.resize(num);
+        Char* dst = block.data();
+        size_t i = 0;
+
+        // compact tables that fit into the L1 cache: the symbol of each slot, and the frequency and start of each symbol
+        Char slot_sym[size_t(1) << 16];
+        uint32_t sym_freq[MAX_SYMS], sym_start[MAX_SYMS];
+        for(size_t s = 0; s < freqs_.size(); s++) {
+            const Char c = Char(freqs_.symbol(s));
+            sym_freq[c] = freqs_.freq(s);
+            sym_start[c] = freqs_.start(s);
+            std::fill(slot_sym + sym_start[c], slot_sym + sym_start[c] + sym_freq[c], c);
+        }
+
+        // keep everything in locals, because the byte output may alias any member
+        const uint32_t mask = slot_mask_;
+        const size_t scale = scale_;
+        uint32_t x[num_states_];
+        std::copy(states_, states_ + num_states_, x);
+
+        auto advance = [&](uint32_t& x){
+            const uint32_t slot = x & mask;
+            const Char c = slot_sym[slot];
+            x = sym_freq[c] * (x >> scale) + slot - sym_start[c];
+            return c;
+        };
+
+        // renormalize without branches as long as every state may read a word
+        while(i + num_states_ <= num && size_t(end - p) >= 2 * num_states_) {
+            for(size_t k = 0; k < num_states_; k++) dst[i + k] = advance(x[k]);
+            for(size_t k = 0; k < num_states_; k++) renormalize(p, x[k]);
+            i += num_states_;
+        }
+
+        // the remaining symbols may be fewer than the states, which are only accessed by constant indices above so they can stay in registers
+        std::copy(x, x + num_states_, states_);
+        for(; i < num; i++) {
+            uint32_t& y = states_[i % num_states_];
+            dst[i] = advance(y);
+            if(y < LOWER) {
+                y = (y << WORD_BITS) | uint32_t(p[0]) | (uint32_t(p[1]) << 8);
+                p += 2;
+            }
+        }
+        return end - (const uint8_t*)data;
+    }
+};
+
+}} // namespace tdc::code
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <tdc/code/coder.hpp>
+#include <tdc/code/ans/frequency_table.hpp>
+#include <tdc/math/ilog2.hpp>
+
+namespace tdc {
+namespace code {
+
+/// \brief Static tabled asymmetric numeral system (tANS) coder [Duda, 2013].
+///
+/// The normalized frequencies are spread over a state table of size <tt>L = 2^scale</tt>.
+/// Decoding a symbol is a single table lookup, which yields the symbol, the number of bits to read and the base of the next state.
+/// Encoding uses the inverse transitions as in Collet's Finite State Entropy, such that no divisions are needed.
+///
+/// Like the \ref RANSCoder, the whole array announced via \ref encode_init is encoded at once in reverse order,
+/// and \ref encode writes the bits belonging to the next symbol in forward order.
+///
+/// \tparam scale_bits_ the logarithm of the table size, at most 16
+/// \tparam num_states_ the number of interleaved states
+template<size_t scale_bits_ = 12, size_t num_states_ = 4>
+class TANSCoder : public Coder {
+private:
+    static_assert(scale_bits_ <= 16, "table size must fit into the bit count encoding");
+    static_assert(num_states_ > 0);
+
+    struct DecodeEntry {
+        uint32_t sym;       // the symbol value
+        uint16_t base;      // the next state without the bits read
+        uint8_t  num_bits;  // the number of bits to read
+    };
+
+    struct EncodeEntry {
+        uint32_t delta_bits;  // added to the state, the high half yields the number of bits to write
+        int32_t  delta_state; // offset into the state table
+    };
+
+    static constexpr size_t NUM_BITS_SHIFT = 16;
+
+    FrequencyTable freqs_;
+    std::vector<DecodeEntry> decode_table_;
+
+    std::vector<uint32_t> output_; // the bits to write for each symbol, shifted left, with the number of bits in the low byte
+    size_t pos_;
+
+    uint32_t states_[num_states_]; // decoder states in [0, L)
+    size_t cur_state_;
+
+    // distributes the symbols over the table so that they are spread evenly
+    std::vector<uint32_t> spread() const {
+        const size_t size = 1ULL << freqs_.scale_bits();
+        const size_t mask = size - 1;
+        const size_t step = (size >> 1) + (size >> 3) + 3; // odd, hence coprime to the table size
+
+        std::vector<uint32_t> table_sym(size);
+        size_t pos = 0;
+        for(size_t s = 0; s < freqs_.size(); s++) {
+            for(size_t j = 0; j < freqs_.freq(s); j++) {
+                table_sym[pos] = uint32_t(s);
+                pos = (pos + step) & mask;
+            }
+        }
+        assert(pos == 0);
+        return table_sym;
+    }
+
+    inline uint32_t advance(uint32_t& x, BitIStream& in) const {
+        const DecodeEntry& e = decode_table_[x];
+        x = e.base + in.template read_binary<uint32_t>(e.num_bits);
+        return e.sym;
+    }
+
+public:
+    /// \brief Default constructor.
+    inline TANSCoder() : pos_(0), cur_state_(0) {
+    }
+
+    TANSCoder(const TANSCoder& other) = default;
+    TANSCoder(TANSCoder&& other) = default;
+    TANSCoder& operator=(const TANSCoder& other) = default;
+    TANSCoder& operator=(TANSCoder&& other) = default;
+
+    /// \brief Initializes the coder for encoding and writes the header.
+    ///
+    /// The header consists of the normalized frequencies followed by the initial decoder states.
+    ///
+    /// \tparam array_t the array type
+    /// \param out the bit output stream into which to write the header
+    /// \param array the array to be encoded
+    /// \param num the number of items in the array
+    template<typename array_t>
+    void encode_init(BitOStream& out, const array_t& array, const size_t num) {
+        freqs_.count(array, num, scale_bits_);
+        assert(freqs_.scale_bits() <= 16);
+        freqs_.encode_header(out);
+
+        output_.resize(num);
+        pos_ = 0;
+        if(freqs_.size() == 0) return;
+
+        const size_t scale = freqs_.scale_bits();
+        const uint32_t size = 1U << scale;
+
+        // build the encoding tables
+        std::vector<uint32_t> state_table(size); // next encoder state, grouped by symbol
+        std::vector<EncodeEntry> sym_table(freqs_.size());
+        {
+            const auto table_sym = spread();
+            std::vector<uint32_t> next(freqs_.size());
+            for(size_t s = 0; s < freqs_.size(); s++) next[s] = freqs_.start(s);
+            for(uint32_t u = 0; u < size; u++) state_table[next[table_sym[u]]++] = size + u;
+        }
+        for(size_t s = 0; s < freqs_.size(); s++) {
+            const uint32_t f = freqs_.freq(s);
+            if(f == 1) {
+                sym_table[s].delta_bits = (uint32_t(scale) << NUM_BITS_SHIFT) - size;
+            } else {
+                // states below f << max_bits write one bit less
+                const uint32_t max_bits = uint32_t(scale - math::ilog2_floor(f - 1));
+                sym_table[s].delta_bits = (max_bits << NUM_BITS_SHIFT) - (f << max_bits);
+            }
+            sym_table[s].delta_state = int32_t(freqs_.start(s)) - int32_t(f);
+        }
+
+        // encode backwards, states are in [L, 2L)
+        for(size_t k = 0; k < num_states_; k++) states_[k] = size;
+
+        for(size_t i = num; i > 0; i--) {
+            uint32_t& x = states_[(i - 1) % num_states_];
+            const EncodeEntry& e = sym_table[freqs_.index(uint64_t(array[i - 1]))];
+
+            const uint32_t num_bits = (x + e.delta_bits) >> NUM_BITS_SHIFT;
+            output_[i - 1] = ((x & ((1U << num_bits) - 1)) << 8) | num_bits;
+            x = state_table[int32_t(x >> num_bits) + e.delta_state];
+        }
+
+        // the final encoder states are the initial decoder states
+        for(size_t k = 0; k < num_states_; k++) out.write_binary(states_[k] - size, scale);
+    }
+
+    /// \brief Encodes the next symbol.
+    ///
+    /// The symbol must be the next one of the array announced via \ref encode_init.
+    ///
+    /// \tparam T the symbol type
+    /// \param out the bit output stream to write to
+    /// \param value the symbol
+    template<typename T>
+    void encode(BitOStream& out, T value) {
+        assert(pos_ < output_.size());
+        const uint32_t o = output_[pos_++];
+        out.write_binary(o >> 8, o & 0xFF);
+    }
+
+    /// \brief Encodes the next symbols.
+    ///
+    /// The symbols must be the next ones of the array announced via \ref encode_init.
+    ///
+    /// \tparam T the symbol type
+    /// \param out the bit output stream to write to
+    /// \param values the symbols
+    template<typename T>
+    void encode(BitOStream& out, std::span<T> values) {
+        for(const auto v : values) encode(out, v);
+    }
+
+    /// \brief Initializes the coder for decoding by reading the header.
+    /// \param in the bit input stream to read the header from
+    void decode_init(BitIStream& in) {
+        freqs_.decode_header(in);
+        if(freqs_.size() == 0) return;
+
+        const size_t scale = freqs_.scale_bits();
+        const uint32_t size = 1U << scale;
+
+        // build the decoding table
+        const auto table_sym = spread();
+        std::vector<uint32_t> next(freqs_.size());
+        for(size_t s = 0; s < freqs_.size(); s++) next[s] = freqs_.freq(s);
+
+        decode_table_.resize(size);
+        for(uint32_t u = 0; u < size; u++) {
+            const uint32_t s = table_sym[u];
+            const uint32_t x = next[s]++; // in [f, 2f)
+            const uint32_t num_bits = uint32_t(scale - math::ilog2_floor(x));
+            decode_table_[u] = DecodeEntry { uint32_t(freqs_.symbol(s)), uint16_t((x << num_bits) - size), uint8_t(num_bits) };
+        }
+
+        for(size_t k = 0; k < num_states_; k++) states_[k] = in.template read_binary<uint32_t>(scale);
+        cur_state_ = 0;
+    }
+
+    /// \brief Decodes the next symbol.
+    /// \tparam T the symbol type
+    /// \param in the bit input stream to read from
+    template<typename T = uint64_t>
+    T decode(BitIStream& in) {
+        uint32_t& x = states_[cur_state_];
+        cur_state_ = (cur_state_ + 1) % num_states_;
+        return T(advance(x, in));
+    }
+
+    /// \brief Decodes the next symbols.
+    ///
+    /// The table lookups of symbols belonging to different states are independent of each other.
+    ///
+    /// \tparam T the symbol type
+    /// \param in the bit input stream to read from
+    /// \param values the span to decode into, its size determines the number of symbols
+    template<typename T>
+    void decode(BitIStream& in, std::span<T> values) {
+        size_t i = 0;
+
+        // align to the first state
+        if constexpr(num_states_ > 1) {
+            while(i < values.size() && cur_state_ != 0) values[i++] = decode<T>(in);
+        }
+
+        while(i + num_states_ <= values.size()) {
+            const DecodeEntry* e[num_states_];
+            for(size_t k = 0; k < num_states_; k++) e[k] = &decode_table_[states_[k]];
+            for(size_t k = 0; k < num_states_; k++) {
+                states_[k] = e[k]->base + in.template read_binary<uint32_t>(e[k]->num_bits);
+                values[i + k] = T(e[k]->sym);
+            }
+            i += num_states_;
+        }
+
+        while(i < values.size()) values[i++] = decode<T>(in);
+    }
+};
+
+}} // namespace tdc::code
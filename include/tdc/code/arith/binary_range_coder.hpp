@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+#include <tdc/code/coder.hpp>
+
+namespace tdc {
+namespace code {
+
+/// \brief Binary arithmetic coder implemented as a range coder, in the style of LZMA.
+///
+/// Each bit is coded with a given probability of 12 bits precision, which is typically provided by an adaptive model.
+/// The encoder keeps a 32-bit range and a low end with a carry bit. Whenever the range drops below 2^24, the top byte of the low end is shifted out.
+/// Because a carry may still propagate into it, that byte is held back along with any following 0xFF bytes until the carry is resolved.
+///
+/// The decoder reads exactly as many bytes as the encoder writes, including the bytes written by \ref encode_finalize.
+/// However, because output is deferred, no other data may be written to the same bit stream between the first encoded bit and the finalization.
+class BinaryRangeCoder {
+public:
+    /// \brief The precision of probabilities in bits.
+    static constexpr size_t PROB_BITS = 12;
+
+    /// \brief The probability value that corresponds to certainty.
+    static constexpr uint32_t PROB_ONE = 1U << PROB_BITS;
+
+private:
+    static constexpr uint32_t TOP = 1U << 24;
+
+    uint64_t low_;
+    uint32_t range_;
+    uint32_t code_;
+    uint8_t  cache_;
+    uint64_t cache_size_;
+
+    inline void write_byte(BitOStream& out, const uint8_t byte) {
+        out.write_binary(byte, 8);
+    }
+
+    // shifts the top byte out of the low end, resolving pending bytes once no carry can reach them
+    inline void shift_low(BitOStream& out) {
+        if(uint32_t(low_) < 0xFF000000U || (low_ >> 32) != 0) {
+            const uint8_t carry = uint8_t(low_ >> 32);
+            uint8_t byte = cache_;
+            do {
+                write_byte(out, uint8_t(byte + carry));
+                byte = 0xFF;
+            } while(--cache_size_ != 0);
+            cache_ = uint8_t(low_ >> 24);
+        }
+        ++cache_size_;
+        low_ = (low_ & 0x00FFFFFFULL) << 8;
+    }
+
+public:
+    /// \brief Default constructor.
+    inline BinaryRangeCoder() : low_(0), range_(UINT32_MAX), code_(0), cache_(0), cache_size_(1) {
+    }
+
+    BinaryRangeCoder(const BinaryRangeCoder& other) = default;
+    BinaryRangeCoder(BinaryRangeCoder&& other) = default;
+    BinaryRangeCoder& operator=(const BinaryRangeCoder& other) = default;
+    BinaryRangeCoder& operator=(BinaryRangeCoder&& other) = default;
+
+    /// \brief Encodes a bit.
+    /// \param out the bit output stream to write to
+    /// \param bit the bit
+    /// \param p1 the probability that the bit is set, in <tt>(0, PROB_ONE)</tt>
+    inline void encode(BitOStream& out, const bool bit, const uint32_t p1) {
+        assert(p1 > 0 && p1 < PROB_ONE);
+        const uint32_t bound = (range_ >> PROB_BITS) * p1;
+        if(bit) {
+            range_ = bound;
+        } else {
+            low_ += bound;
+            range_ -= bound;
+        }
+
+        while(range_ < TOP) {
+            range_ <<= 8;
+            shift_low(out);
+        }
+    }
+
+    /// \brief Writes the pending bytes and the low end, such that the decoder can resolve the last bit.
+    /// \param out the bit output stream to write to
+    inline void encode_finalize(BitOStream& out) {
+        for(size_t i = 0; i < 5; i++) shift_low(out);
+    }
+
+    /// \brief Initializes the decoder by reading the first bytes.
+    /// \param in the bit input stream to read from
+    inline void decode_init(BitIStream& in) {
+        range_ = UINT32_MAX;
+        code_ = 0;
+        for(size_t i = 0; i < 5; i++) code_ = (code_ << 8) | in.template read_binary<uint32_t>(8);
+    }
+
+    /// \brief Decodes a bit.
+    /// \param in the bit input stream to read from
+    /// \param p1 the probability that the bit is set, as passed to \ref encode
+    inline bool decode(BitIStream& in, const uint32_t p1) {
+        assert(p1 > 0 && p1 < PROB_ONE);
+        const uint32_t bound = (range_ >> PROB_BITS) * p1;
+        bool bit;
+        if(code_ < bound) {
+            range_ = bound;
+            bit = 1;
+        } else {
+            code_ -= bound;
+            range_ -= bound;
+            bit = 0;
+        }
+
+        while(range_ < TOP) {
+            range_ <<= 8;
+            code_ = (code_ << 8) | in.template read_binary<uint32_t>(8);
+        }
+        return bit;
+    }
+};
+
+}} // namespace tdc::code
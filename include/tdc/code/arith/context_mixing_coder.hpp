@@ -0,0 +1,188 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <tdc/code/coder.hpp>
+#include <tdc/code/arith/binary_range_coder.hpp>
+
+namespace tdc {
+namespace code {
+
+/// \brief Adaptive byte coder that mixes order-0, order-1 and order-2 context models, coded with a \ref BinaryRangeCoder.
+///
+/// Each byte is coded as eight binary decisions from the most significant bit downwards.
+/// For each decision, every model predicts the probability of a one from the preceding bits of the byte and its context, i.e., none, the previous byte or the previous two bytes.
+/// The predictions are combined by a mixer in the logistic domain, whose weights are selected by the preceding bits and trained online to minimize the coding cost [Mahoney, 2005].
+/// The order-2 statistics are kept in a hash table.
+///
+/// Since the coder is adaptive, it does not write a header, but \ref encode_finalize must be called after the last value
+/// and \ref decode_init before the first one. The values must be coded on a bit stream section of their own, as explained for the \ref BinaryRangeCoder,
+/// such as the literal section of a \ref comp::lz77::FactorCoder.
+///
+/// \tparam order2_bits_ the logarithm of the size of the order-2 hash table
+template<size_t order2_bits_ = 22>
+class ContextMixingCoder : public Coder {
+private:
+    static_assert(order2_bits_ > 8 && order2_bits_ <= 24, "the order-2 table must hold whole bytes and fit the context");
+
+    static constexpr size_t NUM_INPUTS = 4; // the three models and a bias
+    static constexpr int32_t BIAS = 256;
+    static constexpr int32_t STRETCH_MAX = 2047;
+    static constexpr size_t COUNTER_RATE = 3;
+    static constexpr int32_t LEARNING_RATE = 6;
+
+    // conversions between probabilities and the logistic domain, scaled by 2^8
+    struct Logistic {
+        int16_t stretch[BinaryRangeCoder::PROB_ONE];
+        uint16_t squash[2 * STRETCH_MAX + 1];
+
+        Logistic() {
+            for(int32_t x = -STRETCH_MAX; x <= STRETCH_MAX; x++) {
+                const double p = double(BinaryRangeCoder::PROB_ONE) / (1.0 + std::exp(-double(x) / 256.0));
+                squash[x + STRETCH_MAX] = uint16_t(std::clamp(int32_t(std::lround(p)), 1, int32_t(BinaryRangeCoder::PROB_ONE) - 1));
+            }
+            for(uint32_t p = 0; p < BinaryRangeCoder::PROB_ONE; p++) {
+                const double q = (double(std::max(p, 1U)) - 0.5) / double(BinaryRangeCoder::PROB_ONE);
+                stretch[p] = int16_t(std::clamp(int32_t(std::lround(256.0 * std::log(q / (1.0 - q)))), -STRETCH_MAX, STRETCH_MAX));
+            }
+        }
+    };
+
+    static const Logistic& logistic() {
+        static const Logistic table;
+        return table;
+    }
+
+    BinaryRangeCoder rc_;
+
+    // bit probabilities scaled by 2^16, indexed by the preceding bits of the byte in the low byte
+    std::vector<uint16_t> order0_;
+    std::vector<uint16_t> order1_;
+    std::vector<uint16_t> order2_;
+
+    std::vector<int32_t> weights_; // mixer weights scaled by 2^16, a set for each node
+    uint32_t history_; // the previous two bytes
+
+    // codes one byte, with code_bit taking the predicted probability of a one and returning the coded bit
+    template<typename code_bit_t>
+    inline uint8_t code_byte(code_bit_t code_bit) {
+        const auto& lg = logistic();
+
+        const uint32_t ctx1 = (history_ & 0xFF) << 8;
+        const uint32_t ctx2 = ((((history_ & 0xFFFF) + 1) * 0x9E3779B1U) >> (32 - (order2_bits_ - 8))) << 8;
+
+        uint32_t node = 1;
+        while(node < 256) {
+            uint16_t* const counters[3] = { &order0_[node], &order1_[ctx1 | node], &order2_[ctx2 | node] };
+            int32_t* const w = &weights_[node * NUM_INPUTS];
+
+            int32_t st[NUM_INPUTS];
+            int64_t dot = 0;
+            for(size_t k = 0; k < 3; k++) {
+                st[k] = lg.stretch[*counters[k] >> 4];
+                dot += int64_t(w[k]) * st[k];
+            }
+            st[3] = BIAS;
+            dot += int64_t(w[3]) * BIAS;
+
+            const int32_t x = std::clamp(int32_t(dot >> 16), -STRETCH_MAX, STRETCH_MAX);
+            const uint32_t p1 = lg.squash[x + STRETCH_MAX];
+
+            const bool bit = code_bit(p1);
+
+            // train the mixer and update the models
+            const int32_t err = ((int32_t(bit) << BinaryRangeCoder::PROB_BITS) - int32_t(p1)) * LEARNING_RATE;
+            for(size_t k = 0; k < NUM_INPUTS; k++) w[k] += (st[k] * err + (1 << 12)) >> 13;
+
+            const int32_t target = bit ? 0xFFFF : 0;
+            for(size_t k = 0; k < 3; k++) *counters[k] += (target - int32_t(*counters[k])) >> COUNTER_RATE;
+
+            node = (node << 1) | uint32_t(bit);
+        }
+
+        const uint8_t c = uint8_t(node);
+        history_ = (history_ << 8) | c;
+        return c;
+    }
+
+public:
+    /// \brief Default constructor.
+    inline ContextMixingCoder()
+        : order0_(256, 0x8000),
+          order1_(256 * 256, 0x8000),
+          order2_(1ULL << order2_bits_, 0x8000),
+          weights_(256 * NUM_INPUTS, 0),
+          history_(0) {
+
+        // start out by trusting the models equally
+        for(size_t i = 0; i < 256; i++) {
+            for(size_t k = 0; k < 3; k++) weights_[i * NUM_INPUTS + k] = (1 << 16) / 3;
+        }
+    }
+
+    ContextMixingCoder(const ContextMixingCoder& other) = default;
+    ContextMixingCoder(ContextMixingCoder&& other) = default;
+    ContextMixingCoder& operator=(const ContextMixingCoder& other) = default;
+    ContextMixingCoder& operator=(ContextMixingCoder&& other) = default;
+
+    /// \brief Encodes a byte.
+    /// \tparam T the value type
+    /// \param out the bit output stream to write to
+    /// \param value the value, at most 255
+    template<typename T>
+    void encode(BitOStream& out, T value) {
+        assert(uint64_t(value) <= UINT8_MAX);
+        const uint32_t c = uint32_t(value);
+        size_t i = 8;
+        code_byte([&](const uint32_t p1){
+            const bool bit = (c >> --i) & 1;
+            rc_.encode(out, bit, p1);
+            return bit;
+        });
+    }
+
+    /// \brief Encodes a sequence of bytes.
+    /// \tparam T the value type
+    /// \param out the bit output stream to write to
+    /// \param values the values
+    template<typename T>
+    void encode(BitOStream& out, std::span<T> values) {
+        for(const auto v : values) encode(out, v);
+    }
+
+    /// \brief Writes the pending output of the arithmetic coder.
+    /// \param out the bit output stream to write to
+    void encode_finalize(BitOStream& out) {
+        rc_.encode_finalize(out);
+    }
+
+    /// \brief Initializes the arithmetic decoder.
+    /// \param in the bit input stream to read from
+    void decode_init(BitIStream& in) {
+        rc_.decode_init(in);
+    }
+
+    /// \brief Decodes a byte.
+    /// \tparam T the value type
+    /// \param in the bit input stream to read from
+    template<typename T = uint64_t>
+    T decode(BitIStream& in) {
+        return T(code_byte([&](const uint32_t p1){ return rc_.decode(in, p1); }));
+    }
+
+    /// \brief Decodes a sequence of bytes.
+    /// \tparam T the value type
+    /// \param in the bit input stream to read from
+    /// \param values the span to decode into, its size determines the number of values
+    template<typename T>
+    void decode(BitIStream& in, std::span<T> values) {
+        for(auto& v : values) v = decode<T>(in);
+    }
+};
+
+}} // namespace tdc::code
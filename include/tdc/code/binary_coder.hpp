@@ -1,5 +1,7 @@
 #pragma once
 
+#include <span>
+
 #include <tdc/code/coder.hpp>
 
 namespace tdc {
@@ -37,6 +39,13 @@ public:
         out.write_binary(value, bits);
     }
 
+    /// \brief Computes the length of the code for an integer in bits, which is always \c bits_.
+    /// \tparam T the integer type
+    template<typename T>
+    size_t encoded_length(T) const {
+        return bits_;
+    }
+
     /// \brief Decodes an integer from the given input stream using \c m_bits.
     /// \tparam T the integer type
     /// \param in the input stream to read from
@@ -53,6 +62,24 @@ public:
     T decode(BitIStream& in, const size_t bits) {
         return in.template read_binary<T>(bits);
     }
+
+    /// \brief Encodes a sequence of integers to the given output stream using \c bits_ bits each.
+    /// \tparam T the integer type
+    /// \param out the bit output stream to write to
+    /// \param values the values to encode
+    template<typename T>
+    void encode(BitOStream& out, std::span<T> values) {
+        for(const auto v : values) out.write_binary(v, bits_);
+    }
+
+    /// \brief Decodes a sequence of integers from the given input stream using \c bits_ bits each.
+    /// \tparam T the integer type
+    /// \param in the input stream to read from
+    /// \param values the span to decode into, its size determines the number of values
+    template<typename T>
+    void decode(BitIStream& in, std::span<T> values) {
+        in.read_binary(values, bits_);
+    }
 };
 
 }} // namespace tdc::code
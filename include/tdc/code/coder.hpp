@@ -34,6 +34,15 @@ public:
     inline void encode_init(BitOStream& out, const array_t& array, const size_t num) {
     }
 
+    /// \brief Finalizes the encoding.
+    ///
+    /// Coders that defer output, such as arithmetic coders, write any pending data to the output stream here.
+    /// It must be called after the last value has been encoded.
+    ///
+    /// \param out the bit output stream to write to
+    inline void encode_finalize(BitOStream& out) {
+    }
+
     /// \brief Initializes the coder for decoding.
     ///
     /// The initialization may involve reading a header from the given input stream.
@@ -44,7 +53,7 @@ public:
 
     /// \brief Tests whether the decoding of the given input stream has finished.
     /// \param in the input stream in question
-    inline bool decode_eof(const BitIStream& in) const {
+    inline bool decode_eof(BitIStream& in) const {
         return in.eof();
     }
 };
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <span>
+
 #include <tdc/code/coder.hpp>
+#include <tdc/math/ilog2.hpp>
 
 namespace tdc {
 namespace code {
@@ -18,10 +21,18 @@ public:
     /// \param value the value to encode, must be less than <tt>UINT64_MAX-1</tt>
     template<typename T>
     void encode(BitOStream& out, T value) {
-        ++value;
-        out.write_delta(value);
+        out.write_delta(uint64_t(value) + 1); // widen so the maximum of small types does not overflow
     }
     
+    /// \brief Computes the length of the code for an integer in bits.
+    /// \tparam T the integer type
+    /// \param value the value to encode
+    template<typename T>
+    size_t encoded_length(T value) const {
+        const size_t m = math::ilog2_floor(uint64_t(value) + 1);
+        return 2 * math::ilog2_floor(m + 1) + 1 + m;
+    }
+
     /// \brief Decodes an integer from the given input stream.
     /// \tparam T the integer type
     /// \param in the input stream to read from
@@ -31,6 +42,25 @@ public:
         --value;
         return value;
     }
+
+    /// \brief Encodes a sequence of integers to the given output stream.
+    /// \tparam T the integer type
+    /// \param out the bit output stream to write to
+    /// \param values the values to encode, must be less than <tt>UINT64_MAX-1</tt>
+    template<typename T>
+    void encode(BitOStream& out, std::span<T> values) {
+        for(const auto v : values) out.write_delta(uint64_t(v) + 1);
+    }
+
+    /// \brief Decodes a sequence of integers from the given input stream.
+    /// \tparam T the integer type
+    /// \param in the input stream to read from
+    /// \param values the span to decode into, its size determines the number of values
+    template<typename T>
+    void decode(BitIStream& in, std::span<T> values) {
+        in.read_delta(values);
+        for(auto& v : values) --v;
+    }
 };
 
 }} // namespace tdc::code
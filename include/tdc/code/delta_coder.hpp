@@ -1,6 +1,9 @@
 #pragma once
 
+#include <span>
+
 #include <tdc/code/coder.hpp>
+#include <tdc/math/ilog2.hpp>
 
 namespace tdc {
 namespace code {
@@ -19,6 +22,15 @@ public:
         out.write_delta(value);
     }
 
+    /// \brief Computes the length of the code for an integer in bits.
+    /// \tparam T the integer type
+    /// \param value the value to encode, must be greater than zero
+    template<typename T>
+    size_t encoded_length(T value) const {
+        const size_t m = math::ilog2_floor(value);
+        return 2 * math::ilog2_floor(m + 1) + 1 + m;
+    }
+
     /// \brief Decodes an integer from the given input stream.
     /// \tparam T the integer type
     /// \param in the input stream to read from
@@ -26,6 +38,24 @@ public:
     T decode(BitIStream& in) {
         return in.template read_delta<T>();
     }
+
+    /// \brief Encodes a sequence of integers to the given output stream.
+    /// \tparam T the integer type
+    /// \param out the bit output stream to write to
+    /// \param values the values to encode, must be greater than zero
+    template<typename T>
+    void encode(BitOStream& out, std::span<T> values) {
+        for(const auto v : values) out.write_delta(v);
+    }
+
+    /// \brief Decodes a sequence of integers from the given input stream.
+    /// \tparam T the integer type
+    /// \param in the input stream to read from
+    /// \param values the span to decode into, its size determines the number of values
+    template<typename T>
+    void decode(BitIStream& in, std::span<T> values) {
+        in.read_delta(values);
+    }
 };
 
 }}
@@ -12,7 +12,8 @@ protected:
     inline void set_rank(Node* v, const index_t rank, const bool initial) {
         assert(rank < MAX_NODES);
 
-        if(!initial) rank_map_[v->rank] = nullptr;
+        // when two nodes are interchanged, the old rank of v may already have been taken by the other node
+        if(!initial && rank_map_[v->rank] == v) rank_map_[v->rank] = nullptr;
         v->rank = rank;
         rank_map_[rank] = v;
     }
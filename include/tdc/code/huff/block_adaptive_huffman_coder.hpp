@@ -0,0 +1,74 @@
+#pragma once
+
+#include <algorithm>
+#include <string>
+
+#include <tdc/code/coder.hpp>
+#include <tdc/code/huff/huffman_table.hpp>
+#include <tdc/code/huff/package_merge.hpp>
+
+namespace tdc {
+namespace code {
+
+// block-adaptive (semi-static) Huffman coder
+// the symbols are counted as they are coded, and every block_size_ symbols, a length-limited canonical code is rebuilt from the running counts,
+// which the decoder mirrors, so no header is needed and decoding remains table-driven
+// to adapt quickly at the beginning, the first code is rebuilt after INITIAL_INTERVAL symbols, and the interval doubles up to block_size_
+// every symbol keeps a pseudo count of one, so symbols that have not occurred yet can be coded without an escape mechanism
+template<size_t block_size_ = 16384, size_t max_length_ = 15>
+class BlockAdaptiveHuffmanCoder : public Coder {
+private:
+    using Char = CanonicalHuffmanTable::Char;
+    static constexpr size_t MAX_SYMS = CanonicalHuffmanTable::MAX_SYMS;
+    static constexpr size_t INITIAL_INTERVAL = 64;
+
+    static_assert(block_size_ > 0);
+    static_assert(max_length_ >= 8 && max_length_ < CanonicalHuffmanTable::MAX_LENGTH, "invalid maximum code length");
+
+    CanonicalHuffmanTable table_;
+    uint64_t counts_[MAX_SYMS];
+    size_t interval_;
+    size_t countdown_;
+
+    inline void rebuild() {
+        uint8_t lengths[MAX_SYMS];
+        package_merge(counts_, MAX_SYMS, max_length_, lengths);
+
+        Char syms[MAX_SYMS];
+        for(size_t c = 0; c < MAX_SYMS; c++) syms[c] = Char(c);
+        table_.assign(syms, MAX_SYMS, lengths);
+
+        countdown_ = interval_;
+        interval_ = std::min(2 * interval_, block_size_);
+    }
+
+    inline void count(const Char c) {
+        ++counts_[c];
+        if(--countdown_ == 0) rebuild();
+    }
+
+public:
+    inline BlockAdaptiveHuffmanCoder() : interval_(std::min(INITIAL_INTERVAL, block_size_)) {
+        std::fill(counts_, counts_ + MAX_SYMS, 1);
+        rebuild();
+    }
+
+    inline BlockAdaptiveHuffmanCoder(const std::string& s, BitOStream& out) : BlockAdaptiveHuffmanCoder() {
+    }
+
+    inline BlockAdaptiveHuffmanCoder(BitIStream& in) : BlockAdaptiveHuffmanCoder() {
+    }
+
+    inline void encode(BitOStream& out, const Char c) {
+        table_.encode(out, c);
+        count(c);
+    }
+
+    inline Char decode(BitIStream& in) {
+        const Char c = table_.decode(in);
+        count(c);
+        return c;
+    }
+};
+
+}} // namespace tdc::code
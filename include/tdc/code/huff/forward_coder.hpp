@@ -3,7 +3,7 @@
 #include <utility>
 #include <vector>
 
-#include <tdc/code/huff/huffman_coder_base.hpp>
+#include <tdc/code/huff/adaptive_huffman_coder_base.hpp>
 
 namespace tdc {
 namespace code {
@@ -1,73 +1,84 @@
 #pragma once
 
-#include <vector>
-#include <tdc/code/huff/huffman_coder_base.hpp>
+#include <string>
+
+#include <tdc/code/coder.hpp>
+#include <tdc/code/huff/huffman_table.hpp>
+#include <tdc/code/huff/package_merge.hpp>
+#include <tdc/math/ilog2.hpp>
 
 namespace tdc {
 namespace code {
 
-// Huffman coder based on [Huffman, 1952]
-template<typename SymCoder, typename FreqCoder>
-class HuffmanCoder : public HuffmanCoderBase {
+// length-limited canonical Huffman coder
+// the code lengths are computed using package-merge, so they are optimal subject to the maximum length
+// the header consists of the occurring symbols and their code lengths, from which the decoder assigns the same canonical codewords
+template<typename SymCoder, size_t max_length_ = 15>
+class HuffmanCoder : public Coder {
 private:
-    SymCoder  sym_coder_;
-    FreqCoder freq_coder_;
+    using Char = CanonicalHuffmanTable::Char;
+    static constexpr size_t MAX_SYMS = CanonicalHuffmanTable::MAX_SYMS;
+    static constexpr size_t LENGTH_BITS = math::ilog2_ceil(max_length_);
 
-    inline HuffmanCoder() : HuffmanCoderBase() {
-        // initialize
-        for(size_t c = 0; c < MAX_SYMS; c++) {
-            leaves_[c] = nullptr;
-        }
-        num_nodes_ = 0;
-    }
+    static_assert(max_length_ >= 8 && max_length_ < CanonicalHuffmanTable::MAX_LENGTH, "invalid maximum code length");
 
-    // assumes that queue contains all the leaves!
-    inline void build_tree(PriorityQueue& queue) {
-        assert(!queue.empty());
-        
-        const size_t sigma = queue.size();
-        for(size_t i = 0; i < sigma - 1; i++) {
-            // get the next two nodes from the priority queue
-            Node* l = queue.top(); queue.pop();
-            Node* r = queue.top(); queue.pop();
+    SymCoder sym_coder_;
+    CanonicalHuffmanTable table_;
 
-            // make sure l has the smaller weight
-            if(r->weight < l->weight) {
-                std::swap(l, r);
+public:
+    inline HuffmanCoder(const std::string& s, BitOStream& out) {
+        // count histogram
+        uint64_t hist[MAX_SYMS] = { 0 };
+        for(const Char c : s) ++hist[c];
+
+        Char syms[MAX_SYMS];
+        uint64_t weights[MAX_SYMS];
+        size_t sigma = 0;
+        for(size_t c = 0; c < MAX_SYMS; c++) {
+            if(hist[c]) {
+                syms[sigma] = Char(c);
+                weights[sigma] = hist[c];
+                ++sigma;
             }
+        }
 
-            // create a new node as parent of l and r
-            Node* v = node(num_nodes_++);
-            *v = Node { l->weight + r->weight, 0, nullptr, 0, l, r, 0 };
-            
-            l->parent = v;
-            l->bit = 0;
-            r->parent = v;
-            r->bit = 1;
+        // compute code lengths and write header
+        out.write_delta(sigma + 1);
+        if(sigma > 0) {
+            uint8_t sym_lengths[MAX_SYMS];
+            package_merge(weights, sigma, max_length_, sym_lengths);
 
-            queue.push(v);
+            uint8_t lengths[MAX_SYMS];
+            for(size_t i = 0; i < sigma; i++) {
+                lengths[syms[i]] = sym_lengths[i];
+                sym_coder_.encode(out, syms[i]);
+                out.write_binary(sym_lengths[i], LENGTH_BITS);
+            }
+            table_.assign(syms, sigma, lengths);
         }
-        
-        root_ = queue.top(); queue.pop();
-        assert(queue.empty());
     }
 
-public:
-    inline HuffmanCoder(const std::string& s, BitOStream& out) : HuffmanCoder() {
-        // build Huffman tree and write histogram
-        auto queue = init_leaves(s);
-        build_tree(queue);
-        encode_histogram(out, sym_coder_, freq_coder_);
+    inline HuffmanCoder(BitIStream& in) {
+        // read header
+        const size_t sigma = in.read_delta<>() - 1;
+        if(sigma > 0) {
+            Char syms[MAX_SYMS];
+            uint8_t lengths[MAX_SYMS];
+            for(size_t i = 0; i < sigma; i++) {
+                const Char c = sym_coder_.template decode<Char>(in);
+                syms[i] = c;
+                lengths[c] = in.read_binary<uint8_t>(LENGTH_BITS);
+            }
+            table_.assign(syms, sigma, lengths);
+        }
     }
 
-    inline HuffmanCoder(BitIStream& in) : HuffmanCoder() {
-        // read histogram and build Huffman tree
-        auto queue = decode_histogram(in, sym_coder_, freq_coder_);
-        build_tree(queue);
+    inline void encode(BitOStream& out, const Char c) {
+        table_.encode(out, c);
     }
 
-    inline void encode(BitOStream& out, const Char c) {
-        HuffmanCoderBase::encode(out, leaves_[c]);
+    inline Char decode(BitIStream& in) {
+        return table_.decode(in);
     }
 };
 
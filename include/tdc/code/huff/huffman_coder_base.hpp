@@ -14,7 +14,7 @@ namespace code {
 class HuffmanCoderBase : public Coder {
 protected:
     using Char = uint8_t;
-    static constexpr size_t MAX_SYMS = UINT8_MAX;
+    static constexpr size_t MAX_SYMS = UINT8_MAX + 1;
     static constexpr size_t MAX_NODES = 2 * (MAX_SYMS + 1); // 2 * (all bytes + NYT)
 
     struct Node {
@@ -143,23 +143,38 @@ public:
     inline void encode(BitOStream& out, const Node* leaf) {
         assert(leaf);
 
-        // encode
-        std::vector<bool> bits; // TODO: static buffer
-        for(const Node* v = leaf; v != root_; v = v->parent) {
-            bits.push_back(v->bit);
+        // collect up to 64 bits bottom-up, such that the bit closest to the root ends up most significant
+        uint64_t code = 0;
+        size_t len = 0;
+        const Node* v = leaf;
+        for(; v != root_ && len < 64; v = v->parent) {
+            code |= uint64_t(v->bit) << len++;
         }
 
-        for(size_t i = bits.size(); i > 0; i--) {
-            out.write_bit(bits[i-1]);
-        }
+        // for very deep leaves, the path from the root to v must be written first
+        if(v != root_) encode(out, v);
+        out.write_binary(code, len);
     }
 
-    inline Char decode(BitIStream& in) {
+    // walks down the tree from the root to a leaf, consuming multiple bits at a time
+    inline Node* decode_leaf(BitIStream& in) {
+        constexpr size_t K = BitIStream::PEEK_BITS;
+
         Node* v = root_;
         while(!v->is_leaf()) {
-            v = in.read_bit() ? v->right : v->left;
+            const size_t bits = in.template peek_binary<size_t>(K);
+            size_t n = 0;
+            while(n < K && !v->is_leaf()) {
+                v = ((bits >> (K - 1 - n)) & 1) ? v->right : v->left;
+                ++n;
+            }
+            in.skip(n);
         }
-        return v->sym;
+        return v;
+    }
+
+    inline Char decode(BitIStream& in) {
+        return decode_leaf(in)->sym;
     }
 };
 
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <tdc/code/coder.hpp>
+
+namespace tdc {
+namespace code {
+
+/// \brief A canonical prefix code over bytes with table-driven decoding.
+///
+/// Given the code length of each symbol, codewords are assigned in canonical order, i.e., by length and then by symbol,
+/// such that each codeword is the next binary number after the previous one, shifted left to the new length.
+///
+/// For decoding, the next \c LOOKUP_BITS bits are inspected and resolved to the symbol and its code length in a single table access.
+/// Longer codes resolve to a second-level table for the following bits, and so on.
+class CanonicalHuffmanTable {
+public:
+    using Char = uint8_t;
+
+    /// \brief The maximum number of symbols.
+    static constexpr size_t MAX_SYMS = UINT8_MAX + 1;
+
+    /// \brief The number of bits resolved by a single table access.
+    static constexpr size_t LOOKUP_BITS = 11;
+    static_assert(LOOKUP_BITS <= BitIStream::PEEK_BITS);
+
+    /// \brief The maximum supported code length.
+    static constexpr size_t MAX_LENGTH = 64;
+
+private:
+    struct Entry {
+        uint32_t value;   // the symbol, or the offset of the next-level table
+        uint8_t  length;  // the number of bits to consume
+        uint8_t  sub_bits; // the number of bits resolved by the next-level table, or zero if value is a symbol
+    };
+
+    uint8_t  length_[MAX_SYMS];
+    uint64_t code_[MAX_SYMS];
+
+    std::vector<Entry> table_;
+    size_t root_bits_;
+
+    // appends the table for symbols [begin, end) in canonical order, which share their first depth bits, and returns the number of bits it resolves
+    size_t build_table(const Char* syms, const size_t begin, const size_t end, const size_t depth) {
+        const size_t bits = std::min(LOOKUP_BITS, size_t(length_[syms[end - 1]]) - depth);
+        const size_t offset = table_.size();
+        table_.resize(offset + (1ULL << bits));
+
+        // extracts the table index of a symbol's codeword
+        auto index = [&](const Char c){
+            const size_t len = length_[c];
+            const uint64_t aligned = (len > 0) ? (code_[c] << (MAX_LENGTH - len)) : 0; // left-aligned codeword
+            return (bits > 0) ? size_t((aligned << depth) >> (MAX_LENGTH - bits)) : 0;
+        };
+
+        size_t i = begin;
+        while(i < end) {
+            const Char c = syms[i];
+            const size_t idx = index(c);
+            const size_t len = length_[c] - depth;
+            if(len <= bits) {
+                // the codeword ends in this table, fill all entries it prefixes
+                const size_t num = 1ULL << (bits - len);
+                std::fill(table_.begin() + offset + idx, table_.begin() + offset + idx + num, Entry { c, uint8_t(len), 0 });
+                ++i;
+            } else {
+                // the codeword continues, group all symbols with the same index into a next-level table
+                size_t j = i + 1;
+                while(j < end && index(syms[j]) == idx) ++j;
+
+                const size_t sub = table_.size();
+                const size_t sub_bits = build_table(syms, i, j, depth + bits);
+                table_[offset + idx] = Entry { uint32_t(sub), uint8_t(bits), uint8_t(sub_bits) };
+                i = j;
+            }
+        }
+        return bits;
+    }
+
+public:
+    inline CanonicalHuffmanTable() : root_bits_(0) {
+        std::fill(length_, length_ + MAX_SYMS, 0);
+        std::fill(code_, code_ + MAX_SYMS, 0);
+    }
+
+    /// \brief Assigns canonical codewords and builds the decoding table.
+    ///
+    /// \param syms the symbols occurring in the input, at least one
+    /// \param num the number of symbols
+    /// \param lengths the code length of each symbol, indexed by symbol; the lengths must satisfy the Kraft equality, or be zero for a single symbol
+    inline void assign(const Char* syms, const size_t num, const uint8_t* lengths) {
+        assert(num > 0);
+
+        // sort symbols canonically
+        std::vector<Char> sorted(syms, syms + num);
+        std::sort(sorted.begin(), sorted.end(), [&](const Char a, const Char b){
+            return lengths[a] < lengths[b] || (lengths[a] == lengths[b] && a < b);
+        });
+
+        // assign codewords
+        std::fill(length_, length_ + MAX_SYMS, 0);
+        uint64_t code = 0;
+        size_t prev_len = lengths[sorted[0]];
+        for(const Char c : sorted) {
+            const size_t len = lengths[c];
+            assert(len <= MAX_LENGTH);
+            code <<= (len - prev_len);
+            length_[c] = uint8_t(len);
+            code_[c] = code++;
+            prev_len = len;
+        }
+
+        // build decoding tables
+        table_.clear();
+        root_bits_ = build_table(sorted.data(), 0, num, 0);
+    }
+
+    /// \brief The code length of a symbol.
+    inline size_t length(const Char c) const {
+        return length_[c];
+    }
+
+    /// \brief The codeword of a symbol.
+    inline uint64_t codeword(const Char c) const {
+        return code_[c];
+    }
+
+    /// \brief Encodes a symbol.
+    /// \param out the bit output stream to write to
+    /// \param c the symbol
+    inline void encode(BitOStream& out, const Char c) const {
+        out.write_binary(code_[c], length_[c]);
+    }
+
+    /// \brief Decodes a symbol.
+    /// \param in the bit input stream to read from
+    inline Char decode(BitIStream& in) const {
+        size_t offset = 0;
+        size_t bits = root_bits_;
+        while(true) {
+            const Entry& e = table_[offset + in.template peek_binary<size_t>(bits)];
+            in.skip(e.length);
+            if(!e.sub_bits) return Char(e.value);
+
+            offset = e.value;
+            bits = e.sub_bits;
+        }
+    }
+
+    /// \brief Decodes a symbol from a bit buffer.
+    /// \param bits the next input bits, left-aligned, of which at least as many as the maximum code length must be valid
+    /// \param length receives the code length of the decoded symbol
+    inline Char decode(uint64_t bits, size_t& length) const {
+        size_t offset = 0;
+        size_t num_bits = root_bits_;
+        length = 0;
+        while(true) {
+            // shifting by two steps also works for zero bits
+            const Entry& e = table_[offset + size_t((bits >> 1) >> (MAX_LENGTH - 1 - num_bits))];
+            bits <<= e.length;
+            length += e.length;
+            if(!e.sub_bits) return Char(e.value);
+
+            offset = e.value;
+            num_bits = e.sub_bits;
+        }
+    }
+};
+
+}} // namespace tdc::code
@@ -78,14 +78,7 @@ public:
 
             // encode symbol unless it is the first
             if(!(is_nyt && num_nodes_ == 1)) {
-                std::vector<bool> bits; // TODO: use static buffer
-                for(const Node* v = q; v != root_; v = v->parent) {
-                    bits.push_back(v->bit);
-                }
-
-                for(size_t i = bits.size(); i > 0; i--) {
-                    out.write_bit(bits[i-1]);
-                }
+                HuffmanCoderBase::encode(out, q);
             }
 
             // if symbol is NYT, encode ASCII encoding AND frequency
@@ -112,11 +105,7 @@ public:
                 c = sym_coder_.template decode<Char>(in);
                 hist_[c] = freq_coder_.template decode<>(in);
             } else {
-                Node* v = root_;
-                while(!v->is_leaf()) {
-                    v = in.read_bit() ? v->right : v->left;
-                }
-
+                const Node* v = decode_leaf(in);
                 if(v == node(0)) {
                     // NYT
                     c = sym_coder_.template decode<Char>(in);
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include <tdc/code/coder.hpp>
+#include <tdc/code/huff/huffman_table.hpp>
+#include <tdc/code/huff/package_merge.hpp>
+#include <tdc/math/ilog2.hpp>
+
+namespace tdc {
+namespace code {
+
+/// \brief Block Huffman coder that splits each block into interleaved substreams, in the style of Huff0.
+///
+/// Symbol \c i of a block is encoded into substream <tt>i mod num_streams_</tt>, using one length-limited canonical code for all substreams.
+/// Each substream is a separate bit stream, so the decoder can keep one bit buffer per substream and decode a symbol from each of them
+/// without any dependency between them, which allows the processor to overlap the table lookups.
+///
+/// A block consists of the header size as a 32-bit big endian integer, the header, and the substreams.
+/// The header contains the block length, the code lengths and the byte sizes of the substreams.
+///
+/// \tparam num_streams_ the number of substreams
+/// \tparam max_length_ the maximum code length, at most 57 bits; if it does not exceed the lookup width of the table, every symbol is decoded with a single lookup
+template<size_t num_streams_ = 4, size_t max_length_ = CanonicalHuffmanTable::LOOKUP_BITS>
+class MultiStreamHuffmanCoder {
+private:
+    using Char = CanonicalHuffmanTable::Char;
+    static constexpr size_t MAX_SYMS = CanonicalHuffmanTable::MAX_SYMS;
+    static constexpr size_t LENGTH_BITS = math::ilog2_ceil(max_length_);
+
+    // the minimum number of valid bits in a bit buffer after a refill, and the number of symbols that can be decoded from it
+    static constexpr size_t REFILL_BITS = 64 - 7;
+    static constexpr size_t SYMS_PER_REFILL = REFILL_BITS / max_length_;
+
+    static_assert(num_streams_ > 0);
+    static_assert(max_length_ >= 8 && max_length_ <= REFILL_BITS, "invalid maximum code length");
+
+    CanonicalHuffmanTable table_;
+
+    static void write_u32(std::ostream& out, const uint32_t x) {
+        for(size_t i = 4; i > 0; i--) out.put(char(x >> ((i - 1) * 8)));
+    }
+
+    static uint32_t read_u32(const uint8_t* p) {
+        return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+    }
+
+    // loads the bits starting at the given bit position into a left-aligned bit buffer with at least REFILL_BITS valid bits
+    // bytes beyond the end of a substream are garbage that is never decoded, only the end of the input must not be exceeded
+    static uint64_t load_bits(const uint8_t* stream, const size_t pos, const uint8_t* end) {
+        const uint8_t* p = stream + (pos >> 3);
+        uint64_t word;
+        if(p + sizeof(word) <= end) [[likely]] {
+            std::memcpy(&word, p, sizeof(word));
+        } else {
+            uint8_t tail[sizeof(word)] = { 0 };
+            std::memcpy(tail, p, end - p);
+            std::memcpy(&word, tail, sizeof(word));
+        }
+        return __builtin_bswap64(word) << (pos & 7);
+    }
+
+public:
+    /// \brief The number of substreams.
+    static constexpr size_t NUM_STREAMS = num_streams_;
+
+    /// \brief Encodes a block and writes it to the output stream.
+    /// \param block the block
+    /// \param num the length of the block
+    /// \param out the output stream
+    /// \return the number of bytes written
+    size_t encode(const Char* block, const size_t num, std::ostream& out) {
+        // count histogram
+        uint64_t hist[MAX_SYMS] = { 0 };
+        for(size_t i = 0; i < num; i++) ++hist[block[i]];
+
+        Char syms[MAX_SYMS];
+        uint64_t weights[MAX_SYMS];
+        size_t sigma = 0;
+        for(size_t c = 0; c < MAX_SYMS; c++) {
+            if(hist[c]) {
+                syms[sigma] = Char(c);
+                weights[sigma] = hist[c];
+                ++sigma;
+            }
+        }
+
+        // compute the code
+        uint8_t sym_lengths[MAX_SYMS];
+        if(sigma > 0) {
+            package_merge(weights, sigma, max_length_, sym_lengths);
+
+            uint8_t lengths[MAX_SYMS];
+            for(size_t i = 0; i < sigma; i++) lengths[syms[i]] = sym_lengths[i];
+            table_.assign(syms, sigma, lengths);
+        }
+
+        // encode substreams
+        std::ostringstream streams[num_streams_];
+        {
+            std::vector<BitOStream> outs;
+            outs.reserve(num_streams_);
+            for(size_t k = 0; k < num_streams_; k++) outs.emplace_back(streams[k]);
+
+            const size_t rounds = num / num_streams_;
+            for(size_t r = 0; r < rounds; r++) {
+                for(size_t k = 0; k < num_streams_; k++) table_.encode(outs[k], block[r * num_streams_ + k]);
+            }
+            for(size_t i = rounds * num_streams_; i < num; i++) table_.encode(outs[i % num_streams_], block[i]);
+        }
+
+        // write header
+        std::ostringstream header;
+        {
+            BitOStream hout(header);
+            hout.write_delta(num + 1);
+            hout.write_delta(sigma + 1);
+            for(size_t i = 0; i < sigma; i++) {
+                hout.write_binary(syms[i], CHAR_BIT);
+                hout.write_binary(sym_lengths[i], LENGTH_BITS);
+            }
+            for(size_t k = 0; k < num_streams_; k++) hout.write_delta(streams[k].view().size());
+        }
+
+        const auto h = header.view();
+        write_u32(out, uint32_t(h.size()));
+        out.write(h.data(), h.size());
+        size_t bytes = 4 + h.size();
+        for(size_t k = 0; k < num_streams_; k++) {
+            const auto s = streams[k].view();
+            out.write(s.data(), s.size());
+            bytes += s.size();
+        }
+        return bytes;
+    }
+
+    /// \brief Decodes a block from memory.
+    /// \param data the encoded block
+    /// \param size the number of available bytes, which may exceed the size of the block
+    /// \param block receives the decoded block
+    /// \return the number of bytes consumed
+    size_t decode(const void* data, const size_t size, std::vector<Char>& block) {
+        const uint8_t* p = (const uint8_t*)data;
+        assert(size >= 4);
+        const size_t header_size = read_u32(p);
+        p += 4;
+
+        // read header
+        size_t stream_sizes[num_streams_];
+        size_t num;
+        {
+            BitIStream hin(p, header_size);
+            num = hin.read_delta<>() - 1;
+
+            const size_t sigma = hin.read_delta<>() - 1;
+            if(sigma > 0) {
+                Char syms[MAX_SYMS];
+                uint8_t lengths[MAX_SYMS];
+                for(size_t i = 0; i < sigma; i++) {
+                    const Char c = hin.read_binary<Char>(CHAR_BIT);
+                    syms[i] = c;
+                    lengths[c] = hin.read_binary<uint8_t>(LENGTH_BITS);
+                }
+                table_.assign(syms, sigma, lengths);
+            }
+            for(size_t k = 0; k < num_streams_; k++) stream_sizes[k] = hin.read_delta<>();
+        }
+        p += header_size;
+
+        // locate substreams
+        const uint8_t* end = (const uint8_t*)data + size;
+        const uint8_t* streams[num_streams_];
+        for(size_t k = 0; k < num_streams_; k++) {
+            assert(p + stream_sizes[k] <= end);
+            streams[k] = p;
+            p += stream_sizes[k];
+        }
+
+        // each substream has its own bit position and bit buffer, which is refilled once per round
+        // in a round, SYMS_PER_REFILL symbols are decoded from each substream, one substream after the other
+        size_t pos[num_streams_] = { 0 };
+        uint64_t bits[num_streams_];
+
+        block.resize(num);
+        Char* dst = block.data();
+        const size_t syms_per_round = SYMS_PER_REFILL * num_streams_;
+        const size_t rounds = num / syms_per_round;
+        for(size_t r = 0; r < rounds; r++) {
+            for(size_t k = 0; k < num_streams_; k++) bits[k] = load_bits(streams[k], pos[k], end);
+            for(size_t j = 0; j < SYMS_PER_REFILL; j++) {
+                for(size_t k = 0; k < num_streams_; k++) {
+                    size_t len;
+                    dst[k] = table_.decode(bits[k], len);
+                    bits[k] <<= len;
+                    pos[k] += len;
+                }
+                dst += num_streams_;
+            }
+        }
+
+        // decode the remaining symbols one by one
+        for(size_t i = rounds * syms_per_round; i < num; i++) {
+            const size_t k = i % num_streams_;
+            size_t len;
+            *dst++ = table_.decode(load_bits(streams[k], pos[k], end), len);
+            pos[k] += len;
+        }
+
+        return p - (const uint8_t*)data;
+    }
+};
+
+}} // namespace tdc::code
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+namespace tdc {
+namespace code {
+
+/// \brief Computes optimal length-limited prefix code lengths using the package-merge algorithm [Larmore and Hirschberg, 1990].
+///
+/// For each level from the maximum code length up to one, the items of the next deeper level are paired into packages,
+/// which are merged with the symbols by weight. Of the top level, the lightest <tt>2n-2</tt> items are selected, and the packages among them
+/// determine how many items are selected on the next deeper level. The code length of a symbol is the number of levels on which it is selected.
+/// Because symbols are merged in order of weight, the selected symbols on every level are the lightest ones, so only their number needs to be tracked.
+///
+/// \param weights the weight of each symbol, all greater than zero
+/// \param num the number of symbols
+/// \param max_length the maximum code length, such that <tt>2^max_length >= num</tt>
+/// \param lengths receives the code length of each symbol; a single symbol receives length zero
+inline void package_merge(const uint64_t* weights, const size_t num, const size_t max_length, uint8_t* lengths) {
+    assert(num > 0);
+    assert(max_length < 64 && (1ULL << max_length) >= num);
+
+    if(num == 1) {
+        lengths[0] = 0;
+        return;
+    }
+
+    // sort symbols by weight
+    std::vector<size_t> order(num);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](const size_t a, const size_t b){ return weights[a] < weights[b]; });
+
+    struct Item {
+        uint64_t weight;
+        bool is_symbol;
+    };
+
+    // lists[d] is the merged list of level d+1
+    std::vector<std::vector<Item>> lists(max_length);
+    for(size_t d = max_length; d > 0; d--) {
+        auto& list = lists[d - 1];
+        list.reserve(2 * num);
+
+        if(d == max_length) {
+            for(const size_t i : order) list.push_back(Item { weights[i], true });
+        } else {
+            // merge symbols with packages of the deeper level
+            const auto& deeper = lists[d];
+            size_t i = 0, k = 0;
+            while(i < num || k + 1 < deeper.size()) {
+                const bool take_package = (k + 1 < deeper.size()) &&
+                    (i >= num || deeper[k].weight + deeper[k + 1].weight < weights[order[i]]);
+
+                if(take_package) {
+                    list.push_back(Item { deeper[k].weight + deeper[k + 1].weight, false });
+                    k += 2;
+                } else {
+                    list.push_back(Item { weights[order[i]], true });
+                    ++i;
+                }
+            }
+        }
+    }
+
+    // select items top-down and count code lengths
+    std::fill(lengths, lengths + num, 0);
+    size_t m = 2 * num - 2;
+    for(size_t d = 1; d <= max_length && m > 0; d++) {
+        const auto& list = lists[d - 1];
+        assert(m <= list.size());
+
+        size_t num_symbols = 0;
+        for(size_t j = 0; j < m; j++) {
+            if(list[j].is_symbol) ++num_symbols;
+        }
+        for(size_t i = 0; i < num_symbols; i++) {
+            ++lengths[order[i]];
+        }
+        m = 2 * (m - num_symbols);
+    }
+}
+
+}} // namespace tdc::code
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include <tdc/code/huff/adaptive_huffman_coder_base.hpp>
+
+namespace tdc {
+namespace code {
+
+// dynamic (online) Huffman coding according to Vitter's algorithm Lambda [Vitter, 1987]
+// nodes are ranked by weight, and among nodes of equal weight, leaves are ranked below inner nodes
+// nodes of equal weight and type form a block, and the node of highest rank in a block is its leader
+// instead of interchanging a node with the leader of each block up the tree, like [Knuth, 1985], a node is slid past the following block,
+// which minimizes the height of the tree among all Huffman trees and requires fewer interchanges
+template<typename SymCoder>
+class VitterCoder : public AdaptiveHuffmanCoderBase {
+private:
+    SymCoder sym_coder_;
+
+public:
+    inline VitterCoder() : AdaptiveHuffmanCoderBase() {
+        // init tree with NYT node
+        num_nodes_ = 1;
+        nodes_[0] = Node{ 0, 0, nullptr, 0, nullptr, nullptr, 0 };
+        root_ = node(0);
+        rank_map_[0] = root_;
+
+        // initialize symbol index
+        for(size_t c = 0; c < MAX_SYMS; c++) {
+            leaves_[c] = nullptr;
+        }
+    }
+
+    inline VitterCoder(const std::string& s, BitOStream& out) : VitterCoder() {
+    }
+
+    inline VitterCoder(BitIStream& in) : VitterCoder() {
+    }
+
+    inline void encode(BitOStream& out, const Char c) {
+        const Node* q = leaves_[c];
+        const bool is_nyt = !q;
+        if(is_nyt) q = node(0);
+
+        // encode symbol unless it is the first
+        if(!(is_nyt && num_nodes_ == 1)) {
+            HuffmanCoderBase::encode(out, q);
+        }
+
+        // if symbol is NYT, encode ASCII encoding
+        if(is_nyt) {
+            sym_coder_.encode(out, c);
+        }
+
+        update(c);
+    }
+
+    inline Char decode(BitIStream& in) {
+        Char c;
+        if(num_nodes_ == 1) {
+            // first character
+            c = sym_coder_.template decode<Char>(in);
+        } else {
+            const Node* v = decode_leaf(in);
+            if(v == node(0)) {
+                // NYT
+                c = sym_coder_.template decode<Char>(in);
+            } else {
+                c = v->sym;
+            }
+        }
+
+        update(c);
+        return c;
+    }
+
+private:
+    static inline bool same_block(Node* u, Node* v) {
+        return u->weight == v->weight && u->is_leaf() == v->is_leaf();
+    }
+
+    // moves u to the given position in the tree and the ranking
+    inline void move(Node* u, Node* parent, const bool bit, const index_t rank) {
+        u->parent = parent;
+        u->bit = bit;
+        u->rank = rank;
+        rank_map_[rank] = u;
+
+        if(parent) {
+            if(bit) {
+                parent->right = u;
+            } else {
+                parent->left = u;
+            }
+        } else {
+            root_ = u;
+        }
+    }
+
+    // interchanges v with the leader of its block
+    inline void to_leader(Node* v) {
+        index_t rank = v->rank;
+        while(rank + 1 < num_nodes_ && same_block(rank_map_[rank + 1], v)) ++rank;
+
+        if(rank != v->rank) {
+            Node* u = rank_map_[rank];
+            Node* const u_parent = u->parent;
+            const bool u_bit = u->bit;
+
+            move(u, v->parent, v->bit, v->rank);
+            move(v, u_parent, u_bit, rank);
+        }
+    }
+
+    // increments the weight of p, sliding it past the following block if necessary, and returns the next node to be processed
+    inline Node* slide_and_increment(Node* p) {
+        to_leader(p);
+
+        // p is followed by leaves of weight w+1 if it is an inner node, or by inner nodes of weight w if it is a leaf
+        const index_t w = p->weight;
+        const bool leaf = p->is_leaf();
+        const index_t bw = leaf ? w : w + 1;
+
+        index_t last = p->rank;
+        while(last + 1 < num_nodes_) {
+            Node* x = rank_map_[last + 1];
+            if(x->weight != bw || x->is_leaf() == leaf) break;
+            ++last;
+        }
+
+        Node* const former_parent = p->parent;
+        if(last != p->rank) {
+            // slide p past the block, each node in it takes the position of its predecessor
+            Node* parent = p->parent;
+            bool bit = p->bit;
+            for(index_t rank = p->rank + 1; rank <= last; rank++) {
+                Node* x = rank_map_[rank];
+                Node* const x_parent = x->parent;
+                const bool x_bit = x->bit;
+
+                move(x, parent, bit, rank - 1);
+                parent = x_parent;
+                bit = x_bit;
+            }
+            move(p, parent, bit, last);
+        }
+
+        ++p->weight;
+
+        // a slid leaf now increases the weight of its new parent,
+        // whereas the former parent of a slid inner node has received a heavier node
+        return leaf ? p->parent : former_parent;
+    }
+
+    inline void update(const Char c) {
+        Node* nyt = node(0);
+
+        Node* q = leaves_[c];
+        Node* leaf_to_increment = nullptr;
+        if(!q) {
+            // new symbol - replace NYT by an inner node with NYT and the new leaf as children
+            // the new nodes have weight zero and therefore take ranks 1 and 2, so all ranks other than NYT's increase by two
+            for(index_t rank = num_nodes_ - 1; rank > 0; rank--) {
+                Node* x = rank_map_[rank];
+                x->rank = rank + 2;
+                rank_map_[rank + 2] = x;
+            }
+
+            Node* v = node(num_nodes_++);
+            q = node(num_nodes_++);
+            leaves_[c] = q;
+
+            *v = Node { 0, 0, nullptr, 0, nyt, q, 0 };
+            move(v, nyt->parent, nyt->bit, 2);
+
+            nyt->parent = v;
+            nyt->bit = 0;
+
+            *q = Node { 0, 1, v, 1, nullptr, nullptr, c };
+            rank_map_[1] = q;
+
+            leaf_to_increment = q;
+            q = v;
+        } else {
+            to_leader(q);
+
+            // the sibling of NYT has the same weight as its parent, so the parent must be incremented first
+            if(q->parent && q->parent->left == nyt) {
+                leaf_to_increment = q;
+                q = q->parent;
+            }
+        }
+
+        while(q) q = slide_and_increment(q);
+        if(leaf_to_increment) slide_and_increment(leaf_to_increment);
+    }
+};
+
+}} // namespace tdc::code
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <span>
+
 #include <tdc/code/coder.hpp>
+#include <tdc/math/ilog2.hpp>
 
 namespace tdc {
 namespace code {
@@ -25,6 +28,15 @@ public:
         out.write_rice(value, m_golomb_exponent);
     }
 
+    /// \brief Computes the length of the code for an integer in bits.
+    /// \tparam T the integer type
+    /// \param value the value to encode
+    template<typename T>
+    size_t encoded_length(T value) const {
+        const uint64_t q = uint64_t(value) >> m_golomb_exponent;
+        return 2 * math::ilog2_floor(q + 1) + 1 + m_golomb_exponent;
+    }
+
     /// \brief Decodes an integer from the given input stream using \c m_bits.
     /// \tparam T the integer type
     /// \param in the input stream to read from
@@ -32,6 +44,24 @@ public:
     T decode(BitIStream& in) {
         return in.template read_rice<T>(m_golomb_exponent);
     }
+
+    /// \brief Encodes a sequence of integers to the given output stream.
+    /// \tparam T the integer type
+    /// \param out the bit output stream to write to
+    /// \param values the values to encode
+    template<typename T>
+    void encode(BitOStream& out, std::span<T> values) {
+        for(const auto v : values) out.write_rice(v, m_golomb_exponent);
+    }
+
+    /// \brief Decodes a sequence of integers from the given input stream.
+    /// \tparam T the integer type
+    /// \param in the input stream to read from
+    /// \param values the span to decode into, its size determines the number of values
+    template<typename T>
+    void decode(BitIStream& in, std::span<T> values) {
+        in.read_rice(values, m_golomb_exponent);
+    }
 };
 
 }} // namespace tdc::code
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__BMI2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include <tdc/intrisics/tzcnt.hpp>
+
+namespace tdc {
+namespace code {
+
+/// \brief The maximum number of bytes of a variable-byte code for a 64-bit integer.
+constexpr size_t VBYTE_MAX_BYTES = 10;
+
+/// \brief Computes the number of bytes of the variable-byte code of an integer.
+/// \param x the integer
+inline size_t vbyte_length(uint64_t x) {
+    size_t len = 1;
+    while(x >= 0x80) {
+        x >>= 7;
+        ++len;
+    }
+    return len;
+}
+
+/// \brief Writes the variable-byte code of an integer.
+///
+/// The integer is split into groups of seven bits, which are written starting with the least significant group.
+/// The most significant bit of each byte is set if and only if more bytes follow (LEB128).
+///
+/// \param out the output buffer, which must have room for at least \ref VBYTE_MAX_BYTES bytes
+/// \param x the integer to encode
+/// \return the number of bytes written
+inline size_t vbyte_encode(uint8_t* out, uint64_t x) {
+    size_t len = 0;
+    while(x >= 0x80) {
+        out[len++] = uint8_t(x | 0x80);
+        x >>= 7;
+    }
+    out[len++] = uint8_t(x);
+    return len;
+}
+
+/// \brief Decodes a variable-byte code one byte at a time.
+/// \param in the input buffer, which is advanced past the code
+/// \return the decoded integer
+inline uint64_t vbyte_decode(const uint8_t*& in) {
+    uint64_t x = 0;
+    size_t shift = 0;
+    uint8_t b;
+    do {
+        b = *in++;
+        x |= uint64_t(b & 0x7F) << shift;
+        shift += 7;
+    } while(b & 0x80);
+    return x;
+}
+
+/// \brief Extracts the value of a variable-byte code of at most eight bytes from a little-endian word.
+///
+/// Using BMI2, the seven payload bits of each byte are gathered using a single \c pext instruction.
+/// Otherwise, they are compacted in three shift-and-mask steps.
+///
+/// \param word the word starting with the code
+/// \param len the number of bytes of the code
+inline uint64_t vbyte_extract(uint64_t word, const size_t len) {
+    if(len < 8) word &= (uint64_t(1) << (8 * len)) - 1;
+#ifdef __BMI2__
+    return _pext_u64(word, 0x7F7F7F7F7F7F7F7FULL);
+#else
+    word &= 0x7F7F7F7F7F7F7F7FULL;
+    word = (word & 0x007F007F007F007FULL) | ((word & 0x7F007F007F007F00ULL) >> 1);
+    word = (word & 0x00003FFF00003FFFULL) | ((word & 0x3FFF00003FFF0000ULL) >> 2);
+    return (word & 0x000000000FFFFFFFULL) | ((word & 0x0FFFFFFF00000000ULL) >> 4);
+#endif
+}
+
+/// \brief Gets the bit mask of bytes that terminate a variable-byte code within the next 16 bytes.
+///
+/// Bit \c i of the result is set if and only if the most significant bit of the <tt>i</tt>-th byte is clear.
+/// With SSE2, this is a single \c movemask instruction.
+///
+/// \param in the input buffer, of which 16 bytes must be readable
+inline uint32_t vbyte_stop_mask(const uint8_t* in) {
+#ifdef __SSE2__
+    return ~uint32_t(_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)in))) & 0xFFFFU;
+#else
+    uint64_t lo, hi;
+    std::memcpy(&lo, in, 8);
+    std::memcpy(&hi, in + 8, 8);
+    lo = ~lo & 0x8080808080808080ULL;
+    hi = ~hi & 0x8080808080808080ULL;
+    // gather the most significant bit of each byte
+    const uint32_t mlo = uint32_t(((lo >> 7) * 0x0102040810204080ULL) >> 56);
+    const uint32_t mhi = uint32_t(((hi >> 7) * 0x0102040810204080ULL) >> 56);
+    return mlo | (mhi << 8);
+#endif
+}
+
+/// \brief Decodes a variable-byte code of at most eight bytes whose terminating byte is known.
+/// \param in the input buffer, which is advanced past the code and of which eight bytes must be readable
+/// \param len the number of bytes of the code
+inline uint64_t vbyte_decode(const uint8_t*& in, const size_t len) {
+    uint64_t word;
+    std::memcpy(&word, in, 8);
+    in += len;
+    return vbyte_extract(word, len);
+}
+
+}} // namespace tdc::code
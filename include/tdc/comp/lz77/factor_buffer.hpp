@@ -2,8 +2,10 @@
 
 #include <algorithm>
 #include <cassert>
+#include <concepts>
 #include <string>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "factor.hpp"
@@ -12,19 +14,46 @@ namespace tdc {
 namespace comp {
 namespace lz77 {
 
+/// \brief A source of factors that can be merged by \ref FactorBuffer::merge.
+template<typename R>
+concept FactorReader = requires(R r) {
+    { r.read() } -> std::convertible_to<Factor>;
+    { (bool)r };
+};
+
 class FactorBuffer {
-private:
-    class FactorIterator {
+public:
+    /// \brief Reads the factors contained in a buffer.
+    class Reader {
     private:
         std::vector<Factor>::const_iterator it_;
         std::vector<Factor>::const_iterator end_;
+
+    public:
+        Reader(const FactorBuffer& buffer) : it_(buffer.factors_.begin()), end_(buffer.factors_.end()) {
+        }
+
+        operator bool() const {
+            return it_ != end_;
+        }
+
+        const Factor& read() {
+            return *it_++;
+        }
+    };
+
+private:
+    template<FactorReader R>
+    class FactorIterator {
+    private:
+        R reader_;
         size_t pos_;
         Factor current_;
 
     public:
-        FactorIterator(const FactorBuffer& buffer) : it_(buffer.factors_.begin()), end_(buffer.factors_.end()), pos_(0) {
-            if(it_ != end_) {
-                current_ = *it_++;
+        FactorIterator(R&& reader) : reader_(std::move(reader)), pos_(0) {
+            if(reader_) {
+                current_ = reader_.read();
             }
         }
         
@@ -32,8 +61,9 @@ private:
             return current_.is_valid();
         }
         
-        bool operator>(const FactorIterator& other) const {
-            return current_.len > other.current_.len || (current_.len == other.current_.len && (current_.src > other.current_.src || current_.is_reference() && other.current_.is_literal()));
+        template<FactorReader S>
+        bool operator>(const FactorIterator<S>& other) const {
+            return *this > *other;
         }
         
         bool operator>(const Factor& f) const {
@@ -44,8 +74,8 @@ private:
             while(pos_ < target) {
                 if(current_.len <= 1) {
                     // reference of length 1 or literal, advance to next
-                    if(it_ != end_) {
-                        current_ = *it_++;
+                    if(reader_) {
+                        current_ = reader_.read();
                     } else {
                         current_ = Factor();
                         return false;
@@ -60,21 +90,22 @@ private:
             return true;
         }
         
-        const Factor& operator*() {
+        const Factor& operator*() const {
             return current_;
         }
     };
 
 public:
-    template<typename FactorOutput>
-    static void merge(const FactorBuffer& buffer_a, const FactorBuffer& buffer_b, FactorOutput& out) {
-        assert(buffer_a.input_size_ == buffer_b.input_size_);
-        
-        FactorIterator a(buffer_a);
-        FactorIterator b(buffer_b);
+    /// \brief Greedily merges two factorizations of the same input.
+    ///
+    /// At each position, the longer of the two factors covering the position is emitted.
+    /// The factorizations are consumed using readers, e.g., \ref Reader or a \ref FactorStreamReader for memory mapped files.
+    template<FactorReader RA, FactorReader RB, typename FactorOutput>
+    static void merge(RA reader_a, RB reader_b, FactorOutput& out) {
+        FactorIterator<RA> a(std::move(reader_a));
+        FactorIterator<RB> b(std::move(reader_b));
         
         size_t i = 0;
-        size_t num_factors = 0;
         
         while(a && b) {
             // greedily select next factor
@@ -83,7 +114,6 @@ public:
             // emit factor
             i += f.decoded_length();
             out.emplace_back(f);
-            ++num_factors;
 
             // advance
             a.advance_to(i);
@@ -91,21 +121,18 @@ public:
         }
 
         // done!
-        assert(i == buffer_a.input_size_);
-        assert(num_factors <= std::min(buffer_a.size(), buffer_b.size()));
+        assert(!a && !b); // both factorizations must end at the same position
     }
     
-    template<typename FactorOutput>
-    static void merge(const FactorBuffer& buffer_a, const FactorBuffer& buffer_b, const FactorBuffer& buffer_c, FactorOutput& out) {
-        assert(buffer_a.input_size_ == buffer_b.input_size_);
-        assert(buffer_a.input_size_ == buffer_c.input_size_);
-        
-        FactorIterator a(buffer_a);
-        FactorIterator b(buffer_b);
-        FactorIterator c(buffer_c);
+    /// \brief Greedily merges three factorizations of the same input.
+    /// \see merge
+    template<FactorReader RA, FactorReader RB, FactorReader RC, typename FactorOutput>
+    static void merge(RA reader_a, RB reader_b, RC reader_c, FactorOutput& out) {
+        FactorIterator<RA> a(std::move(reader_a));
+        FactorIterator<RB> b(std::move(reader_b));
+        FactorIterator<RC> c(std::move(reader_c));
         
         size_t i = 0;
-        size_t num_factors = 0;
         
         while(a && b && c) {
             // greedily select next factor
@@ -116,7 +143,6 @@ public:
             // emit factor
             i += f.decoded_length();
             out.emplace_back(f);
-            ++num_factors;
 
             // advance
             a.advance_to(i);
@@ -125,8 +151,20 @@ public:
         }
 
         // done!
-        assert(i == buffer_a.input_size_);
-        assert(num_factors <= std::min(buffer_a.size(), std::min(buffer_b.size(), buffer_c.size())));
+        assert(!a && !b && !c); // all factorizations must end at the same position
+    }
+
+    template<typename FactorOutput>
+    static void merge(const FactorBuffer& buffer_a, const FactorBuffer& buffer_b, FactorOutput& out) {
+        assert(buffer_a.input_size_ == buffer_b.input_size_);
+        merge(Reader(buffer_a), Reader(buffer_b), out);
+    }
+    
+    template<typename FactorOutput>
+    static void merge(const FactorBuffer& buffer_a, const FactorBuffer& buffer_b, const FactorBuffer& buffer_c, FactorOutput& out) {
+        assert(buffer_a.input_size_ == buffer_b.input_size_);
+        assert(buffer_a.input_size_ == buffer_c.input_size_);
+        merge(Reader(buffer_a), Reader(buffer_b), Reader(buffer_c), out);
     }
 
 private:
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <sstream>
+#include <string>
+
+#include <tdc/code/coder.hpp>
+#include <tdc/util/char.hpp>
+
+#include "factor.hpp"
+
+namespace tdc {
+namespace comp {
+namespace lz77 {
+
+/// \brief Encodes and decodes LZ77 factorizations in a bit stream.
+///
+/// An encoded factorization consists of the number of factors, the literal section and the factor section.
+/// In the factor section, each factor is represented by a bit telling whether it is a reference,
+/// followed by the delta code of the distance to its source and the Rice code of its length if it is.
+///
+/// The literals are coded by the literal coder in the literal section, which is preceded by its size in bytes.
+/// Because the literals do not share their bit stream with other codes, the literal coder may defer its output,
+/// which allows for arithmetic coders like \ref code::ContextMixingCoder (see \ref code::BinaryRangeCoder).
+///
+/// \tparam LiteralCoder the coder for literals
+template<typename LiteralCoder>
+class FactorCoder {
+private:
+    static constexpr uint8_t LENGTH_RICE_PARAM = 4;
+
+public:
+    /// \brief Encodes a factorization.
+    /// \param factors the factors
+    /// \param out the bit output stream to write to
+    static void encode(std::span<const Factor> factors, io::BitOStream& out) {
+        // encode literal section
+        std::ostringstream literals;
+        {
+            io::BitOStream lit_out(literals);
+            LiteralCoder lit_coder;
+            for(const auto& f : factors) {
+                if(f.is_literal()) lit_coder.encode(lit_out, f.literal());
+            }
+            lit_coder.encode_finalize(lit_out);
+        }
+
+        out.write_delta(factors.size() + 1);
+
+        const auto lit = literals.view();
+        out.write_delta(lit.size() + 1);
+        for(const char c : lit) out.write_binary(uint8_t(c), 8);
+
+        // encode factor section
+        size_t pos = 0;
+        for(const auto& f : factors) {
+            if(f.is_literal()) {
+                out.write_bit(0);
+            } else {
+                assert(pos > f.src);
+                out.write_bit(1);
+                out.write_delta(pos - f.src);
+                out.write_rice(f.len, LENGTH_RICE_PARAM);
+            }
+            pos += f.decoded_length();
+        }
+    }
+
+    /// \brief Decodes a factorization.
+    /// \tparam FactorOutput the factor output type
+    /// \param in the bit input stream to read from
+    /// \param out the output receiving the factors
+    template<typename FactorOutput>
+    static void decode(io::BitIStream& in, FactorOutput& out) {
+        const size_t num = in.template read_delta<size_t>() - 1;
+
+        // read literal section
+        std::string literals(in.template read_delta<size_t>() - 1, 0);
+        for(auto& c : literals) c = char(in.template read_binary<uint8_t>(8));
+
+        io::BitIStream lit_in(literals.data(), literals.size());
+        LiteralCoder lit_coder;
+        lit_coder.decode_init(lit_in);
+
+        // decode factor section
+        size_t pos = 0;
+        for(size_t i = 0; i < num; i++) {
+            if(in.read_bit()) {
+                const size_t dist = in.template read_delta<size_t>();
+                const size_t len = in.template read_rice<size_t>(LENGTH_RICE_PARAM);
+                assert(dist <= pos);
+                out.emplace_back(index_t(pos - dist), index_t(len));
+                pos += len;
+            } else {
+                out.emplace_back(char_t(lit_coder.decode(lit_in)));
+                ++pos;
+            }
+        }
+    }
+};
+
+}}} // namespace tdc::comp::lz77
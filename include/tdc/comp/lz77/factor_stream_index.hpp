@@ -0,0 +1,191 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include <tdc/io/mmap_file.hpp>
+#include <tdc/util/char.hpp>
+
+#include "factor_stream_reader.hpp"
+
+namespace tdc {
+namespace comp {
+namespace lz77 {
+
+/// \brief Random access to a text encoded as a factor stream (see \ref FactorStreamOutput), using an index written by a \ref FactorStreamIndexOutput.
+///
+/// The index samples checkpoints, i.e., factors at which decoding can be restarted, at regular intervals of the text.
+/// For each checkpoint, the index stores the window of text preceding it that the references of the following block depend on, up to a maximum size.
+/// To extract a substring, decoding starts at the last checkpoint before it, with the window as the initially decoded text.
+/// Sources outside of the window are copied from the blocks containing them, which are decoded entirely and at most once per extraction.
+/// This is never necessary if the maximum window size is at least the compressor's window size.
+///
+/// The index file consists of the concatenated windows, followed by the checkpoints and a trailer containing the text length and the number of checkpoints.
+class FactorStreamIndex {
+public:
+    /// \brief A point at which decoding can be restarted.
+    struct Checkpoint {
+        uint64_t pos;           ///< the position in the decoded text
+        uint64_t offset;        ///< the offset of the factor starting at the position in the factor stream
+        uint64_t window_len;    ///< the length of the text window preceding the position
+        uint64_t window_offset; ///< the offset of the window in the index file
+    };
+
+    /// \brief The size of the index file trailer.
+    static constexpr size_t TRAILER_BYTES = 2 * sizeof(uint64_t);
+
+private:
+    const uint8_t* factors_;
+    const uint8_t* factors_end_;
+    const uint8_t* index_;
+    std::vector<Checkpoint> checkpoints_;
+    size_t size_;
+
+    // decoded blocks, including their windows, by checkpoint number
+    using BlockCache = std::unordered_map<size_t, std::vector<char_t>>;
+
+    // finds the last checkpoint at or before a position
+    size_t find_block(const size_t pos) const {
+        auto it = std::upper_bound(checkpoints_.begin(), checkpoints_.end(), pos, [](const size_t x, const Checkpoint& c){ return x < c.pos; });
+        assert(it != checkpoints_.begin());
+        return (it - checkpoints_.begin()) - 1;
+    }
+
+    size_t block_end(const size_t b) const {
+        return b + 1 < checkpoints_.size() ? (size_t)checkpoints_[b + 1].pos : size_;
+    }
+
+    // decodes the text from the window of a checkpoint up to the given end position
+    std::vector<char_t> decode(const size_t b, const size_t end, BlockCache& cache) const {
+        const Checkpoint& c = checkpoints_[b];
+        const size_t begin = c.pos - c.window_len;
+        std::vector<char_t> buf(end - begin);
+        std::memcpy(buf.data(), index_ + c.window_offset, c.window_len * sizeof(char_t));
+
+        FactorStreamReader reader(factors_ + c.offset, factors_end_, c.pos);
+        size_t i = c.pos;
+        while(i < end) {
+            assert(reader);
+            const auto f = reader.read();
+            if(f.is_literal()) {
+                buf[i - begin] = f.literal();
+                ++i;
+            } else {
+                const size_t n = std::min((size_t)f.len, end - i);
+                const size_t src = f.src;
+                size_t k = 0;
+                if(src < begin) {
+                    // the source starts before the window
+                    k = std::min(n, begin - src);
+                    copy(src, k, buf.data() + (i - begin), cache);
+                }
+                // copy forwards, as the source may overlap the factor
+                for(; k < n; k++) buf[i + k - begin] = buf[src + k - begin];
+                i += n;
+            }
+        }
+        return buf;
+    }
+
+    // copies a substring from fully decoded blocks, each of which is decoded at most once per extraction
+    void copy(size_t pos, size_t len, char_t* out, BlockCache& cache) const {
+        while(len > 0) {
+            const size_t b = find_block(pos);
+            auto it = cache.find(b);
+            if(it == cache.end()) {
+                auto buf = decode(b, block_end(b), cache);
+                it = cache.emplace(b, std::move(buf)).first;
+            }
+
+            const size_t begin = checkpoints_[b].pos - checkpoints_[b].window_len;
+            const size_t k = std::min(len, block_end(b) - pos);
+            std::memcpy(out, it->second.data() + (pos - begin), k * sizeof(char_t));
+            pos += k;
+            out += k;
+            len -= k;
+        }
+    }
+
+public:
+    /// \brief Opens an index in memory.
+    /// \param factors the encoded factors
+    /// \param factors_size the number of bytes of encoded factors
+    /// \param index the index
+    /// \param index_size the number of bytes of the index
+    FactorStreamIndex(const void* factors, const size_t factors_size, const void* index, const size_t index_size)
+        : factors_((const uint8_t*)factors), factors_end_((const uint8_t*)factors + factors_size), index_((const uint8_t*)index) {
+
+        if(index_size < TRAILER_BYTES) {
+            throw std::runtime_error("index is truncated");
+        }
+
+        uint64_t trailer[2];
+        std::memcpy(trailer, index_ + index_size - TRAILER_BYTES, TRAILER_BYTES);
+        size_ = trailer[0];
+
+        const size_t num = trailer[1];
+        if(num > (index_size - TRAILER_BYTES) / sizeof(Checkpoint)) {
+            throw std::runtime_error("index is truncated");
+        }
+
+        // the checkpoints are not necessarily aligned in the file, so they are copied
+        checkpoints_.resize(num);
+        std::memcpy(checkpoints_.data(), index_ + index_size - TRAILER_BYTES - num * sizeof(Checkpoint), num * sizeof(Checkpoint));
+    }
+
+    /// \brief Opens an index from memory mapped files, which must remain mapped while the index is used.
+    /// \param factors the file containing the encoded factors
+    /// \param index the index file
+    FactorStreamIndex(const io::MMapReadOnlyFile& factors, const io::MMapReadOnlyFile& index)
+        : FactorStreamIndex(factors.data(), factors.size(), index.data(), index.size()) {
+    }
+
+    FactorStreamIndex(const FactorStreamIndex&) = default;
+    FactorStreamIndex(FactorStreamIndex&&) = default;
+    FactorStreamIndex& operator=(const FactorStreamIndex&) = default;
+    FactorStreamIndex& operator=(FactorStreamIndex&&) = default;
+
+    /// \brief The length of the decoded text.
+    size_t size() const {
+        return size_;
+    }
+
+    /// \brief The number of checkpoints.
+    size_t num_checkpoints() const {
+        return checkpoints_.size();
+    }
+
+    /// \brief Extracts a substring of the decoded text.
+    /// \param pos the starting position of the substring
+    /// \param len the length of the substring
+    /// \param out the output buffer, which must have room for \c len characters
+    void extract(const size_t pos, const size_t len, char_t* out) const {
+        if(len == 0) return;
+        if(pos + len > size_) {
+            throw std::runtime_error("substring exceeds the decoded text");
+        }
+
+        BlockCache cache;
+        const size_t b = find_block(pos);
+        const auto buf = decode(b, pos + len, cache);
+        const size_t begin = checkpoints_[b].pos - checkpoints_[b].window_len;
+        std::memcpy(out, buf.data() + (pos - begin), len * sizeof(char_t));
+    }
+
+    /// \brief Extracts a substring of the decoded text.
+    /// \param pos the starting position of the substring
+    /// \param len the length of the substring
+    std::vector<char_t> extract(const size_t pos, const size_t len) const {
+        std::vector<char_t> out(len);
+        extract(pos, len, out.data());
+        return out;
+    }
+};
+
+}}}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include <tdc/util/char.hpp>
+#include <tdc/util/literals.hpp>
+
+#include "factor_stream_index.hpp"
+#include "factor_stream_output.hpp"
+
+namespace tdc {
+namespace comp {
+namespace lz77 {
+
+/// \brief Writes factors to a factor stream (see \ref FactorStreamOutput) and a random access index for it (see \ref FactorStreamIndex).
+///
+/// A checkpoint is placed at the first factor starting at least \c interval characters after the previous checkpoint.
+/// When the block following a checkpoint is complete, the text window preceding the checkpoint that the block's references depend on is written to the index, up to a maximum size.
+/// Because the windows are copied from the input text, the text must remain accessible while factors are written.
+class FactorStreamIndexOutput {
+private:
+    const char_t* text_;
+    FactorStreamOutput stream_;
+    std::ostream* index_;
+
+    size_t interval_;
+    size_t max_window_;
+
+    size_t pos_; // current position in the decoded text
+    size_t block_min_src_; // minimum source of the references in the current block
+    std::vector<FactorStreamIndex::Checkpoint> checkpoints_;
+    size_t index_bytes_;
+    bool finished_;
+
+    void write_index(const void* data, const size_t num_bytes) {
+        index_->write((const char*)data, num_bytes);
+        index_bytes_ += num_bytes;
+    }
+
+    void finish_block() {
+        if(checkpoints_.empty()) return;
+
+        auto& c = checkpoints_.back();
+        c.window_len = std::min(c.pos - std::min(block_min_src_, (size_t)c.pos), max_window_);
+        c.window_offset = index_bytes_;
+        write_index(text_ + c.pos - c.window_len, c.window_len * sizeof(char_t));
+    }
+
+    void begin_factor() {
+        if(checkpoints_.empty() || pos_ >= checkpoints_.back().pos + interval_) {
+            finish_block();
+            checkpoints_.push_back(FactorStreamIndex::Checkpoint { pos_, stream_.bytes_written(), 0, 0 });
+            block_min_src_ = pos_;
+        }
+    }
+
+public:
+    /// \brief Constructs an indexed factor output.
+    /// \param text the input text, which must remain accessible while factors are written
+    /// \param factors the output stream for the encoded factors
+    /// \param index the output stream for the index
+    /// \param interval the minimum distance between two checkpoints
+    /// \param max_window the maximum window length stored for each checkpoint
+    inline FactorStreamIndexOutput(const char_t* text, std::ostream& factors, std::ostream& index, const size_t interval = 1_Mi, const size_t max_window = 64_Ki)
+        : text_(text),
+          stream_(factors),
+          index_(&index),
+          interval_(std::max(interval, size_t(1))),
+          max_window_(max_window),
+          pos_(0),
+          block_min_src_(0),
+          index_bytes_(0),
+          finished_(false) {
+    }
+
+    inline ~FactorStreamIndexOutput() {
+        if(!finished_) finish();
+    }
+
+    FactorStreamIndexOutput(const FactorStreamIndexOutput&) = delete;
+    FactorStreamIndexOutput(FactorStreamIndexOutput&&) = delete;
+    FactorStreamIndexOutput& operator=(const FactorStreamIndexOutput&) = delete;
+    FactorStreamIndexOutput& operator=(FactorStreamIndexOutput&&) = delete;
+
+    void emplace_back(const char_t literal) {
+        begin_factor();
+        stream_.emplace_back(literal);
+        ++pos_;
+    }
+
+    void emplace_back(const index_t src, const index_t len) {
+        begin_factor();
+        block_min_src_ = std::min(block_min_src_, (size_t)src);
+        stream_.emplace_back(src, len);
+        pos_ += len;
+    }
+
+    void emplace_back(const Factor& f) {
+        if(f.is_reference()) {
+            emplace_back(f.src, f.len);
+        } else {
+            emplace_back(f.literal());
+        }
+    }
+
+    /// \brief Completes the index and flushes both outputs.
+    ///
+    /// No more factors may be written afterwards.
+    void finish() {
+        finish_block();
+        write_index(checkpoints_.data(), checkpoints_.size() * sizeof(FactorStreamIndex::Checkpoint));
+
+        const uint64_t trailer[2] = { pos_, checkpoints_.size() };
+        write_index(trailer, sizeof(trailer));
+
+        stream_.flush();
+        index_->flush();
+        finished_ = true;
+    }
+
+    /// \brief The number of bytes of encoded factors written so far.
+    size_t factor_bytes() const {
+        return stream_.bytes_written();
+    }
+
+    /// \brief The number of bytes of the index written so far.
+    size_t index_bytes() const {
+        return index_bytes_;
+    }
+};
+
+}}}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include <tdc/code/vbyte.hpp>
+
+#include "factor.hpp"
+
+namespace tdc {
+namespace comp {
+namespace lz77 {
+
+/// \brief Writes factors to an output stream in a compact byte-aligned format.
+///
+/// Each factor starts with a variable-byte coded header (see \ref code::vbyte_encode).
+/// For a literal \c c, the header is <tt>2c</tt>.
+/// For a reference of length \c len, the header is <tt>2len+1</tt>, followed by the variable-byte coded distance to the source, i.e., the number of characters between the source and the factor's position.
+///
+/// The format can be read using a \ref FactorStreamReader.
+class FactorStreamOutput {
+private:
+    static constexpr size_t MAX_FACTOR_BYTES = 2 * code::VBYTE_MAX_BYTES;
+
+    std::ostream* out_;
+    std::vector<uint8_t> buf_;
+    size_t cursor_;
+    size_t pos_; // current position in the decoded text
+    size_t bytes_written_;
+
+    void ensure_space() {
+        if(cursor_ + MAX_FACTOR_BYTES > buf_.size()) flush();
+    }
+
+public:
+    inline FactorStreamOutput(std::ostream& out, const size_t bufsize = 1ULL << 20)
+        : out_(&out), buf_(std::max(bufsize, MAX_FACTOR_BYTES)), cursor_(0), pos_(0), bytes_written_(0) {
+    }
+
+    inline ~FactorStreamOutput() {
+        flush();
+    }
+
+    FactorStreamOutput(const FactorStreamOutput&) = delete;
+    FactorStreamOutput(FactorStreamOutput&&) = delete;
+    FactorStreamOutput& operator=(const FactorStreamOutput&) = delete;
+    FactorStreamOutput& operator=(FactorStreamOutput&&) = delete;
+
+    void emplace_back(const char_t literal) {
+        ensure_space();
+        cursor_ += code::vbyte_encode(buf_.data() + cursor_, uint64_t(literal) << 1);
+        ++pos_;
+    }
+
+    void emplace_back(const index_t src, const index_t len) {
+        assert(src < pos_);
+        ensure_space();
+        cursor_ += code::vbyte_encode(buf_.data() + cursor_, (uint64_t(len) << 1) | 1);
+        cursor_ += code::vbyte_encode(buf_.data() + cursor_, pos_ - src);
+        pos_ += len;
+    }
+
+    void emplace_back(const Factor& f) {
+        if(f.is_reference()) {
+            emplace_back(f.src, f.len);
+        } else {
+            emplace_back(f.literal());
+        }
+    }
+
+    /// \brief Writes all buffered factors to the output stream.
+    void flush() {
+        out_->write((const char*)buf_.data(), cursor_);
+        bytes_written_ += cursor_;
+        cursor_ = 0;
+    }
+
+    /// \brief The total number of bytes written so far, including buffered ones.
+    size_t bytes_written() const {
+        return bytes_written_ + cursor_;
+    }
+};
+
+}}}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include <tdc/code/vbyte.hpp>
+#include <tdc/intrisics/tzcnt.hpp>
+#include <tdc/io/mmap_file.hpp>
+
+#include "factor.hpp"
+
+namespace tdc {
+namespace comp {
+namespace lz77 {
+
+/// \brief Reads factors written by a \ref FactorStreamOutput from memory, e.g., a memory mapped file.
+///
+/// Away from the end of the buffer, the lengths of the header and the distance of a factor are determined from a single 16-byte mask of terminating bytes (\ref code::vbyte_stop_mask),
+/// and both values are then extracted using word operations (\ref code::vbyte_extract).
+/// Near the end of the buffer, or for codes longer than eight bytes, values are decoded one byte at a time.
+class FactorStreamReader {
+private:
+    static constexpr size_t FAST_BYTES = 16;
+
+    const uint8_t* p_;
+    const uint8_t* end_;
+    size_t pos_; // current position in the decoded text
+
+    inline Factor make_factor(const uint64_t header, const uint64_t dist) {
+        const index_t len = header >> 1;
+        assert(dist <= pos_);
+        const Factor f(index_t(pos_ - dist), len);
+        pos_ += len;
+        return f;
+    }
+
+    inline Factor read_slow() {
+        const auto header = code::vbyte_decode(p_);
+        if(!(header & 1)) {
+            ++pos_;
+            return Factor(char_t(header >> 1));
+        }
+        return make_factor(header, code::vbyte_decode(p_));
+    }
+
+public:
+    /// \brief Constructs a reader for the given memory range.
+    /// \param begin the beginning of the encoded factors
+    /// \param end the end of the encoded factors
+    /// \param pos the position in the decoded text of the first factor, e.g., that of a checkpoint (see \ref FactorStreamIndex)
+    inline FactorStreamReader(const void* begin, const void* end, const size_t pos = 0) : p_((const uint8_t*)begin), end_((const uint8_t*)end), pos_(pos) {
+    }
+
+    /// \brief Constructs a reader for a memory mapped file, which must remain mapped while reading.
+    /// \param file the memory mapped file
+    inline FactorStreamReader(const io::MMapReadOnlyFile& file)
+        : FactorStreamReader(file.data(), (const uint8_t*)file.data() + file.size()) {
+    }
+
+    FactorStreamReader(const FactorStreamReader&) = default;
+    FactorStreamReader(FactorStreamReader&&) = default;
+    FactorStreamReader& operator=(const FactorStreamReader&) = default;
+    FactorStreamReader& operator=(FactorStreamReader&&) = default;
+
+    /// \brief Tests whether there are more factors to read.
+    inline operator bool() const {
+        return p_ < end_;
+    }
+
+    /// \brief The position in the decoded text of the next factor.
+    inline size_t pos() const {
+        return pos_;
+    }
+
+    /// \brief Reads the next factor.
+    inline Factor read() {
+        assert(p_ < end_);
+        if(size_t(end_ - p_) >= FAST_BYTES) {
+            const uint32_t stops = code::vbyte_stop_mask(p_);
+            const size_t header_len = stops ? intrisics::tzcnt(stops) + 1 : SIZE_MAX;
+            if(header_len <= 8) {
+                const uint32_t dist_stops = stops >> header_len;
+                const auto header = code::vbyte_decode(p_, header_len);
+                if(!(header & 1)) {
+                    ++pos_;
+                    return Factor(char_t(header >> 1));
+                }
+
+                // at least eight bytes remain readable after a header of up to eight bytes
+                const size_t dist_len = dist_stops ? intrisics::tzcnt(dist_stops) + 1 : SIZE_MAX;
+                const auto dist = (dist_len <= 8) ? code::vbyte_decode(p_, dist_len) : code::vbyte_decode(p_);
+                return make_factor(header, dist);
+            }
+        }
+        return read_slow();
+    }
+};
+
+}}}
@@ -5,10 +5,12 @@
 #include <cstddef>
 #include <cstring>
 #include <iostream>
+#include <stdexcept>
 #include <type_traits>
 
-#include <tdc/io/buffered_reader.hpp>
+#include <tdc/io/async_buffered_reader.hpp>
 #include <tdc/util/index.hpp>
+#include <tdc/util/match_length.hpp>
 
 namespace tdc {
 namespace comp {
@@ -29,13 +31,36 @@ private:
     static constexpr size_t hash_shift_ = 5; // if configured to window_bits_ / min_match_, hash function becomes rolling (but isn't used as such)
     static constexpr size_t min_lookahead_ = max_match_ + min_match_ + 1;
     static constexpr size_t max_dist_ = window_size_ - min_lookahead_;
-    static constexpr size_t max_chain_length_ = 4096; // gzip - 9
-    static constexpr size_t nice_match_ = 258; // gzip - 9
-    static constexpr size_t lazy_match_ = 258; // gzip - 9
-    static constexpr size_t good_match_ = 32; // gzip - 9
     static constexpr size_t good_laziness_ = 4;
     static constexpr size_t too_far_ = 4096;
 
+    struct Config {
+        size_t good_match;
+        size_t lazy_match;
+        size_t nice_match;
+        size_t max_chain_length;
+    };
+
+    // gzip's configuration table for levels 1 to 9
+    // levels 1 to 3 use a greedy strategy in gzip, here they are run with lazy matching using the same limits
+    static constexpr Config config_[] = {
+        {  4,   4,   8,    4 },
+        {  4,   5,  16,    8 },
+        {  4,   6,  32,   32 },
+        {  4,   4,  16,   16 },
+        {  8,  16,  32,   32 },
+        {  8,  16, 128,  128 },
+        {  8,  32, 128,  256 },
+        { 32, 128, 258, 1024 },
+        { 32, 258, 258, 4096 },
+    };
+
+    size_t level_;
+    size_t max_chain_length_;
+    size_t nice_match_;
+    size_t lazy_match_;
+    size_t good_match_;
+
     using window_index_t = std::conditional<window_bits_ <= 15, uint16_t, uint32_t>::type;
     static constexpr index_t NIL = 0;
 
@@ -121,33 +146,15 @@ private:
                         if constexpr(track_stats_) ++stat_match_ops_;
 
                         // prepare match
-                        const uint8_t* p = match_begin;
                         const uint8_t* q = buf_ + src;
-                        assert(q < p);
+                        assert(q < match_begin);
 
                         // if first two characters don't match OR we cannot become better, then don't even bother
                         if(prefix == *(const uint16_t*)q && suffix == *(const uint16_t*)(q + match_length_ - 1)) {
-                            // already matched first two, so skipping the first two by using the += operator below is safe
+                            // already matched first two, compare the rest word by word
                             // the next bytes up to min_match_ must also match because we are in the corresponding hash chain
-                            ++p;
-                            ++q;
-
-                            // there are at most 256 bytes left to match
-                            // we only test for crossing the boundary every 8 bytes
-                            static_assert((max_match_ - 2) % 8 == 0, "the funny tricks only work for max_match_ = 8k + 2 for some k");
-
-                            while(
-                                *(const uint16_t*)(p+=2) == *(const uint16_t*)(q+=2) &&
-                                *(const uint16_t*)(p+=2) == *(const uint16_t*)(q+=2) &&
-                                *(const uint16_t*)(p+=2) == *(const uint16_t*)(q+=2) &&
-                                *(const uint16_t*)(p+=2) == *(const uint16_t*)(q+=2) &&
-                                p + 1 < match_end
-                            );
-
-                            if(p < match_end && *p == *q) ++p; // final comparison
-
-                            //const size_t length = std::min((size_t)(p - match_begin), max_match_);
-                            const size_t length = (size_t)(p - match_begin);
+                            const size_t max_length = (size_t)(match_end - match_begin);
+                            const size_t length = 2 + match_length(match_begin + 2, q + 2, max_length - 2);
 
                             // check match
                             if(length > match_length_) {
@@ -211,7 +218,19 @@ private:
     }
 
 public:
-    inline GZip() {
+    /// \brief Constructs a compressor using gzip's matching parameters for the given compression level.
+    /// \param level the compression level, ranging from 1 (fastest) to 9 (best)
+    inline GZip(const size_t level = 9) : level_(level) {
+        if(level_ < 1 || level_ > 9) {
+            throw std::runtime_error("compression level must be between 1 and 9");
+        }
+
+        const auto& config = config_[level_ - 1];
+        good_match_ = config.good_match;
+        lazy_match_ = config.lazy_match;
+        nice_match_ = config.nice_match;
+        max_chain_length_ = config.max_chain_length;
+
         const size_t bufsize = buf_capacity_ + min_lookahead_;
         buf_ = new uint8_t[bufsize];
         for(size_t i = 0; i < bufsize; i++) buf_[i] = 0;
@@ -231,7 +250,7 @@ public:
     }
 
     template<typename FactorOutput>
-    inline void compress(std::istream& in, FactorOutput& out) {
+    inline void compress(io::InputSource& in, FactorOutput& out) {
         // initialize
         buf_offs_ = 0;
         buf_avail_ = 0;
@@ -259,7 +278,7 @@ public:
         }
 
         // open file
-        io::BufferedReader<uint8_t> reader(in, window_size_);
+        io::AsyncBufferedReader<uint8_t> reader(in, window_size_);
 
         // fill buffer
         buf_avail_ = reader.read(buf_, buf_capacity_);
@@ -311,6 +330,16 @@ public:
             ++buf_pos_;
         }
 
+        // conclude a pending lazy evaluation
+        if(prev_match_exists_ && !hash_only_) {
+            if(match_length_ >= min_match_) {
+                out.emplace_back(match_src_, match_length_);
+                hash_only_ = match_length_ - 1;
+            } else {
+                out.emplace_back(buf_[buf_pos_ - 1]);
+            }
+        }
+
         // emit remaining literals
         while(buf_pos_ < buf_avail_) {
             if(hash_only_) {
@@ -324,8 +353,15 @@ public:
         }
     }
 
+    template<typename FactorOutput>
+    inline void compress(std::istream& in, FactorOutput& out) {
+        io::InputSource src(in);
+        compress(src, out);
+    }
+
     template<typename StatLogger>
     void log_stats(StatLogger& logger) {
+        logger.log("level", level_);
         if constexpr(track_stats_) {
             logger.log("chain_max", stat_chain_length_max_);
             logger.log("chain_avg", (double)stat_chain_length_total_ / (double)stat_chain_num_);
@@ -0,0 +1,315 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <tdc/code/delta_coder.hpp>
+#include <tdc/code/rice_coder.hpp>
+#include <tdc/io/input_source.hpp>
+#include <tdc/uint/uint40.hpp>
+#include <tdc/util/char.hpp>
+#include <tdc/util/index.hpp>
+#include <tdc/util/literals.hpp>
+#include <tdc/util/match_length.hpp>
+#include <tdc/util/psv_nsv.hpp>
+#include <tdc/util/sa_backend.hpp>
+
+namespace tdc {
+namespace comp {
+namespace lz77 {
+
+/// \brief Computes an LZ77 parse of minimum encoded size using a cost model given by coders.
+///
+/// Each factor is encoded using a flag bit followed by either the literal or the reference's distance and length.
+/// The distances and lengths are encoded using the given coders, whose code lengths define the cost of a reference.
+/// Literals are assumed to be entropy coded, so their cost is estimated from the literal frequencies of the previous iteration (initially, those of the whole text).
+///
+/// The parse is a shortest path in the DAG whose nodes are the text positions and whose edges are the literals and candidate references.
+/// Candidates at each position are taken from the suffix array, namely the previous and next smaller values (see \ref psv_nsv),
+/// which yield the longest previous factor, and from hash chains over a window, which yield closer but possibly shorter sources.
+/// For each candidate source, references of every length up to the \c nice length are considered, and longer references only with their maximum length.
+///
+/// \tparam dist_coder_t the coder used for reference distances
+/// \tparam len_coder_t the coder used for reference lengths
+template<typename dist_coder_t = code::DeltaCoder, typename len_coder_t = code::RiceCoder>
+class LZ77Optimal {
+private:
+    static constexpr size_t HASH_BITS = 16;
+    static constexpr uint64_t COST_SCALE = 256; // costs are fixed-point numbers of bits
+    static constexpr uint64_t COST_MAX = std::numeric_limits<uint64_t>::max();
+
+    struct Candidate {
+        size_t dist;
+        size_t len;
+    };
+
+    dist_coder_t m_dist_coder;
+    len_coder_t m_len_coder;
+
+    size_t m_window;
+    size_t m_max_chain;
+    size_t m_nice;
+    size_t m_iterations;
+    size_t m_min_len;
+
+    // stats
+    size_t m_sa_bits;
+    size_t m_num_edges;
+    uint64_t m_cost;
+
+    inline uint64_t reference_cost(const size_t dist, const size_t len) const {
+        return COST_SCALE * (1 + m_dist_coder.encoded_length(dist) + m_len_coder.encoded_length(len));
+    }
+
+    // estimates the cost of each literal from its frequency, using add-one smoothing
+    static void literal_costs(const std::vector<size_t>& freq, uint64_t* cost) {
+        size_t total = 0;
+        for(size_t c = 0; c < freq.size(); c++) total += freq[c] + 1;
+
+        for(size_t c = 0; c < freq.size(); c++) {
+            const double bits = 1.0 + std::log2((double)total / (double)(freq[c] + 1));
+            cost[c] = (uint64_t)std::llround(bits * COST_SCALE);
+        }
+    }
+
+    template<typename sa_t, typename idx_t, typename FactorOutput>
+    void factorize(const char_t* text, const size_t n, FactorOutput& out) {
+        static_assert(sizeof(char_t) == 1, "LZ77Optimal requires one-byte characters");
+
+        idx_t* psv = new idx_t[n];
+        idx_t* nsv = new idx_t[n];
+
+        {
+            sa_t* sa = new sa_t[n];
+            sa_backend::suffix_array(text, n, sa);
+            tdc::psv_nsv(sa, n, psv, nsv);
+            delete[] sa;
+        }
+
+        std::vector<uint64_t> cost(n + 1);
+        std::vector<index_t> from_len(n + 1);  // length of the factor ending at a position in the shortest path, zero for literals
+        std::vector<index_t> from_dist(n + 1); // distance of the reference ending at a position in the shortest path
+
+        // hash chains
+        const size_t window_mask = std::max(m_window, size_t(1)) - 1;
+        std::vector<size_t> head(1ULL << HASH_BITS);
+        std::vector<size_t> prev(window_mask + 1);
+        auto hash = [&](const size_t i){
+            const uint64_t key = (uint64_t)text[i] << 16 | (uint64_t)text[i+1] << 8 | (uint64_t)text[i+2];
+            return (key * 0x9E3779B97F4A7C15ULL) >> (64 - HASH_BITS);
+        };
+
+        std::vector<Candidate> candidates;
+        candidates.reserve(m_max_chain + 2);
+
+        // initial literal statistics
+        std::vector<size_t> freq(256, 0);
+        for(size_t i = 0; i < n; i++) ++freq[text[i]];
+        uint64_t lit_cost[256];
+
+        for(size_t iteration = 0; iteration < m_iterations; iteration++) {
+            literal_costs(freq, lit_cost);
+
+            std::fill(cost.begin(), cost.end(), COST_MAX);
+            cost[0] = 0;
+            std::fill(head.begin(), head.end(), SIZE_MAX);
+            m_num_edges = 0;
+
+            size_t psv_lcp = 0;
+            size_t nsv_lcp = 0;
+            for(size_t i = 0; i < n; i++) {
+                const size_t max = n - i;
+                assert(cost[i] < COST_MAX);
+
+                // literal edge
+                {
+                    const auto c = cost[i] + lit_cost[text[i]];
+                    if(c < cost[i+1]) {
+                        cost[i+1] = c;
+                        from_len[i+1] = 0;
+                    }
+                    ++m_num_edges;
+                }
+
+                candidates.clear();
+
+                // suffix array candidates -- as with the PLCP array, their LCP with position i is at least the previous one minus one
+                {
+                    const size_t p = (size_t)psv[i];
+                    psv_lcp = (p < n) ? psv_lcp + match_length(text + i + psv_lcp, text + p + psv_lcp, max - psv_lcp) : 0;
+                    if(psv_lcp >= m_min_len) candidates.push_back(Candidate { i - p, psv_lcp });
+
+                    const size_t q = (size_t)nsv[i];
+                    nsv_lcp = (q < n) ? nsv_lcp + match_length(text + i + nsv_lcp, text + q + nsv_lcp, max - nsv_lcp) : 0;
+                    if(nsv_lcp >= m_min_len) candidates.push_back(Candidate { i - q, nsv_lcp });
+                }
+
+                // hash chain candidates, in order of increasing distance
+                if(m_window > 0 && max >= 3) {
+                    const auto h = hash(i);
+                    size_t best = 0;
+                    size_t j = head[h];
+                    for(size_t k = 0; k < m_max_chain && j != SIZE_MAX && i - j <= m_window; k++) {
+                        const size_t l = match_length(text + i, text + j, std::min(max, m_nice));
+                        if(l > best) {
+                            best = l;
+                            if(l >= m_min_len) candidates.push_back(Candidate { i - j, l });
+                            if(l >= m_nice) break;
+                        }
+                        const size_t next = prev[j & window_mask];
+                        if(next == SIZE_MAX || next >= j) break;
+                        j = next;
+                    }
+                    prev[i & window_mask] = head[h];
+                    head[h] = i;
+                }
+
+                // reference edges -- for each length, use the closest candidate
+                std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b){
+                    return a.dist < b.dist || (a.dist == b.dist && a.len > b.len);
+                });
+
+                size_t covered = m_min_len - 1;
+                for(const auto& cand : candidates) {
+                    if(cand.len <= covered) continue;
+
+                    auto relax = [&](const size_t len){
+                        const auto c = cost[i] + reference_cost(cand.dist, len);
+                        if(c < cost[i+len]) {
+                            cost[i+len] = c;
+                            from_len[i+len] = len;
+                            from_dist[i+len] = cand.dist;
+                        }
+                        ++m_num_edges;
+                    };
+
+                    const size_t last = std::min(cand.len, m_nice);
+                    for(size_t len = covered + 1; len <= last; len++) relax(len);
+                    if(cand.len > last) relax(cand.len);
+                    covered = cand.len;
+                }
+
+                psv_lcp = psv_lcp > 0 ? psv_lcp - 1 : 0;
+                nsv_lcp = nsv_lcp > 0 ? nsv_lcp - 1 : 0;
+            }
+            m_cost = cost[n];
+
+            // trace back shortest path, reversing the links so the path can be traversed forwards
+            {
+                size_t i = n;
+                size_t next_len = 0;
+                size_t next_dist = 0;
+                while(i > 0) {
+                    const size_t len = from_len[i];
+                    const size_t dist = from_dist[i];
+                    from_len[i] = next_len;
+                    from_dist[i] = next_dist;
+                    next_len = len;
+                    next_dist = dist;
+                    i -= std::max(len, size_t(1));
+                }
+                from_len[0] = next_len;
+                from_dist[0] = next_dist;
+            }
+
+            // literal statistics for the next iteration
+            std::fill(freq.begin(), freq.end(), 0);
+            for(size_t i = 0; i < n;) {
+                const size_t len = from_len[i];
+                if(len == 0) ++freq[text[i]];
+                i += std::max(len, size_t(1));
+            }
+
+            // output only the final parse
+            if(iteration + 1 < m_iterations) continue;
+
+            // output
+            for(size_t i = 0; i < n;) {
+                const size_t len = from_len[i];
+                if(len > 0) {
+                    out.emplace_back(i - (size_t)from_dist[i], len);
+                    i += len;
+                } else {
+                    out.emplace_back(text[i]);
+                    ++i;
+                }
+            }
+        }
+
+        delete[] nsv;
+        delete[] psv;
+    }
+
+public:
+    /// \brief Constructs an optimal parser.
+    /// \param dist_coder the coder used for reference distances
+    /// \param len_coder the coder used for reference lengths
+    /// \param window the window for hash chain candidates, must be a power of two (or zero to disable hash chains)
+    /// \param max_chain the maximum number of hash chain entries to consider per position
+    /// \param nice the maximum reference length for which shorter lengths are also considered
+    /// \param iterations the number of iterations, each of which refines the literal costs
+    /// \param min_len the minimum reference length
+    LZ77Optimal(dist_coder_t dist_coder, len_coder_t len_coder, const size_t window = 64_Ki, const size_t max_chain = 16, const size_t nice = 64, const size_t iterations = 2, const size_t min_len = 2)
+        : m_dist_coder(dist_coder),
+          m_len_coder(len_coder),
+          m_window(window),
+          m_max_chain(max_chain),
+          m_nice(std::max(nice, min_len)),
+          m_iterations(std::max(iterations, size_t(1))),
+          m_min_len(std::max(min_len, size_t(1))),
+          m_sa_bits(0),
+          m_num_edges(0),
+          m_cost(0) {
+
+        if(m_window & (m_window - 1)) {
+            throw std::runtime_error("window size must be a power of two");
+        }
+    }
+
+    /// \brief Factorizes the given text.
+    ///
+    /// Texts shorter than 2 GiB are processed using 32-bit suffix arrays, larger texts use 64-bit suffix arrays.
+    template<typename FactorOutput>
+    void compress(const char_t* text, const size_t n, FactorOutput& out) {
+        if(n <= (size_t)std::numeric_limits<saidx_t>::max()) {
+            m_sa_bits = 32;
+            factorize<saidx_t, uint32_t>(text, n, out);
+        } else {
+            m_sa_bits = 64;
+            factorize<saidx64_t, uint40_t>(text, n, out);
+        }
+    }
+
+    /// \brief Factorizes the remaining input, which is not copied if it is memory backed (e.g., a memory mapped file).
+    template<typename FactorOutput>
+    void compress(io::InputSource& in, FactorOutput& out) {
+        const auto text = in.all();
+        compress((const char_t*)text.data(), text.size() / sizeof(char_t), out);
+    }
+
+    template<typename FactorOutput>
+    void compress(std::istream& in, FactorOutput& out) {
+        io::InputSource src(in);
+        compress(src, out);
+    }
+
+    template<typename StatLogger>
+    void log_stats(StatLogger& logger) {
+        logger.log("sa_bits", m_sa_bits);
+        logger.log("window", m_window);
+        logger.log("max_chain", m_max_chain);
+        logger.log("nice", m_nice);
+        logger.log("iterations", m_iterations);
+        logger.log("num_edges", m_num_edges);
+        logger.log("est_bits", m_cost / COST_SCALE);
+    }
+};
+
+}}} // namespace tdc::comp::lz77
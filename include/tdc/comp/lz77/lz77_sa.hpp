@@ -3,12 +3,23 @@
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
 #include <sstream>
+#include <stdexcept>
+#include <string>
 
-#include <divsufsort.h>
+#include <unistd.h>
 
-#include <tdc/util/lcp.hpp>
+#include <tdc/io/input_source.hpp>
+#include <tdc/uint/uint40.hpp>
+#include <tdc/util/char.hpp>
 #include <tdc/util/literals.hpp>
+#include <tdc/util/match_length.hpp>
+#include <tdc/util/psv_nsv.hpp>
+#include <tdc/util/sa_backend.hpp>
+#include <tdc/vec/storage.hpp>
 
 namespace tdc {
 namespace comp {
@@ -17,95 +28,120 @@ namespace lz77 {
 class LZ77SA {
 private:
     size_t m_threshold;
+    std::string m_work_dir;
+    size_t m_mem_limit;
 
-public:
-    LZ77SA(size_t threshold = 2) : m_threshold(threshold) {
+    size_t m_sa_bits;
+    bool m_file_backed;
+
+    // allocates a working array, either on the heap or in an anonymous file in the working directory
+    template<typename T>
+    vec::VectorStorage<T> allocate(const size_t n, const char* name) const {
+        if(m_file_backed) {
+            const std::filesystem::path dir = m_work_dir.empty() ? std::filesystem::temp_directory_path() : std::filesystem::path(m_work_dir);
+            std::ostringstream filename;
+            filename << "tdc-lz77sa-" << ::getpid() << "-" << (const void*)this << "." << name;
+
+            vec::FileStorage storage;
+            storage.filename = (dir / filename.str()).string();
+            return vec::VectorStorage<T>(n, storage);
+        } else {
+            return vec::VectorStorage<T>(n, false);
+        }
     }
 
-    template<typename FactorOutput>
-    void compress(std::istream& in, FactorOutput& out) {
-        // read input fully
-        std::string text(std::istreambuf_iterator<char>(in), {});
-        text.push_back(0); // append sentinel
-        
-        // construct suffix and LCP array
-        const size_t n = text.length();
-        
-        auto* sa = new saidx_t[n];
-        
-        auto result = divsufsort((const sauchar_t*)text.data(), sa, (saidx_t)n);
-        
-        auto* lcp = new saidx_t[n];
-        auto* isa = new saidx_t[n];
-
-        lcp_kasai(text.data(), n, sa, lcp, isa); // we're using ISA as a working array here, it won't actually contain the ISA after this
-        
-        // construct ISA
-        for(size_t i = 0; i < n; i++) {
-            isa[sa[i]] = i;
+    // computes the greedy parse using the PSV/NSV arrays, which replace the LCP array and ISA (Kärkkäinen, Kempa and Puglisi, 2013)
+    // sa_t is the suffix array entry type, idx_t is used to store the PSV/NSV arrays
+    template<typename sa_t, typename idx_t, typename FactorOutput>
+    void factorize(const char_t* text, const size_t n, FactorOutput& out) {
+        m_file_backed = n * (sizeof(sa_t) + 2 * sizeof(idx_t)) > m_mem_limit;
+
+        auto psv_storage = allocate<idx_t>(n, "psv");
+        auto nsv_storage = allocate<idx_t>(n, "nsv");
+        idx_t* psv = psv_storage.data();
+        idx_t* nsv = nsv_storage.data();
+
+        {
+            auto sa = allocate<sa_t>(n, "sa");
+            sa_backend::suffix_array(text, n, sa.data());
+            tdc::psv_nsv(sa.data(), n, psv, nsv);
         }
-        
-        // factorize
-        for(size_t i = 0; i + 1 < n;) {
-            // get SA position for suffix i
-            const size_t cur_pos = isa[i];
-            // assert(cur_pos > 0); // isa[i] == 0 <=> T[i] = 0
-
-            // compute naively PSV
-            // search "upwards" in LCP array
-            // include current, exclude last
-            size_t psv_lcp = lcp[cur_pos];
-            ssize_t psv_pos = cur_pos - 1;
-            if (psv_lcp > 0) {
-                while (psv_pos >= 0 && sa[psv_pos] > sa[cur_pos]) {
-                    psv_lcp = std::min<size_t>(psv_lcp, lcp[psv_pos--]);
-                }
-            }
 
-            // compute naively NSV
-            // search "downwards" in LCP array
-            // exclude current, include last
-            size_t nsv_lcp = 0;
-            size_t nsv_pos = cur_pos + 1;
-            if (nsv_pos < n) {
-                nsv_lcp = SIZE_MAX;
-                do {
-                    nsv_lcp = std::min<size_t>(nsv_lcp, lcp[nsv_pos]);
-                    if (sa[nsv_pos] < sa[cur_pos]) {
-                        break;
-                    }
-                } while (++nsv_pos < n);
-
-                if (nsv_pos >= n) {
-                    nsv_lcp = 0;
-                }
-            }
+        for(size_t i = 0; i < n;) {
+            // compute LCPs with both candidates directly, costing at most the factor length
+            const size_t max = n - i;
+
+            const size_t psv_pos = (size_t)psv[i];
+            const size_t psv_lcp = (psv_pos < n) ? match_length(text + i, text + psv_pos, max) : 0;
 
-            //select maximum
+            const size_t nsv_pos = (size_t)nsv[i];
+            const size_t nsv_lcp = (nsv_pos < n) ? match_length(text + i, text + nsv_pos, max) : 0;
+
+            // select maximum
             const size_t max_lcp = std::max(psv_lcp, nsv_lcp);
             if(max_lcp >= m_threshold) {
-                const ssize_t max_pos = (max_lcp == psv_lcp) ? psv_pos : nsv_pos;
-                assert(max_pos < n);
-                assert(max_pos >= 0);
-                
+                const size_t max_pos = (max_lcp == psv_lcp) ? psv_pos : nsv_pos;
+                assert(max_pos < i);
+
                 // output reference
                 out.emplace_back(max_pos, max_lcp);
-                i += max_lcp; //advance
+                i += max_lcp;
             } else {
                 // output literal
                 out.emplace_back(text[i]);
-                ++i; //advance
+                ++i;
             }
         }
-        
-        // clean up
-        delete[] isa;
-        delete[] lcp;
-        delete[] sa;
     }
-    
+
+public:
+    /// \brief Constructs the factorizer.
+    ///
+    /// The suffix array and the PSV/NSV arrays are kept on the heap as long as they fit into the given memory limit.
+    /// Otherwise, they are stored in memory mapped files in the working directory, which are removed right after their creation,
+    /// so the kernel can page them in and out as needed. This allows for inputs larger than the memory, but the accesses to the PSV/NSV arrays
+    /// are random, so performance then depends heavily on the page cache.
+    ///
+    /// \param threshold the minimum length of a reference
+    /// \param work_dir the directory for the working files, or empty to use the system's temporary directory
+    /// \param mem_limit the maximum number of bytes of working memory allocated on the heap
+    LZ77SA(size_t threshold = 2, const std::string& work_dir = "", size_t mem_limit = SIZE_MAX)
+        : m_threshold(threshold), m_work_dir(work_dir), m_mem_limit(mem_limit), m_sa_bits(0), m_file_backed(false) {
+    }
+
+    /// \brief Factorizes the given text.
+    ///
+    /// Texts shorter than 2 GiB are processed using 32-bit suffix arrays, larger texts use 64-bit suffix arrays.
+    /// Apart from the text, this requires 12n bytes (32-bit) or 18n bytes (64-bit) of working memory at peak, of which 8n or 10n bytes remain
+    /// during the factorization. If this exceeds the memory limit, the working memory is file-backed.
+    template<typename FactorOutput>
+    void compress(const char_t* text, const size_t n, FactorOutput& out) {
+        if(n <= (size_t)std::numeric_limits<saidx_t>::max()) {
+            m_sa_bits = 32;
+            factorize<saidx_t, uint32_t>(text, n, out);
+        } else {
+            m_sa_bits = 64;
+            factorize<saidx64_t, uint40_t>(text, n, out);
+        }
+    }
+
+    /// \brief Factorizes the remaining input, which is not copied if it is memory backed (e.g., a memory mapped file).
+    template<typename FactorOutput>
+    void compress(io::InputSource& in, FactorOutput& out) {
+        const auto text = in.all();
+        compress((const char_t*)text.data(), text.size() / sizeof(char_t), out);
+    }
+
+    template<typename FactorOutput>
+    void compress(std::istream& in, FactorOutput& out) {
+        io::InputSource src(in);
+        compress(src, out);
+    }
+
     template<typename StatLogger>
     void log_stats(StatLogger& logger) {
+        logger.log("sa_bits", m_sa_bits);
+        logger.log("file_backed", m_file_backed);
     }
 };
 
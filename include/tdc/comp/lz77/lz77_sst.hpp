@@ -0,0 +1,85 @@
+#pragma once
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+#include <tdc/util/char.hpp>
+#include <tdc/util/index.hpp>
+
+#include "sliding_suffix_tree.hpp"
+
+namespace tdc {
+namespace comp {
+namespace lz77 {
+
+/// \brief Greedy LZ77 factorization with a sliding window, using a suffix tree of the window that is updated online.
+///
+/// In contrast to \ref LZ77SlidingWindow, which rebuilds its tries from the suffix array for every block, the window is maintained incrementally (\ref SlidingSuffixTree).
+/// The running time is thus linear in the input length, independent of the window size.
+///
+/// A factor is extended character by character for as long as it is a repeated suffix of the text in the tree, which contains the window and the factor itself.
+/// Sources may therefore overlap with the factor. Factors are limited to the window size.
+class LZ77SlidingSuffixTree {
+private:
+    index_t m_window;
+    size_t m_max_inner_nodes;
+
+public:
+    LZ77SlidingSuffixTree(const index_t window) : m_window(window), m_max_inner_nodes(0) {
+        if(m_window == 0 || m_window >= SlidingSuffixTree::NONE / 8) {
+            throw std::runtime_error("invalid window size");
+        }
+    }
+
+    template<typename FactorOutput>
+    void compress(io::InputSource& in, FactorOutput& out) {
+        // the tree contains the window and the current factor
+        SlidingSuffixTree tree(2 * m_window);
+
+        index_t i = 0;
+        while(true) {
+            tree.shrink(i > m_window ? i - m_window : 0);
+
+            // extend the factor as long as it occurs earlier
+            index_t src = 0;
+            index_t len = 0;
+            while(len < m_window) {
+                if(tree.front() == i + len) {
+                    if(tree.lookahead() == 0 && !in.eof()) tree.read(in);
+                    if(tree.lookahead() == 0) break;
+                    tree.advance();
+                }
+
+                if(tree.repeat_length() <= len) break;
+                ++len;
+                src = tree.repeat_source() + tree.repeat_length() - len;
+            }
+
+            if(tree.front() == i) break; // end of input
+
+            if(len > 1) {
+                out.emplace_back(src, len);
+                i += len;
+            } else {
+                out.emplace_back(tree[i]);
+                ++i;
+            }
+            m_max_inner_nodes = std::max(m_max_inner_nodes, tree.num_inner_nodes());
+        }
+    }
+
+    template<typename FactorOutput>
+    void compress(std::istream& in, FactorOutput& out) {
+        io::InputSource src(in);
+        compress(src, out);
+    }
+
+    template<typename StatLogger>
+    void log_stats(StatLogger& logger) {
+        logger.log("window", m_window);
+        logger.log("max_inner_nodes", m_max_inner_nodes);
+    }
+};
+
+}}} // namespace tdc::comp::lz77
@@ -8,9 +8,11 @@
 #include <stdexcept>
 #include <vector>
 
+#include <tdc/io/input_source.hpp>
 #include <tdc/util/char.hpp>
 #include <tdc/util/index.hpp>
 #include <tdc/util/literals.hpp>
+#include <tdc/util/match_length.hpp>
 
 #include "long_term_trie.hpp"
 #include "sliding_window_trie.hpp"
@@ -47,7 +49,7 @@ public:
     }
 
     template<typename FactorOutput>
-    void compress(std::istream& in, FactorOutput& out) {
+    void compress(io::InputSource& in, FactorOutput& out) {
         index_t window_offset = 0;
         
         const auto bufsize = 2 * m_window;
@@ -78,10 +80,9 @@ public:
         size_t ext_len = 0;        // the current extended match length
         
         // read initial 2w characters
-        if(in) {
+        if(!in.eof()) {
             left_trie = &sw_tries[0]; // empty
-            in.read((char*)buffer, bufsize);
-            const auto r = in.gcount();
+            const auto r = in.read(buffer, bufsize);
             if(r > 0) {
                 buffer[r] = (char_t)0; // terminate
                 right_trie = &sw_tries[1];
@@ -93,7 +94,7 @@ public:
             }
         }
         
-        while(i < n || in) {
+        while(i < n || !in.eof()) {
             if constexpr(verbose) std::cout << "i=" << i << std::endl;
             if(i / m_window > b) {
                 // entering new block
@@ -124,9 +125,8 @@ public:
                     char_t* rbuffer = buffer + last_block_len;
                     
                     size_t r;
-                    if(in) {
-                        in.read((char*)rbuffer, m_window);
-                        r = in.gcount();
+                    if(!in.eof()) {
+                        r = in.read(rbuffer, m_window);
                     } else {
                         r = 0;
                     }
@@ -146,18 +146,31 @@ public:
             if constexpr(m_allow_ext_match) {
                 if(ext_match) {
                     if constexpr(verbose) std::cout << "\tcontinuing extended match" << std::endl;
-                    
-                    const auto c = buffer[i - window_start];
-                    const size_t j = ext_src + ext_len;
-                    assert(j < i);
-                    assert(j >= prev_window_start);
-                    const auto x = (j >= window_start) ? buffer[j - window_start] : prev_buffer[j - prev_window_start];
-                    
-                    if constexpr(verbose) std::cout << "\tread \"" << c << "\", compare against \"" << x << "\"" << std::endl;
-                    if(c == x) {
-                        if constexpr(verbose) std::cout << "\tcontinuing extended match" << std::endl;
-                        ++ext_len;
-                        ++i;
+
+                    // extend as far as possible within the current block
+                    const size_t limit = std::min(n, window_start + m_window);
+                    while(i < limit) {
+                        const size_t j = ext_src + ext_len;
+                        assert(j < i);
+                        assert(j >= prev_window_start);
+
+                        size_t max = limit - i;
+                        const char_t* x;
+                        if(j >= window_start) {
+                            x = buffer + (j - window_start);
+                        } else {
+                            x = prev_buffer + (j - prev_window_start);
+                            max = std::min(max, window_start - j);
+                        }
+
+                        const size_t l = match_length(x, buffer + (i - window_start), max);
+                        ext_len += l;
+                        i += l;
+                        if(l < max) break; // mismatch
+                    }
+
+                    if(i >= limit) {
+                        // reached the end of the block without a mismatch
                         continue;
                     } else {
                         if constexpr(verbose) std::cout << "\tconcluding extended match" << std::endl;
@@ -304,6 +317,12 @@ public:
         if constexpr(m_allow_ext_match) delete[] prev_buffer;
     }
 
+    template<typename FactorOutput>
+    void compress(std::istream& in, FactorOutput& out) {
+        io::InputSource src(in);
+        compress(src, out);
+    }
+
     template<typename StatLogger>
     void log_stats(StatLogger& logger) {
         logger.log("window", m_window);
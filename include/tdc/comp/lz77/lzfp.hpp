@@ -10,7 +10,7 @@
 
 #include <robin_hood.h>
 
-#include <tdc/io/buffered_reader.hpp>
+#include <tdc/io/async_buffered_reader.hpp>
 #include <tdc/hash/rolling.hpp>
 #include <tdc/util/char.hpp>
 #include <tdc/util/index.hpp>
@@ -125,7 +125,7 @@ public:
     }
 
     template<typename FactorOutput>
-    inline void compress(std::istream& in, FactorOutput& out) {
+    inline void compress(io::InputSource& in, FactorOutput& out) {
         // init
         next_factor_ = 0;
         pos_ = 0;
@@ -134,7 +134,7 @@ public:
 
         // read
         {
-            io::BufferedReader<char_t> reader(in, w);
+            io::AsyncBufferedReader<char_t> reader(in, w);
 
             // prepare initial window
             {
@@ -161,6 +161,12 @@ public:
         }
     }
     
+    template<typename FactorOutput>
+    inline void compress(std::istream& in, FactorOutput& out) {
+        io::InputSource src(in);
+        compress(src, out);
+    }
+
     template<typename StatLogger>
     void log_stats(StatLogger& logger) {
         logger.log("tau_min", tau_min_);
@@ -4,7 +4,7 @@
 
 #include <robin_hood.h>
 
-#include <tdc/io/buffered_reader.hpp>
+#include <tdc/io/async_buffered_reader.hpp>
 #include <tdc/hash/rolling.hpp>
 #include <tdc/util/augmented_sketch.hpp>
 #include <tdc/util/char.hpp>
@@ -138,7 +138,7 @@ public:
     }
 
     template<typename FactorOutput>
-    inline void compress(std::istream& in, FactorOutput& out) {
+    inline void compress(io::InputSource& in, FactorOutput& out) {
         // init
         next_factor_ = 0;
         pos_ = 0;
@@ -147,7 +147,7 @@ public:
 
         // read
         {
-            io::BufferedReader<char_t> reader(in, max_filter_size_);
+            io::AsyncBufferedReader<char_t> reader(in, max_filter_size_);
 
             // prepare initial window
             {
@@ -174,6 +174,12 @@ public:
         }
     }
     
+    template<typename FactorOutput>
+    inline void compress(std::istream& in, FactorOutput& out) {
+        io::InputSource src(in);
+        compress(src, out);
+    }
+
     template<typename StatLogger>
     void log_stats(StatLogger& logger) {
         logger.log("tau_min", tau_min_);
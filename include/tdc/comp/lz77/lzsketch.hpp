@@ -12,7 +12,7 @@
 #include <random>
 #include <vector>
 
-#include <tdc/io/buffered_reader.hpp>
+#include <tdc/io/async_buffered_reader.hpp>
 #include <tdc/math/bit_mask.hpp>
 #include <tdc/math/ilog2.hpp>
 #include <tdc/random/seed.hpp>
@@ -751,7 +751,7 @@ public:
     }
 
     template<typename FactorOutput>
-    void compress(std::istream& in, FactorOutput& out) {
+    void compress(io::InputSource& in, FactorOutput& out) {
         // init
         size_t read  = 0;
         pos_         = 0;
@@ -760,7 +760,7 @@ public:
 
         // read
         {
-            io::BufferedReader<char_t> reader(in, 1_Mi);
+            io::AsyncBufferedReader<char_t> reader(in, 1_Mi);
 
             // read first q-1 characters
             for(size_t i = 0; i < q_ - 1; i++) {
@@ -799,6 +799,12 @@ public:
         }
     }
 
+    template<typename FactorOutput>
+    void compress(std::istream& in, FactorOutput& out) {
+        io::InputSource src(in);
+        compress(src, out);
+    }
+
     template<typename StatLogger>
     void log_stats(StatLogger& logger) {
         trie_.log_stats(logger);
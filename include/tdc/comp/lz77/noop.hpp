@@ -1,5 +1,6 @@
 #pragma once
 
+#include <tdc/io/input_source.hpp>
 #include <tdc/util/literals.hpp>
 
 #include "factor_buffer.hpp"
@@ -14,20 +15,19 @@ public:
     }
 
     template<typename FactorOutput>
-    void compress(std::istream& in, FactorOutput& out) {
+    void compress(io::InputSource& in, FactorOutput& out) {
         // simply echo input
-        constexpr size_t bufsize = 1_Mi;
-        char* buffer = new char[bufsize];
-        bool b;
-        do {
-            b = (bool)in.read(buffer, bufsize);
-            const size_t num = in.gcount();
-            for(size_t i = 0; i < num; i++) {
-                
-                out.emplace_back((char_t)buffer[i]);
+        for(auto chunk = in.next(); chunk.size() > 0; chunk = in.next()) {
+            for(const char c : chunk) {
+                out.emplace_back((char_t)c);
             }
-        } while(b);
-        delete[] buffer;
+        }
+    }
+
+    template<typename FactorOutput>
+    void compress(std::istream& in, FactorOutput& out) {
+        io::InputSource src(in);
+        compress(src, out);
     }
     
     template<typename StatLogger>
@@ -0,0 +1,389 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include <tdc/io/input_source.hpp>
+#include <tdc/util/char.hpp>
+#include <tdc/util/index.hpp>
+
+namespace tdc {
+namespace comp {
+namespace lz77 {
+
+/// \brief A suffix tree over a sliding window of the input that is maintained online.
+///
+/// Characters are appended using Ukkonen's algorithm, and the longest suffixes can be deleted from the front as proposed by Larsson.
+/// Both take amortized constant time per character, so maintaining the tree takes linear time in the input length regardless of the window size.
+///
+/// Ukkonen's active point is the longest suffix of the text in the tree that also occurs earlier, which is what a greedy LZ77 parser needs to know.
+/// For reporting an earlier occurrence, every node stores the starting position of a suffix in its subtree.
+/// These are kept up to date by pointing each inner node to a representative child, and when the representative leaf of a node is deleted, a new representative is picked among its children.
+///
+/// The text is kept in a ring buffer that holds the tree's text and a lookahead of at least the same size.
+class SlidingSuffixTree {
+public:
+    using node_t = uint32_t;
+    static constexpr node_t NONE = std::numeric_limits<node_t>::max();
+
+private:
+    // text ring buffer
+    std::vector<char_t> m_text;
+    index_t m_text_mask;
+    index_t m_tail;  // first position in the window
+    index_t m_front; // next position to be inserted into the tree
+    index_t m_end;   // end of the text read so far
+
+    // leaves have IDs in [0,m_num_leaf_slots), inner nodes have IDs in [m_num_leaf_slots,m_num_leaf_slots+window]
+    index_t m_num_leaf_slots;
+    node_t m_root;
+
+    std::vector<node_t>  m_parent;
+    std::vector<node_t>  m_first_child;
+    std::vector<node_t>  m_next_sibling;
+    std::vector<char_t>  m_char; // first character on incoming edge
+    std::vector<index_t> m_pos;  // starting position of a suffix in the subtree
+
+    // inner nodes only, indexed by ID minus m_num_leaf_slots
+    std::vector<node_t>  m_depth; // string depth
+    std::vector<node_t>  m_rep;   // representative child, whose position is propagated
+    std::vector<node_t>  m_slink; // suffix link
+    std::vector<node_t>  m_free;  // unused IDs
+
+    // Ukkonen's active point
+    node_t  m_active_node;
+    index_t m_active_edge; // text position of the first character on the active edge
+    index_t m_active_len;
+    index_t m_rem;         // number of suffixes not represented by a leaf
+
+    inline char_t text(const index_t pos) const { return m_text[pos & m_text_mask]; }
+
+    inline bool is_leaf(const node_t v) const { return v < m_num_leaf_slots; }
+    inline node_t leaf(const index_t pos) const { return node_t(pos & (m_num_leaf_slots - 1)); }
+    inline node_t& depth(const node_t v) { return m_depth[v - m_num_leaf_slots]; }
+    inline node_t& rep(const node_t v) { return m_rep[v - m_num_leaf_slots]; }
+    inline node_t& slink(const node_t v) { return m_slink[v - m_num_leaf_slots]; }
+
+    // string depth of a node, where leaves end at the given text position
+    inline index_t depth(const node_t v, const index_t end) {
+        return is_leaf(v) ? end - m_pos[v] : depth(v);
+    }
+
+    inline node_t get_child(const node_t v, const char_t c) const {
+        auto u = m_first_child[v];
+        while(u != NONE && m_char[u] != c) u = m_next_sibling[u];
+        return u;
+    }
+
+    inline void add_child(const node_t v, const node_t u) {
+        m_parent[u] = v;
+        m_next_sibling[u] = m_first_child[v];
+        m_first_child[v] = u;
+    }
+
+    // replaces child u of v by w, where w takes over the incoming edge character of u
+    inline void replace_child(const node_t v, const node_t u, const node_t w) {
+        m_parent[w] = v;
+        m_char[w] = m_char[u];
+        m_next_sibling[w] = m_next_sibling[u];
+        if(m_first_child[v] == u) {
+            m_first_child[v] = w;
+        } else {
+            auto x = m_first_child[v];
+            while(m_next_sibling[x] != u) {
+                x = m_next_sibling[x];
+                assert(x != NONE);
+            }
+            m_next_sibling[x] = w;
+        }
+    }
+
+    inline void remove_child(const node_t v, const node_t u) {
+        if(m_first_child[v] == u) {
+            m_first_child[v] = m_next_sibling[u];
+        } else {
+            auto x = m_first_child[v];
+            while(m_next_sibling[x] != u) {
+                x = m_next_sibling[x];
+                assert(x != NONE);
+            }
+            m_next_sibling[x] = m_next_sibling[u];
+        }
+    }
+
+    inline node_t new_inner(const index_t d) {
+        assert(!m_free.empty());
+        const auto v = m_free.back();
+        m_free.pop_back();
+
+        m_first_child[v] = NONE;
+        depth(v) = d;
+        slink(v) = m_root;
+        return v;
+    }
+
+    inline node_t new_leaf(const index_t pos, const char_t c) {
+        const auto v = leaf(pos);
+        m_first_child[v] = NONE;
+        m_char[v] = c;
+        m_pos[v] = pos;
+        return v;
+    }
+
+    // propagates the position of v upwards along the representative pointers
+    inline void propagate(node_t v) {
+        const auto pos = m_pos[v];
+        while(v != m_root) {
+            const auto u = m_parent[v];
+            if(u == m_root || rep(u) != v || m_pos[u] == pos) break;
+            m_pos[u] = pos;
+            v = u;
+        }
+    }
+
+    // lets inner node v pick the child with the latest position as its representative
+    inline void elect(const node_t v) {
+        auto best = m_first_child[v];
+        for(auto u = m_next_sibling[best]; u != NONE; u = m_next_sibling[u]) {
+            if(m_pos[u] > m_pos[best]) best = u;
+        }
+        rep(v) = best;
+        m_pos[v] = m_pos[best];
+        propagate(v);
+    }
+
+    // walks down from the active node as long as the active point is not on the active edge
+    inline void canonize() {
+        while(m_active_len > 0) {
+            const auto u = get_child(m_active_node, text(m_active_edge));
+            assert(u != NONE);
+            if(is_leaf(u)) break;
+
+            const auto elen = depth(u) - depth(m_active_node);
+            if(m_active_len < elen) break;
+
+            m_active_node = u;
+            m_active_edge += elen;
+            m_active_len -= elen;
+        }
+    }
+
+    // moves the active point to the next shorter suffix after it has become a leaf
+    inline void shorten_active_point(const index_t end) {
+        --m_rem;
+        if(m_active_node == m_root) {
+            if(m_active_len > 0) {
+                --m_active_len;
+                m_active_edge = end - m_rem;
+            }
+        } else {
+            m_active_node = slink(m_active_node);
+        }
+    }
+
+    // removes the longest suffix from the tree
+    void delete_tail() {
+        canonize();
+
+        const auto v = leaf(m_tail);
+        assert(m_pos[v] == m_tail);
+        const auto u = m_parent[v];
+
+        if(m_rem > 0 && m_active_node == u && m_active_len > 0 && get_child(u, text(m_active_edge)) == v) {
+            // the longest implicit suffix ends on the leaf's edge and only occurred at the tail
+            // thus, it becomes the new leaf
+            const auto pos = m_front - m_rem;
+            const auto w = new_leaf(pos, m_char[v]);
+            replace_child(u, v, w);
+            if(u != m_root && rep(u) == v) {
+                rep(u) = w;
+                m_pos[u] = pos;
+                propagate(u);
+            }
+            shorten_active_point(m_front);
+        } else {
+            remove_child(u, v);
+            if(u != m_root && m_next_sibling[m_first_child[u]] == NONE) {
+                // u has only one child left, merge it into its parent edge
+                const auto c = m_first_child[u];
+                const auto g = m_parent[u];
+
+                if(m_active_node == u) {
+                    m_active_node = g;
+                    m_active_len += depth(u) - depth(g);
+                    m_active_edge = m_front - m_rem + depth(g);
+                }
+
+                replace_child(g, u, c);
+                if(g != m_root && rep(g) == u) {
+                    rep(g) = c;
+                    m_pos[g] = m_pos[c];
+                    propagate(g);
+                }
+                m_free.push_back(u);
+            } else if(u != m_root && rep(u) == v) {
+                elect(u);
+            }
+        }
+        ++m_tail;
+    }
+
+    // appends the character at the front to the tree
+    void extend() {
+        const auto end = m_front + 1;
+        const auto c = text(m_front);
+
+        node_t last_new = NONE;
+        ++m_rem;
+        while(m_rem > 0) {
+            if(m_active_len == 0) m_active_edge = m_front;
+
+            const auto u = get_child(m_active_node, text(m_active_edge));
+            if(u == NONE) {
+                // rule 2: new leaf
+                add_child(m_active_node, new_leaf(end - m_rem, c));
+                if(last_new != NONE) {
+                    slink(last_new) = m_active_node;
+                    last_new = NONE;
+                }
+            } else {
+                const auto d = depth(m_active_node);
+                const auto elen = depth(u, end) - d;
+                if(m_active_len >= elen) {
+                    // walk down
+                    m_active_node = u;
+                    m_active_edge += elen;
+                    m_active_len -= elen;
+                    continue;
+                }
+
+                const auto label = m_pos[u] + d;
+                if(text(label + m_active_len) == c) {
+                    // rule 3: suffix is already contained
+                    if(last_new != NONE && m_active_node != m_root) {
+                        slink(last_new) = m_active_node;
+                        last_new = NONE;
+                    }
+                    ++m_active_len;
+                    break;
+                }
+
+                // rule 2: split edge
+                const auto w = new_inner(d + m_active_len);
+                replace_child(m_active_node, u, w);
+                m_char[u] = text(label + m_active_len);
+                add_child(w, u);
+                add_child(w, new_leaf(end - m_rem, c));
+
+                rep(w) = u;
+                m_pos[w] = m_pos[u];
+                if(m_active_node != m_root && rep(m_active_node) == u) rep(m_active_node) = w;
+
+                if(last_new != NONE) slink(last_new) = w;
+                last_new = w;
+            }
+            shorten_active_point(end);
+        }
+        ++m_front;
+    }
+
+public:
+    /// \brief Constructs an empty tree.
+    /// \param capacity the maximum number of characters in the tree at any time
+    SlidingSuffixTree(const index_t capacity) : m_tail(0), m_front(0), m_end(0) {
+        assert(capacity > 0);
+
+        m_num_leaf_slots = 1;
+        while(m_num_leaf_slots < capacity + 1) m_num_leaf_slots <<= 1;
+
+        index_t text_size = 1;
+        while(text_size < 2 * m_num_leaf_slots) text_size <<= 1;
+        m_text.resize(text_size);
+        m_text_mask = text_size - 1;
+
+        const auto num_inner = capacity + 1;
+        const auto num_nodes = m_num_leaf_slots + num_inner;
+        m_parent.resize(num_nodes, NONE);
+        m_first_child.resize(num_nodes, NONE);
+        m_next_sibling.resize(num_nodes, NONE);
+        m_char.resize(num_nodes, 0);
+        m_pos.resize(num_nodes, 0);
+
+        m_depth.resize(num_inner, 0);
+        m_rep.resize(num_inner, NONE);
+        m_slink.resize(num_inner, NONE);
+        m_free.reserve(num_inner);
+        for(index_t i = 0; i < num_inner; i++) {
+            m_free.push_back(node_t(num_nodes - 1 - i));
+        }
+
+        m_root = new_inner(0);
+        m_active_node = m_root;
+        m_active_edge = 0;
+        m_active_len = 0;
+        m_rem = 0;
+    }
+
+    /// \brief Reads as many characters from the input into the lookahead as the buffer can hold.
+    /// \param in the input
+    /// \return the number of characters read
+    size_t read(io::InputSource& in) {
+        size_t total = 0;
+        while(!in.eof()) {
+            const index_t free = m_tail + m_text.size() - m_end;
+            if(free == 0) break;
+
+            const index_t r = m_end & m_text_mask;
+            const size_t num = in.read(m_text.data() + r, std::min(free, index_t(m_text.size()) - r) * sizeof(char_t)) / sizeof(char_t);
+            if(num == 0) break;
+            m_end += num;
+            total += num;
+        }
+        return total;
+    }
+
+    /// \brief The position of the first character in the tree.
+    inline index_t tail() const { return m_tail; }
+
+    /// \brief The position of the next character to be inserted into the tree.
+    inline index_t front() const { return m_front; }
+
+    /// \brief The number of characters read but not yet inserted into the tree.
+    inline index_t lookahead() const { return m_end - m_front; }
+
+    /// \brief Returns the character at the given text position, which must be within the tree or the lookahead.
+    inline char_t operator[](const index_t pos) const { return text(pos); }
+
+    /// \brief The number of inner nodes currently in the tree, including the root.
+    inline size_t num_inner_nodes() const { return m_depth.size() - m_free.size(); }
+
+    /// \brief Inserts the next character from the lookahead into the tree.
+    inline void advance() {
+        assert(m_front < m_end);
+        assert(m_front - m_tail < m_num_leaf_slots);
+        extend();
+    }
+
+    /// \brief Deletes the longest suffixes from the tree until it starts at the given position.
+    inline void shrink(const index_t tail) {
+        assert(tail <= m_front);
+        while(m_tail < tail) delete_tail();
+    }
+
+    /// \brief The length of the longest suffix of the text in the tree that also occurs at an earlier position.
+    inline index_t repeat_length() const { return m_rem; }
+
+    /// \brief The starting position of an earlier occurrence of the longest repeated suffix (see \ref repeat_length).
+    inline index_t repeat_source() {
+        assert(m_rem > 0);
+        canonize();
+        return m_pos[m_active_len > 0 ? get_child(m_active_node, text(m_active_edge)) : m_active_node];
+    }
+};
+
+}}} // namespace tdc::comp::lz77
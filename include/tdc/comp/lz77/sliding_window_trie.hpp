@@ -3,10 +3,8 @@
 #include <cassert>
 #include <vector>
 
-#include <divsufsort.h>
-
-#include <tdc/util/lcp.hpp>
 #include <tdc/util/index.hpp>
+#include <tdc/util/sa_backend.hpp>
 
 namespace tdc {
 namespace comp {
@@ -298,11 +296,11 @@ public:
     void build(const char_t* buffer, const index_t n, const index_t window, saidx_t* sa, saidx_t* lcp, saidx_t* work) {
         // compute suffix and LCP array
         //divsuflcpsort((const sauchar_t*)buffer, sa, lcp, (saidx_t)(n+1)); // nb: BROKEN??
-        divsufsort((const sauchar_t*)buffer, sa, (saidx_t)(n+1));
+        sa_backend::suffix_array(buffer, n+1, sa);
         assert(sa[0] == n);
         assert(buffer[sa[0]] != buffer[sa[1]]); // must have unique terminator
         
-        lcp_kasai(buffer, n+1, sa, lcp, work);
+        sa_backend::lcp_array(buffer, n+1, sa, lcp, work);
         assert(lcp[0] == 0);
         assert(lcp[1] == 0);
         
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "eviction.hpp"
+#include "hash_trie.hpp"
+#include "phrase_table.hpp"
+#include "stats.hpp"
+
+#include <tdc/io/bit_istream.hpp>
+#include <tdc/io/bit_ostream.hpp>
+#include <tdc/io/input_source.hpp>
+#include <tdc/math/ilog2.hpp>
+#include <tdc/util/literals.hpp>
+
+namespace tdc {
+namespace comp {
+namespace lz78 {
+
+/// \brief LZ78 compression with a dictionary of bounded size.
+///
+/// Factors are encoded like in \ref LZ78. Once the dictionary is full, each new phrase replaces a leaf selected by the eviction policy,
+/// so the trie, which is stored in a \ref TrieHashTable, and all bookkeeping are allocated once for the maximum dictionary size.
+/// The output can be decoded using \ref BoundedLZ78Decoder.
+///
+/// \tparam eviction_t the eviction policy, e.g., \ref LRUEviction or \ref LFUEviction
+/// \tparam m_track_stats whether to collect \ref Stats
+template<typename eviction_t, bool m_track_stats = false>
+class BoundedLZ78 {
+private:
+    static constexpr index_t ROOT = 0;
+
+    Stats m_stats;
+
+    size_t m_max_size;
+    size_t m_size;
+
+    TrieHashTable<char> m_table;
+    std::vector<char> m_char;
+    eviction_t m_eviction;
+
+    index_t m_current;
+
+    void add_phrase(const index_t ref, const char c) {
+        m_eviction.use(ref);
+
+        index_t v;
+        if(m_size < m_max_size) {
+            v = (index_t)m_size++;
+            m_char.emplace_back(c);
+        } else {
+            v = m_eviction.evict(ref);
+            if(v == ROOT) return; // nothing can be evicted
+
+            m_table.erase(m_eviction.parent(v), m_char[v]);
+            m_char[v] = c;
+            if constexpr(m_track_stats) ++m_stats.num_evictions;
+        }
+
+        m_table.insert(ref, c, v);
+        m_eviction.insert(v, ref);
+    }
+
+    void process(char c, io::BitOStream& out) {
+        auto child = m_table.find(m_current, c);
+        if(child) {
+            m_current = child;
+        } else {
+            out.write_binary(m_current, math::ilog2_ceil(m_size - 1));
+            out.write_binary((uint8_t)c);
+            if constexpr(m_track_stats) ++m_stats.num_factors;
+
+            add_phrase(m_current, c);
+            m_current = ROOT;
+        }
+    }
+
+public:
+    /// \brief Constructs a compressor.
+    /// \param max_dict_size the maximum number of phrases in the dictionary, including the empty phrase
+    BoundedLZ78(const size_t max_dict_size)
+        : m_max_size(std::max(max_dict_size, size_t(2))),
+          m_size(1),
+          m_table(m_max_size + m_max_size / 3 + 1),
+          m_eviction(m_max_size),
+          m_current(ROOT) {
+
+        m_char.reserve(m_max_size);
+        m_char.emplace_back(0); // root
+    }
+
+    void compress(io::InputSource& in, std::ostream& out) {
+        {
+            io::BitOStream bits(out);
+            for(auto chunk = in.next(); chunk.size() > 0; chunk = in.next()) {
+                for(const char c : chunk) {
+                    process(c, bits);
+                }
+                if constexpr(m_track_stats) m_stats.input_size += chunk.size();
+            }
+
+            // output final factor
+            if(m_current) {
+                bits.write_binary(m_current, math::ilog2_ceil(m_size - 1));
+                if constexpr(m_track_stats) ++m_stats.num_factors;
+            }
+
+            if constexpr(m_track_stats) m_stats.output_bits = bits.bits_written();
+        }
+
+        if constexpr(m_track_stats) m_stats.trie_size = m_size;
+    }
+
+    void compress(std::istream& in, std::ostream& out) {
+        io::InputSource src(in);
+        compress(src, out);
+    }
+
+    const Stats& stats() const { return m_stats; }
+};
+
+/// \brief Decodes the output of \ref BoundedLZ78.
+///
+/// The dictionary is rebuilt in a \ref PhraseTable, replacing the same leaves as the compressor.
+/// The maximum dictionary size and the eviction policy must match those of the compressor.
+///
+/// \tparam eviction_t the eviction policy
+template<typename eviction_t>
+class BoundedLZ78Decoder {
+private:
+    static constexpr index_t ROOT = 0;
+    static constexpr size_t BUFFER_SIZE = 1_Mi;
+
+    size_t m_max_size;
+
+public:
+    /// \brief Constructs a decoder.
+    /// \param max_dict_size the maximum number of phrases in the dictionary, including the empty phrase
+    BoundedLZ78Decoder(const size_t max_dict_size) : m_max_size(std::max(max_dict_size, size_t(2))) {
+    }
+
+    void decompress(std::istream& in, std::ostream& out) {
+        io::BitIStream bits(in);
+        PhraseTable table;
+        eviction_t eviction(m_max_size);
+
+        std::vector<char> buffer;
+        buffer.reserve(BUFFER_SIZE);
+
+        while(!bits.eof()) {
+            const auto ref = bits.read_binary<index_t>(math::ilog2_ceil(table.size() - 1));
+            table.decode(ref, buffer);
+            if(bits.eof()) break; // final factor
+
+            const char c = (char)bits.read_binary<uint8_t>();
+            buffer.emplace_back(c);
+
+            eviction.use(ref);
+            if(table.size() < m_max_size) {
+                eviction.insert(table.insert(ref, c), ref);
+            } else {
+                const auto v = eviction.evict(ref);
+                if(v != ROOT) {
+                    table.replace(v, ref, c);
+                    eviction.insert(v, ref);
+                }
+            }
+
+            if(buffer.size() >= BUFFER_SIZE) {
+                out.write(buffer.data(), buffer.size());
+                buffer.clear();
+            }
+        }
+        out.write(buffer.data(), buffer.size());
+    }
+};
+
+}}}
@@ -0,0 +1,16 @@
+#pragma once
+
+namespace tdc {
+namespace comp {
+namespace lz78 {
+
+/// \brief Determines what happens when an LZ78 or LZW dictionary reaches its maximum size.
+enum class DictionaryPolicy {
+    /// \brief The dictionary is no longer extended, but its phrases can still be referenced.
+    freeze,
+
+    /// \brief The dictionary is discarded and built anew from its initial state.
+    reset
+};
+
+}}}
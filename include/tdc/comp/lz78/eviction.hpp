@@ -0,0 +1,204 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include <tdc/util/index.hpp>
+#include <tdc/util/min_inc.hpp>
+
+namespace tdc {
+namespace comp {
+namespace lz78 {
+
+/// \brief Selects phrases to evict from a bounded LZ78 dictionary in least-recently-used order.
+///
+/// All phrases are kept in a list ordered by their last use. When a phrase is used, it and all its ancestors are moved to the front,
+/// ancestors first. Hence, every phrase is in front of all its descendants and the least recently used phrase is always a leaf.
+class LRUEviction {
+private:
+    static constexpr index_t ROOT = 0;
+    static constexpr index_t NONE = INDEX_MAX;
+
+    std::vector<index_t> m_parent;
+    std::vector<index_t> m_prev;
+    std::vector<index_t> m_next;
+    index_t m_head;
+    index_t m_tail;
+
+    void unlink(const index_t v) {
+        const auto prev = m_prev[v];
+        const auto next = m_next[v];
+        if(prev != NONE) m_next[prev] = next; else m_head = next;
+        if(next != NONE) m_prev[next] = prev; else m_tail = prev;
+    }
+
+    void link_after(const index_t v, const index_t prev) {
+        const auto next = (prev != NONE) ? m_next[prev] : m_head;
+        m_prev[v] = prev;
+        m_next[v] = next;
+        if(prev != NONE) m_next[prev] = v; else m_head = v;
+        if(next != NONE) m_prev[next] = v; else m_tail = v;
+    }
+
+    void ensure(const index_t v) {
+        if(v >= m_parent.size()) {
+            m_parent.resize(v + 1, ROOT);
+            m_prev.resize(v + 1, NONE);
+            m_next.resize(v + 1, NONE);
+        }
+    }
+
+public:
+    /// \brief Constructs the bookkeeping for an empty dictionary.
+    /// \param capacity the maximum number of phrases, including the empty phrase
+    LRUEviction(const size_t capacity = 0) : m_head(NONE), m_tail(NONE) {
+        m_parent.reserve(capacity);
+        m_prev.reserve(capacity);
+        m_next.reserve(capacity);
+        ensure(ROOT);
+    }
+
+    /// \brief The parent of a phrase.
+    index_t parent(const index_t v) const {
+        return m_parent[v];
+    }
+
+    /// \brief Notifies that a phrase has been used as the reference of a factor.
+    /// \param v the phrase
+    void use(index_t v) {
+        // move the path to the front bottom-up, so ancestors end up in front of descendants
+        for(; v != ROOT; v = m_parent[v]) {
+            if(m_head != v) {
+                unlink(v);
+                link_after(v, NONE);
+            }
+        }
+    }
+
+    /// \brief Selects a leaf to evict and removes it.
+    /// \param ref the phrase that is about to be extended, which is never evicted
+    /// \return the evicted phrase, or the root if there is no leaf to evict
+    index_t evict(const index_t ref) {
+        const auto v = m_tail;
+        if(v == NONE || v == ref) return ROOT; // all phrases are ancestors of ref
+        unlink(v);
+        return v;
+    }
+
+    /// \brief Inserts a new leaf after its parent has been used.
+    /// \param v the new phrase
+    /// \param parent the parent phrase
+    void insert(const index_t v, const index_t parent) {
+        ensure(v);
+        m_parent[v] = parent;
+        link_after(v, parent != ROOT ? parent : NONE); // directly behind the parent, in front of its older descendants
+    }
+};
+
+/// \brief Selects phrases to evict from a bounded LZ78 dictionary in least-frequently-used order.
+///
+/// Each phrase counts how many factors have used it or one of its descendants as a reference.
+/// The leaves are kept in a \ref MinInc by their counts, and among the leaves with the minimum count, the one that reached its count the longest time ago is evicted.
+class LFUEviction {
+private:
+    using MinIncType = MinInc<index_t>;
+
+    static constexpr index_t ROOT = 0;
+
+    std::vector<index_t> m_parent;
+    std::vector<index_t> m_count;
+    std::vector<index_t> m_num_children;
+    std::vector<MinIncType::Handle> m_handle;
+    std::vector<bool> m_is_leaf; // whether contained in m_leaves
+    MinIncType m_leaves;
+
+    void insert_leaf(const index_t v) {
+        assert(!m_is_leaf[v]);
+        m_handle[v] = m_leaves.insert(v, m_count[v]);
+        m_is_leaf[v] = true;
+    }
+
+    void erase_leaf(const index_t v) {
+        assert(m_is_leaf[v]);
+        m_leaves.erase(m_handle[v]);
+        m_is_leaf[v] = false;
+    }
+
+    void ensure(const index_t v) {
+        if(v >= m_parent.size()) {
+            m_parent.resize(v + 1, ROOT);
+            m_count.resize(v + 1, 0);
+            m_num_children.resize(v + 1, 0);
+            m_handle.resize(v + 1);
+            m_is_leaf.resize(v + 1, false);
+        }
+    }
+
+public:
+    /// \brief Constructs the bookkeeping for an empty dictionary.
+    /// \param capacity the maximum number of phrases, including the empty phrase
+    LFUEviction(const size_t capacity = 0) {
+        m_parent.reserve(capacity);
+        m_count.reserve(capacity);
+        m_num_children.reserve(capacity);
+        m_handle.reserve(capacity);
+        m_is_leaf.reserve(capacity);
+        ensure(ROOT);
+    }
+
+    /// \brief The parent of a phrase.
+    index_t parent(const index_t v) const {
+        return m_parent[v];
+    }
+
+    /// \brief Notifies that a phrase has been used as the reference of a factor.
+    /// \param v the phrase
+    void use(index_t v) {
+        if(v != ROOT && m_is_leaf[v]) {
+            m_handle[v] = m_leaves.increase_key(m_handle[v]);
+        }
+        for(; v != ROOT; v = m_parent[v]) {
+            ++m_count[v];
+        }
+    }
+
+    /// \brief Selects a leaf to evict and removes it.
+    /// \param ref the phrase that is about to be extended, which is never evicted
+    /// \return the evicted phrase, or the root if there is no leaf to evict
+    index_t evict(const index_t ref) {
+        const bool protect = (ref != ROOT && m_is_leaf[ref]);
+        if(protect) erase_leaf(ref);
+
+        index_t v = ROOT;
+        if(!m_leaves.empty()) {
+            v = m_leaves.extract_oldest_min();
+            m_is_leaf[v] = false;
+
+            // the parent may become a leaf
+            const auto parent = m_parent[v];
+            if(--m_num_children[parent] == 0 && parent != ROOT && parent != ref) {
+                insert_leaf(parent);
+            }
+        }
+
+        if(protect) insert_leaf(ref);
+        return v;
+    }
+
+    /// \brief Inserts a new leaf after its parent has been used.
+    /// \param v the new phrase
+    /// \param parent the parent phrase
+    void insert(const index_t v, const index_t parent) {
+        ensure(v);
+        if(parent != ROOT && m_is_leaf[parent]) erase_leaf(parent);
+        ++m_num_children[parent];
+
+        m_parent[v] = parent;
+        m_count[v] = 1;
+        m_num_children[v] = 0;
+        insert_leaf(v);
+    }
+};
+
+}}}
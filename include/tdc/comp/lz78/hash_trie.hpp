@@ -0,0 +1,183 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include <tdc/math/ilog2.hpp>
+#include <tdc/util/index.hpp>
+
+namespace tdc {
+namespace comp {
+namespace lz78 {
+
+/// \brief An open addressing hash table that maps pairs of a trie node and a character to the corresponding child node.
+///
+/// Each node-character pair is packed into a single 64-bit key, which is hashed using Fibonacci hashing.
+/// Collisions are resolved by linear probing over a power-of-two number of slots, and removed entries are filled by shifting back the following entries,
+/// so no tombstones are needed. The table grows by a factor of two when three quarters of the slots are used.
+///
+/// \tparam char_t the character type
+template<typename char_t>
+class TrieHashTable {
+private:
+    using uchar_t = std::make_unsigned_t<char_t>;
+
+    static constexpr size_t LABEL_BITS = 8 * sizeof(char_t);
+    static constexpr uint64_t EMPTY = UINT64_MAX;
+
+    struct Slot {
+        uint64_t key;
+        index_t child;
+    };
+
+    std::vector<Slot> m_slots;
+    size_t m_mask;
+    size_t m_shift;
+    size_t m_size;
+    size_t m_max_size;
+
+    static uint64_t key(const index_t node, const char_t c) {
+        return ((uint64_t)node << LABEL_BITS) | (uint64_t)(uchar_t)c;
+    }
+
+    size_t slot(const uint64_t key) const {
+        return (key * 0x9E3779B97F4A7C15ULL) >> m_shift;
+    }
+
+    void init(const size_t capacity) {
+        m_slots.assign(capacity, Slot { EMPTY, 0 });
+        m_mask = capacity - 1;
+        m_shift = 64 - math::ilog2_floor(capacity);
+        m_max_size = 3 * capacity / 4; // leaves at least one slot empty
+    }
+
+    void insert_key(const uint64_t k, const index_t child) {
+        size_t i = slot(k);
+        while(m_slots[i].key != EMPTY) {
+            assert(m_slots[i].key != k);
+            i = (i + 1) & m_mask;
+        }
+        m_slots[i] = Slot { k, child };
+    }
+
+    void grow() {
+        auto old = std::move(m_slots);
+        init(2 * old.size());
+        for(const auto& s : old) {
+            if(s.key != EMPTY) insert_key(s.key, s.child);
+        }
+    }
+
+public:
+    /// \brief Constructs an empty table.
+    /// \param capacity the initial number of slots, rounded up to a power of two
+    TrieHashTable(const size_t capacity = 16) : m_size(0) {
+        init(size_t(1) << math::ilog2_ceil(std::max(capacity, size_t(2)) - 1));
+    }
+
+    TrieHashTable(const TrieHashTable&) = default;
+    TrieHashTable(TrieHashTable&&) = default;
+    TrieHashTable& operator=(const TrieHashTable&) = default;
+    TrieHashTable& operator=(TrieHashTable&&) = default;
+
+    /// \brief Finds the child of a node.
+    /// \param node the parent node
+    /// \param c the label of the edge to the child
+    /// \return the child node, or zero if there is none
+    index_t find(const index_t node, const char_t c) const {
+        const uint64_t k = key(node, c);
+        size_t i = slot(k);
+        while(true) {
+            const auto& s = m_slots[i];
+            if(s.key == k) return s.child;
+            if(s.key == EMPTY) return 0;
+            i = (i + 1) & m_mask;
+        }
+    }
+
+    /// \brief Inserts a child, which must not exist yet.
+    /// \param node the parent node
+    /// \param c the label of the edge to the child
+    /// \param child the child node
+    void insert(const index_t node, const char_t c, const index_t child) {
+        if(m_size >= m_max_size) grow();
+        insert_key(key(node, c), child);
+        ++m_size;
+    }
+
+    /// \brief Removes a child if it exists.
+    /// \param node the parent node
+    /// \param c the label of the edge to the child
+    void erase(const index_t node, const char_t c) {
+        const uint64_t k = key(node, c);
+        size_t i = slot(k);
+        while(m_slots[i].key != k) {
+            if(m_slots[i].key == EMPTY) return;
+            i = (i + 1) & m_mask;
+        }
+
+        // shift back following entries whose probe sequence passes the freed slot
+        size_t j = i;
+        while(true) {
+            j = (j + 1) & m_mask;
+            if(m_slots[j].key == EMPTY) break;
+
+            const size_t home = slot(m_slots[j].key);
+            if(((j - home) & m_mask) >= ((j - i) & m_mask)) {
+                m_slots[i] = m_slots[j];
+                i = j;
+            }
+        }
+        m_slots[i].key = EMPTY;
+        --m_size;
+    }
+
+    /// \brief The number of entries.
+    size_t size() const {
+        return m_size;
+    }
+
+    /// \brief The number of slots.
+    size_t capacity() const {
+        return m_slots.size();
+    }
+};
+
+/// \brief An LZ78 trie that stores all edges in a hash table (\ref TrieHashTable), allowing child lookups in expected constant time.
+/// \tparam char_t the character type
+template<typename char_t>
+class HashTrie {
+private:
+    static constexpr index_t ROOT = 0;
+
+    TrieHashTable<char_t> m_table;
+    size_t m_size;
+
+public:
+    HashTrie() : m_size(1) {
+    }
+
+    index_t root() const {
+        return ROOT;
+    }
+
+    size_t size() const {
+        return m_size;
+    }
+
+    index_t get_child(const index_t node, const char_t c) {
+        return m_table.find(node, c);
+    }
+
+    index_t insert_child(const index_t parent, const char_t c) {
+        const index_t child = (index_t)m_size++;
+        m_table.insert(parent, c, child);
+        return child;
+    }
+};
+
+}}}
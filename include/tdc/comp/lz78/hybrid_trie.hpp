@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include <tdc/util/index.hpp>
+
+#include "hash_trie.hpp"
+
+namespace tdc {
+namespace comp {
+namespace lz78 {
+
+/// \brief An LZ78 trie that stores the edges of sparse nodes in a hash table (\ref TrieHashTable) and those of dense nodes in child arrays.
+///
+/// Once a node has \c m_threshold children, its edges are moved from the hash table into an array indexed by character.
+/// Nodes near the root, which have the most children and are visited the most, are thus accessed without hashing.
+///
+/// \tparam char_t the character type
+/// \tparam m_threshold the number of children at which a node is converted to using a child array
+template<typename char_t, size_t m_threshold = 24>
+class HybridTrie {
+private:
+    using uchar_t = std::make_unsigned_t<char_t>;
+
+    static constexpr index_t ROOT = 0;
+    static constexpr index_t NO_ARRAY = INDEX_MAX;
+    static constexpr size_t SIGMA = size_t(1) << (8 * sizeof(char_t));
+
+    static_assert(m_threshold > 0 && m_threshold <= SIGMA, "invalid child array threshold");
+
+    TrieHashTable<char_t> m_table;
+
+    std::vector<uint16_t> m_num_children; // only maintained until a node is converted
+    std::vector<index_t>  m_array;        // child array of each node, or NO_ARRAY
+    std::vector<index_t>  m_children;     // concatenated child arrays
+
+    void convert_to_child_array(const index_t node) {
+        const index_t arr = (index_t)(m_children.size() / SIGMA);
+        m_children.resize(m_children.size() + SIGMA, ROOT);
+
+        index_t* children = m_children.data() + (size_t)arr * SIGMA;
+        for(size_t c = 0; c < SIGMA; c++) {
+            const auto child = m_table.find(node, (char_t)c);
+            if(child != ROOT) {
+                children[c] = child;
+                m_table.erase(node, (char_t)c);
+            }
+        }
+        m_array[node] = arr;
+    }
+
+public:
+    HybridTrie() {
+        m_num_children.reserve(16);
+        m_array.reserve(16);
+
+        // node 0 is the root
+        m_num_children.emplace_back(0);
+        m_array.emplace_back(NO_ARRAY);
+    }
+
+    index_t root() const {
+        return ROOT;
+    }
+
+    size_t size() const {
+        return m_array.size();
+    }
+
+    /// \brief The number of nodes that use a child array.
+    size_t num_child_arrays() const {
+        return m_children.size() / SIGMA;
+    }
+
+    index_t get_child(const index_t node, const char_t c) {
+        const auto arr = m_array[node];
+        if(arr != NO_ARRAY) {
+            return m_children[(size_t)arr * SIGMA + (uchar_t)c];
+        } else {
+            return m_table.find(node, c);
+        }
+    }
+
+    index_t insert_child(const index_t parent, const char_t c) {
+        const index_t child = (index_t)size();
+        m_num_children.emplace_back(0);
+        m_array.emplace_back(NO_ARRAY);
+
+        const auto arr = m_array[parent];
+        if(arr != NO_ARRAY) {
+            m_children[(size_t)arr * SIGMA + (uchar_t)c] = child;
+        } else {
+            m_table.insert(parent, c, child);
+            if(++m_num_children[parent] >= m_threshold) {
+                convert_to_child_array(parent);
+            }
+        }
+        return child;
+    }
+};
+
+}}}
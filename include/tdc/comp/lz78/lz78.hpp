@@ -1,15 +1,32 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <vector>
 
+#include "dictionary_policy.hpp"
+#include "phrase_table.hpp"
 #include "stats.hpp"
 
+#include <tdc/io/bit_istream.hpp>
+#include <tdc/io/bit_ostream.hpp>
+#include <tdc/io/input_source.hpp>
+#include <tdc/math/ilog2.hpp>
 #include <tdc/util/literals.hpp>
 
 namespace tdc {
 namespace comp {
 namespace lz78 {
 
+/// \brief LZ78 compression.
+///
+/// Each factor is encoded as the reference to its longest previous phrase, using <tt>ceil(log2(n))</tt> bits for a dictionary of \c n phrases,
+/// followed by the eight bits of the next character. The final factor may consist only of a reference.
+/// The output is written using a \ref io::BitOStream and can be decoded using \ref LZ78Decoder.
+///
+/// \tparam trie_t the trie used to find phrases
+/// \tparam m_track_stats whether to collect \ref Stats
 template<typename trie_t, bool m_track_stats = false>
 class LZ78 {
 private:
@@ -18,45 +35,116 @@ private:
     trie_t m_trie;
     index_t m_current;
 
-    void process(char c, std::ostream& out) {
+    size_t m_max_size;
+    DictionaryPolicy m_policy;
+
+    void process(char c, io::BitOStream& out) {
         auto child = m_trie.get_child(m_current, c);
         if(child) {
             m_current = child;
         } else {
-            out << "(" << m_current << "," << c << ")";
-            m_trie.insert_child(m_current, c);
+            out.write_binary(m_current, math::ilog2_ceil(m_trie.size() - 1));
+            out.write_binary((uint8_t)c);
+            if constexpr(m_track_stats) ++m_stats.num_factors;
+
+            if(m_trie.size() < m_max_size) {
+                m_trie.insert_child(m_current, c);
+                if(m_trie.size() >= m_max_size && m_policy == DictionaryPolicy::reset) {
+                    m_trie = trie_t();
+                    if constexpr(m_track_stats) ++m_stats.num_resets;
+                }
+            }
             m_current = m_trie.root();
         }
     }
 
 public:
-    LZ78() {
+    /// \brief Constructs a compressor.
+    /// \param max_dict_size the maximum number of phrases in the dictionary, including the empty phrase
+    /// \param policy what to do when the dictionary reaches its maximum size
+    LZ78(const size_t max_dict_size = SIZE_MAX, const DictionaryPolicy policy = DictionaryPolicy::freeze)
+        : m_max_size(std::max(max_dict_size, size_t(2))), m_policy(policy) {
+
         m_current = m_trie.root();
     }
     
-    void compress(std::istream& in, std::ostream& out) {
-        constexpr size_t bufsize = 1_Mi;
-        char* buffer = new char[bufsize];
-        bool b;
-        do {
-            b = (bool)in.read(buffer, bufsize);
-            const size_t num = in.gcount();
-            for(size_t i = 0; i < num; i++) {
-                process(buffer[i], out);
+    void compress(io::InputSource& in, std::ostream& out) {
+        {
+            io::BitOStream bits(out);
+            for(auto chunk = in.next(); chunk.size() > 0; chunk = in.next()) {
+                for(const char c : chunk) {
+                    process(c, bits);
+                }
+                if constexpr(m_track_stats) m_stats.input_size += chunk.size();
             }
-            if constexpr(m_track_stats) m_stats.input_size += num;
-        } while(b);
-        
-        // output final factor
-        if(m_current) {
-            out << "(" << m_current << ",<EOF>)";
+            
+            // output final factor
+            if(m_current) {
+                bits.write_binary(m_current, math::ilog2_ceil(m_trie.size() - 1));
+                if constexpr(m_track_stats) ++m_stats.num_factors;
+            }
+
+            if constexpr(m_track_stats) m_stats.output_bits = bits.bits_written();
         }
         
-        delete[] buffer;
         if constexpr(m_track_stats) m_stats.trie_size = m_trie.size();
     }
+
+    void compress(std::istream& in, std::ostream& out) {
+        io::InputSource src(in);
+        compress(src, out);
+    }
     
     const Stats& stats() const { return m_stats; }
 };
 
+/// \brief Decodes the output of \ref LZ78.
+///
+/// The dictionary is rebuilt in a \ref PhraseTable. The maximum dictionary size and policy must match those of the compressor.
+class LZ78Decoder {
+private:
+    static constexpr size_t BUFFER_SIZE = 1_Mi;
+
+    size_t m_max_size;
+    DictionaryPolicy m_policy;
+
+public:
+    /// \brief Constructs a decoder.
+    /// \param max_dict_size the maximum number of phrases in the dictionary, including the empty phrase
+    /// \param policy what to do when the dictionary reaches its maximum size
+    LZ78Decoder(const size_t max_dict_size = SIZE_MAX, const DictionaryPolicy policy = DictionaryPolicy::freeze)
+        : m_max_size(std::max(max_dict_size, size_t(2))), m_policy(policy) {
+    }
+
+    void decompress(std::istream& in, std::ostream& out) {
+        io::BitIStream bits(in);
+        PhraseTable table;
+
+        std::vector<char> buffer;
+        buffer.reserve(BUFFER_SIZE);
+
+        while(!bits.eof()) {
+            const auto ref = bits.read_binary<index_t>(math::ilog2_ceil(table.size() - 1));
+            table.decode(ref, buffer);
+            if(bits.eof()) break; // final factor
+
+            const char c = (char)bits.read_binary<uint8_t>();
+            buffer.emplace_back(c);
+
+            if(table.size() < m_max_size) {
+                table.insert(ref, c);
+                if(table.size() >= m_max_size && m_policy == DictionaryPolicy::reset) {
+                    table.clear();
+                }
+            }
+
+            if(buffer.size() >= BUFFER_SIZE) {
+                out.write(buffer.data(), buffer.size());
+                buffer.clear();
+            }
+        }
+        out.write(buffer.data(), buffer.size());
+    }
+};
+
 }}}
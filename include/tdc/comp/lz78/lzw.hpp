@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "dictionary_policy.hpp"
+#include "phrase_table.hpp"
+#include "stats.hpp"
+
+#include <tdc/io/bit_istream.hpp>
+#include <tdc/io/bit_ostream.hpp>
+#include <tdc/io/input_source.hpp>
+#include <tdc/math/ilog2.hpp>
+#include <tdc/util/literals.hpp>
+
+namespace tdc {
+namespace comp {
+namespace lz78 {
+
+/// \brief LZW compression.
+///
+/// The dictionary initially contains all single characters, such that each factor is encoded only as the reference to its longest previous phrase,
+/// using <tt>ceil(log2(n))</tt> bits for a dictionary of \c n phrases.
+/// The character following a phrase is implied by the next factor.
+/// The output is written using a \ref io::BitOStream and can be decoded using \ref LZWDecoder.
+///
+/// \tparam trie_t the trie used to find phrases
+/// \tparam m_track_stats whether to collect \ref Stats
+template<typename trie_t, bool m_track_stats = false>
+class LZW {
+private:
+    static constexpr size_t SIGMA = 256;
+
+    Stats m_stats;
+    
+    trie_t m_trie;
+    index_t m_current;
+
+    size_t m_max_size;
+    DictionaryPolicy m_policy;
+
+    // the node of the single character c is c+1
+    static index_t single(const char c) {
+        return (index_t)(uint8_t)c + 1;
+    }
+
+    void init() {
+        m_trie = trie_t();
+        for(size_t c = 0; c < SIGMA; c++) {
+            m_trie.insert_child(m_trie.root(), (char)c);
+        }
+    }
+
+    void write_phrase(io::BitOStream& out) {
+        // the root is not a phrase, so phrase v has code v-1
+        out.write_binary(m_current - 1, math::ilog2_ceil(m_trie.size() - 2));
+        if constexpr(m_track_stats) ++m_stats.num_factors;
+    }
+
+    void process(char c, io::BitOStream& out) {
+        auto child = m_trie.get_child(m_current, c);
+        if(child) {
+            m_current = child;
+        } else {
+            write_phrase(out);
+            if(m_trie.size() < m_max_size) {
+                m_trie.insert_child(m_current, c);
+                if(m_trie.size() >= m_max_size && m_policy == DictionaryPolicy::reset) {
+                    init();
+                    if constexpr(m_track_stats) ++m_stats.num_resets;
+                }
+            }
+            m_current = single(c);
+        }
+    }
+
+public:
+    /// \brief Constructs a compressor.
+    /// \param max_dict_size the maximum number of phrases in the dictionary, which initially contains 256 phrases
+    /// \param policy what to do when the dictionary reaches its maximum size
+    LZW(const size_t max_dict_size = SIZE_MAX, const DictionaryPolicy policy = DictionaryPolicy::freeze)
+        : m_max_size(std::max(max_dict_size, SIGMA + 1) + 1), m_policy(policy) {
+
+        if(m_max_size == 0) m_max_size = SIZE_MAX; // overflow
+
+        init();
+        m_current = m_trie.root();
+    }
+    
+    void compress(io::InputSource& in, std::ostream& out) {
+        {
+            io::BitOStream bits(out);
+            for(auto chunk = in.next(); chunk.size() > 0; chunk = in.next()) {
+                for(const char c : chunk) {
+                    process(c, bits);
+                }
+                if constexpr(m_track_stats) m_stats.input_size += chunk.size();
+            }
+            
+            // output final factor
+            if(m_current != m_trie.root()) {
+                write_phrase(bits);
+            }
+
+            if constexpr(m_track_stats) m_stats.output_bits = bits.bits_written();
+        }
+        
+        if constexpr(m_track_stats) m_stats.trie_size = m_trie.size();
+    }
+
+    void compress(std::istream& in, std::ostream& out) {
+        io::InputSource src(in);
+        compress(src, out);
+    }
+    
+    const Stats& stats() const { return m_stats; }
+};
+
+/// \brief Decodes the output of \ref LZW.
+///
+/// The dictionary is rebuilt in a \ref PhraseTable, lagging one phrase behind that of the compressor,
+/// because the last character of each new phrase is only known once the next factor has been read.
+/// The maximum dictionary size and policy must match those of the compressor.
+class LZWDecoder {
+private:
+    static constexpr size_t SIGMA = 256;
+    static constexpr size_t BUFFER_SIZE = 1_Mi;
+    static constexpr index_t ROOT = 0;
+
+    size_t m_max_size;
+    DictionaryPolicy m_policy;
+
+    static void init(PhraseTable& table) {
+        table.clear();
+        for(size_t c = 0; c < SIGMA; c++) {
+            table.insert(ROOT, (char)c);
+        }
+    }
+
+public:
+    /// \brief Constructs a decoder.
+    /// \param max_dict_size the maximum number of phrases in the dictionary, which initially contains 256 phrases
+    /// \param policy what to do when the dictionary reaches its maximum size
+    LZWDecoder(const size_t max_dict_size = SIZE_MAX, const DictionaryPolicy policy = DictionaryPolicy::freeze)
+        : m_max_size(std::max(max_dict_size, SIGMA + 1) + 1), m_policy(policy) {
+
+        if(m_max_size == 0) m_max_size = SIZE_MAX; // overflow
+    }
+
+    void decompress(std::istream& in, std::ostream& out) {
+        io::BitIStream bits(in);
+        PhraseTable table;
+        init(table);
+
+        std::vector<char> buffer;
+        buffer.reserve(BUFFER_SIZE);
+
+        size_t size = table.size(); // the size of the compressor's trie
+        index_t prev = ROOT;        // the phrase that the compressor extended after writing it, if any
+        while(!bits.eof()) {
+            const index_t v = bits.read_binary<index_t>(math::ilog2_ceil(size - 2)) + 1;
+            if(prev != ROOT) {
+                // the compressor extended the previous phrase by the first character of this one
+                // if this phrase is the extension itself, that character is also the first of the previous phrase
+                table.insert(prev, table.first(v < table.size() ? v : prev));
+            }
+            table.decode(v, buffer);
+
+            // mirror the compressor's dictionary update
+            if(size < m_max_size) {
+                ++size;
+                if(size >= m_max_size && m_policy == DictionaryPolicy::reset) {
+                    init(table);
+                    size = table.size();
+                    prev = ROOT;
+                } else {
+                    prev = v;
+                }
+            } else {
+                prev = ROOT;
+            }
+
+            if(buffer.size() >= BUFFER_SIZE) {
+                out.write(buffer.data(), buffer.size());
+                buffer.clear();
+            }
+        }
+        out.write(buffer.data(), buffer.size());
+    }
+};
+
+}}}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include <tdc/util/index.hpp>
+
+namespace tdc {
+namespace comp {
+namespace lz78 {
+
+/// \brief The dictionary of an LZ78 or LZW decoder.
+///
+/// Each phrase is represented by its parent phrase and its last character, like a trie node, with node 0 being the empty phrase.
+/// Additionally, the length and the first character of each phrase are stored so phrases can be written front to back in a single pass.
+class PhraseTable {
+private:
+    static constexpr index_t ROOT = 0;
+
+    std::vector<index_t> m_parent;
+    std::vector<index_t> m_length;
+    std::vector<char>    m_char;
+    std::vector<char>    m_first;
+
+public:
+    PhraseTable() {
+        clear();
+    }
+
+    /// \brief Removes all phrases except the empty phrase.
+    void clear() {
+        m_parent.assign(1, ROOT);
+        m_length.assign(1, 0);
+        m_char.assign(1, 0);
+        m_first.assign(1, 0);
+    }
+
+    /// \brief The number of phrases, including the empty phrase.
+    size_t size() const {
+        return m_parent.size();
+    }
+
+    /// \brief Appends a phrase.
+    /// \param parent the phrase to extend
+    /// \param c the character to extend the parent phrase by
+    /// \return the new phrase
+    index_t insert(const index_t parent, const char c) {
+        assert(parent < size());
+        const index_t v = (index_t)size();
+        m_parent.emplace_back(parent);
+        m_length.emplace_back(m_length[parent] + 1);
+        m_char.emplace_back(c);
+        m_first.emplace_back(parent == ROOT ? c : m_first[parent]);
+        return v;
+    }
+
+    /// \brief Replaces a leaf phrase by a new phrase.
+    /// \param v the phrase to replace, which must not be the parent of any phrase
+    /// \param parent the phrase to extend
+    /// \param c the character to extend the parent phrase by
+    void replace(const index_t v, const index_t parent, const char c) {
+        assert(v != ROOT && v < size() && parent != v);
+        m_parent[v] = parent;
+        m_length[v] = m_length[parent] + 1;
+        m_char[v] = c;
+        m_first[v] = (parent == ROOT) ? c : m_first[parent];
+    }
+
+    /// \brief The length of a phrase.
+    index_t length(const index_t v) const {
+        return m_length[v];
+    }
+
+    /// \brief The first character of a non-empty phrase.
+    char first(const index_t v) const {
+        return m_first[v];
+    }
+
+    /// \brief Writes a phrase.
+    /// \param v the phrase
+    /// \param out the output buffer, which must have room for \ref length characters
+    void decode(index_t v, char* out) const {
+        for(char* p = out + m_length[v]; v != ROOT; v = m_parent[v]) {
+            *--p = m_char[v];
+        }
+    }
+
+    /// \brief Appends a phrase to a buffer.
+    /// \param v the phrase
+    /// \param buffer the buffer
+    void decode(const index_t v, std::vector<char>& buffer) const {
+        const size_t sz = buffer.size();
+        buffer.resize(sz + m_length[v]);
+        decode(v, buffer.data() + sz);
+    }
+};
+
+}}}
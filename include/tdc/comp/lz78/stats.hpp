@@ -8,10 +8,18 @@ namespace lz78 {
 struct Stats {
     size_t input_size;
     size_t trie_size;
+    size_t num_factors;
+    size_t num_resets;
+    size_t num_evictions;
+    size_t output_bits;
     
     Stats()
         : input_size(0),
-          trie_size(0)
+          trie_size(0),
+          num_factors(0),
+          num_resets(0),
+          num_evictions(0),
+          output_bits(0)
     {}
 };
 
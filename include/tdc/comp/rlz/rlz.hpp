@@ -0,0 +1,238 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <tdc/code/vbyte.hpp>
+#include <tdc/util/char.hpp>
+#include <tdc/util/match_length.hpp>
+#include <tdc/util/sa_backend.hpp>
+
+namespace tdc {
+namespace comp {
+namespace rlz {
+
+/// \brief Relative Lempel-Ziv (RLZ) compression of a document collection against a reference text.
+///
+/// Each document is factorized greedily into references to the reference text and literals.
+/// The longest reference at each position is found by narrowing down an interval in the reference's suffix array one character at a time,
+/// and by direct comparison once the interval contains a single suffix.
+///
+/// The factors of each document are encoded like in \ref lz77::FactorStreamOutput, except that references store their absolute position in the reference text.
+/// Because references never point into other documents, any document can be decoded independently using only the reference text.
+class RLZ {
+private:
+    static constexpr size_t SIGMA = 1ULL << CHAR_BITS;
+
+    std::vector<char_t> ref_;
+    std::vector<saidx_t> sa_;
+    size_t bucket_[SIGMA + 1]; // suffix array interval of the suffixes starting with each character
+    size_t min_len_;
+
+    std::vector<uint8_t> data_;      // encoded factors of all documents
+    std::vector<size_t> doc_begin_;  // offset of each document's factors in data_, plus the total size
+    std::vector<size_t> doc_size_;   // decoded size of each document
+
+    // stats
+    size_t num_refs_;
+    size_t num_literals_;
+    size_t input_size_;
+
+    // finds the longest prefix of s occurring in the reference, returning its position and length
+    std::pair<size_t, size_t> longest_match(const char_t* s, const size_t n) const {
+        const size_t m = ref_.size();
+        size_t l = bucket_[s[0]];
+        size_t r = bucket_[s[0] + 1];
+        if(l == r) return { 0, 0 };
+
+        // all suffixes in [l, r) have the first d characters in common and are sorted by their d-th character
+        // suffixes of length d have no d-th character and come first
+        size_t d = 1;
+        while(d < n && r - l > 1) {
+            const int c = s[d];
+            auto key = [&](const size_t k){
+                const size_t p = (size_t)sa_[k] + d;
+                return p < m ? int(ref_[p]) : -1;
+            };
+
+            size_t lo = l, hi = r;
+            while(lo < hi) {
+                const size_t mid = lo + (hi - lo) / 2;
+                if(key(mid) < c) lo = mid + 1; else hi = mid;
+            }
+            const size_t new_l = lo;
+
+            hi = r;
+            while(lo < hi) {
+                const size_t mid = lo + (hi - lo) / 2;
+                if(key(mid) <= c) lo = mid + 1; else hi = mid;
+            }
+            const size_t new_r = lo;
+
+            if(new_l == new_r) break;
+            l = new_l;
+            r = new_r;
+            ++d;
+        }
+
+        const size_t p = (size_t)sa_[l];
+        if(r - l == 1 && d < n) {
+            d += match_length(s + d, ref_.data() + p + d, std::min(n - d, m - p - d));
+        }
+        return { p, d };
+    }
+
+    void build_index() {
+        static_assert(sizeof(char_t) == 1, "RLZ requires one-byte characters");
+
+        const size_t m = ref_.size();
+        if(m > (size_t)std::numeric_limits<saidx_t>::max()) {
+            throw std::runtime_error("reference must be shorter than 2 GiB");
+        }
+
+        sa_.resize(m);
+        if(m > 0) sa_backend::suffix_array(ref_.data(), m, sa_.data());
+
+        // the suffix array interval of each character follows from the character counts
+        std::fill(bucket_, bucket_ + SIGMA + 1, 0);
+        for(size_t i = 0; i < m; i++) ++bucket_[ref_[i] + 1];
+        for(size_t c = 1; c <= SIGMA; c++) bucket_[c] += bucket_[c - 1];
+    }
+
+public:
+    /// \brief Samples a reference text from a collection.
+    ///
+    /// The reference is the concatenation of evenly spaced samples of the collection.
+    /// If the collection is not larger than the requested reference size, it is used as the reference entirely.
+    ///
+    /// \param text the concatenation of all documents
+    /// \param n the length of the text
+    /// \param ref_size the desired reference size
+    /// \param sample_len the length of each sample
+    static std::vector<char_t> sample_reference(const char_t* text, const size_t n, const size_t ref_size, const size_t sample_len = 1024) {
+        if(n <= ref_size) return std::vector<char_t>(text, text + n);
+
+        const size_t len = std::max(std::min(sample_len, ref_size), size_t(1));
+        const size_t num_samples = std::max(ref_size / len, size_t(1));
+        const size_t stride = n / num_samples;
+
+        std::vector<char_t> ref;
+        ref.reserve(num_samples * len);
+        for(size_t k = 0; k < num_samples; k++) {
+            const size_t begin = k * stride;
+            ref.insert(ref.end(), text + begin, text + std::min(begin + len, n));
+        }
+        return ref;
+    }
+
+    /// \brief Constructs a compressor for the given reference text and builds its suffix array.
+    /// \param reference the reference text
+    /// \param min_len the minimum reference length, shorter matches are encoded as literals
+    RLZ(std::vector<char_t>&& reference, const size_t min_len = 3)
+        : ref_(std::move(reference)), min_len_(std::max(min_len, size_t(1))), num_refs_(0), num_literals_(0), input_size_(0) {
+
+        build_index();
+        doc_begin_.push_back(0);
+    }
+
+    RLZ(const RLZ&) = default;
+    RLZ(RLZ&&) = default;
+    RLZ& operator=(const RLZ&) = default;
+    RLZ& operator=(RLZ&&) = default;
+
+    /// \brief Compresses a document and appends it to the collection.
+    /// \param doc the document
+    /// \param n the length of the document
+    /// \return the document's number
+    size_t add(const char_t* doc, const size_t n) {
+        uint8_t buf[2 * code::VBYTE_MAX_BYTES];
+        for(size_t i = 0; i < n;) {
+            const auto [src, len] = longest_match(doc + i, n - i);
+            size_t code_len;
+            if(len >= min_len_) {
+                code_len = code::vbyte_encode(buf, (uint64_t(len) << 1) | 1);
+                code_len += code::vbyte_encode(buf + code_len, src);
+                ++num_refs_;
+                i += len;
+            } else {
+                code_len = code::vbyte_encode(buf, uint64_t(doc[i]) << 1);
+                ++num_literals_;
+                ++i;
+            }
+            data_.insert(data_.end(), buf, buf + code_len);
+        }
+
+        doc_begin_.push_back(data_.size());
+        doc_size_.push_back(n);
+        input_size_ += n;
+        return doc_size_.size() - 1;
+    }
+
+    /// \brief Decodes a document.
+    /// \param doc the document's number
+    /// \param out the output buffer, which must have room for \ref document_size characters
+    void decode(const size_t doc, char_t* out) const {
+        assert(doc < num_documents());
+        const uint8_t* p = data_.data() + doc_begin_[doc];
+        const uint8_t* end = data_.data() + doc_begin_[doc + 1];
+        while(p < end) {
+            const auto header = code::vbyte_decode(p);
+            if(header & 1) {
+                const size_t len = header >> 1;
+                const size_t src = code::vbyte_decode(p);
+                assert(src + len <= ref_.size());
+                std::copy(ref_.data() + src, ref_.data() + src + len, out);
+                out += len;
+            } else {
+                *out++ = char_t(header >> 1);
+            }
+        }
+    }
+
+    /// \brief Decodes a document.
+    /// \param doc the document's number
+    std::vector<char_t> decode(const size_t doc) const {
+        std::vector<char_t> out(document_size(doc));
+        decode(doc, out.data());
+        return out;
+    }
+
+    /// \brief The number of documents.
+    size_t num_documents() const {
+        return doc_size_.size();
+    }
+
+    /// \brief The decoded size of a document.
+    /// \param doc the document's number
+    size_t document_size(const size_t doc) const {
+        return doc_size_[doc];
+    }
+
+    /// \brief The reference text.
+    const std::vector<char_t>& reference() const {
+        return ref_;
+    }
+
+    /// \brief The number of bytes of encoded factors.
+    size_t encoded_size() const {
+        return data_.size();
+    }
+
+    template<typename StatLogger>
+    void log_stats(StatLogger& logger) {
+        logger.log("reference_size", ref_.size());
+        logger.log("num_docs", num_documents());
+        logger.log("input_size", input_size_);
+        logger.log("num_refs", num_refs_);
+        logger.log("num_literals", num_literals_);
+        logger.log("encoded_size", data_.size());
+    }
+};
+
+}}} // namespace tdc::comp::rlz
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <utility>
+
+#include "background_worker.hpp"
+#include "input_source.hpp"
+
+namespace tdc {
+namespace io {
+
+/// \brief Reads items one at a time from an \ref InputSource, reading ahead on a background thread.
+///
+/// Streams are read into two buffers in turns: while the items of one buffer are consumed, the next buffer is filled in the background,
+/// so that computation and I/O overlap. Memory backed inputs are read in place like by the \ref BufferedReader.
+///
+/// Because of the read-ahead, the input source must not be read otherwise while the reader exists,
+/// and it may have advanced beyond the items consumed when the reader is destroyed.
+template<typename item_t>
+class AsyncBufferedReader {
+private:
+    std::unique_ptr<InputSource> m_owned_source;
+    InputSource* m_source;
+    size_t m_bufsize_bytes;
+
+    // stream buffers, the front one is being consumed and the back one is being filled
+    std::unique_ptr<char[]> m_front;
+    std::unique_ptr<char[]> m_back;
+    size_t m_back_bytes;
+    bool m_pending;
+
+    const item_t* m_buffer;
+    size_t m_count;
+    size_t m_cursor;
+
+    BackgroundWorker m_worker; // declared last, so a pending read finishes before the buffers are released
+
+    void prefetch() {
+        m_pending = true;
+        m_worker.submit([this](){
+            m_back_bytes = m_source->read(m_back.get(), m_bufsize_bytes);
+        });
+    }
+
+    bool underflow() {
+        if(m_source->is_memory()) {
+            // memory backed inputs are read in one chunk
+            const auto chunk = m_source->next();
+            m_buffer = (const item_t*)chunk.data();
+            m_count = chunk.size() / sizeof(item_t);
+        } else if(m_pending) {
+            m_worker.wait();
+            m_pending = false;
+
+            std::swap(m_front, m_back);
+            m_buffer = (const item_t*)m_front.get();
+            m_count = m_back_bytes / sizeof(item_t);
+
+            // a short read means the stream has ended
+            if(m_back_bytes == m_bufsize_bytes) prefetch();
+        } else {
+            m_count = 0;
+        }
+        m_cursor = 0;
+        return m_count > 0;
+    }
+
+    void init() {
+        if(!m_source->is_memory()) {
+            m_front = std::make_unique<char[]>(m_bufsize_bytes);
+            m_back = std::make_unique<char[]>(m_bufsize_bytes);
+            prefetch();
+        }
+        underflow();
+    }
+
+public:
+    /// \brief Constructs a reader for an input source.
+    /// \param source the input source
+    /// \param bufsize the number of items to read at once from streams
+    AsyncBufferedReader(InputSource& source, const size_t bufsize)
+        : m_source(&source), m_bufsize_bytes(std::max(bufsize, size_t(1)) * sizeof(item_t)), m_back_bytes(0), m_pending(false), m_buffer(nullptr), m_count(0), m_cursor(0) {
+        init();
+    }
+
+    /// \brief Constructs a reader for a stream.
+    /// \param stream the stream
+    /// \param bufsize the number of items to buffer
+    AsyncBufferedReader(std::istream& stream, const size_t bufsize)
+        : m_owned_source(std::make_unique<InputSource>(stream)),
+          m_source(m_owned_source.get()),
+          m_bufsize_bytes(std::max(bufsize, size_t(1)) * sizeof(item_t)),
+          m_back_bytes(0),
+          m_pending(false),
+          m_buffer(nullptr),
+          m_count(0),
+          m_cursor(0) {
+        init();
+    }
+
+    AsyncBufferedReader(const AsyncBufferedReader&) = delete;
+    AsyncBufferedReader& operator=(const AsyncBufferedReader&) = delete;
+
+    operator bool() {
+        return (m_cursor < m_count) ? true : underflow();
+    }
+
+    item_t read() {
+        if(m_cursor >= m_count) {
+            underflow();
+        }
+        assert(m_cursor < m_count);
+        return m_buffer[m_cursor++];
+    }
+
+    size_t read(item_t* buffer, const size_t num) {
+        size_t rnum = 0;
+        while(rnum < num) {
+            if(m_cursor >= m_count) {
+                const bool read_more = underflow();
+                if(!read_more) break;
+            }
+
+            const size_t k = std::min(num - rnum, m_count - m_cursor);
+            std::memcpy(buffer + rnum, m_buffer + m_cursor, k * sizeof(item_t));
+            m_cursor += k;
+            rnum += k;
+        }
+        return rnum;
+    }
+};
+
+}} // namespace tdc::io
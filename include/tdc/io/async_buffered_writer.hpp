@@ -0,0 +1,100 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <ios>
+#include <iostream>
+#include <memory>
+#include <utility>
+
+#include "background_worker.hpp"
+
+namespace tdc {
+namespace io {
+
+/// \brief Writes items one at a time to a stream, writing back full buffers on a background thread.
+///
+/// Items are collected in two buffers in turns: while one buffer is written to the stream in the background, the other one is filled,
+/// so that computation and I/O overlap.
+///
+/// Errors that occur while writing in the background are reported by the next call to \ref write, \ref flush or \ref close.
+/// Since the destructor cannot report errors, \ref close should be called when all items have been written.
+template<typename item_t>
+class AsyncBufferedWriter {
+private:
+    std::ostream* m_stream;
+    size_t m_bufsize;
+
+    std::unique_ptr<item_t[]> m_front; // being filled
+    std::unique_ptr<item_t[]> m_back;  // being written
+    size_t m_cursor;
+    bool m_closed;
+
+    BackgroundWorker m_worker; // declared last, so a pending write finishes before the buffers are released
+
+    // hands the filled buffer to the worker
+    void write_back() {
+        m_worker.wait();
+        std::swap(m_front, m_back);
+        const size_t num = m_cursor;
+        m_cursor = 0;
+
+        if(num > 0) {
+            m_worker.submit([this, num](){
+                if(!m_stream->write((const char*)m_back.get(), num * sizeof(item_t))) {
+                    throw std::ios_base::failure("AsyncBufferedWriter: failed to write to the stream");
+                }
+            });
+        }
+    }
+
+public:
+    AsyncBufferedWriter(std::ostream& stream, const size_t bufsize)
+        : m_stream(&stream),
+          m_bufsize(std::max(bufsize, size_t(1))),
+          m_front(std::make_unique<item_t[]>(m_bufsize)),
+          m_back(std::make_unique<item_t[]>(m_bufsize)),
+          m_cursor(0),
+          m_closed(false) {
+    }
+
+    /// \brief Closes the writer, ignoring any errors.
+    ~AsyncBufferedWriter() {
+        try {
+            close();
+        } catch(...) {
+        }
+    }
+
+    AsyncBufferedWriter(const AsyncBufferedWriter&) = delete;
+    AsyncBufferedWriter& operator=(const AsyncBufferedWriter&) = delete;
+
+    /// \brief Writes an item.
+    void write(item_t x) {
+        assert(!m_closed);
+        if(m_cursor >= m_bufsize) {
+            write_back();
+        }
+        m_front[m_cursor++] = x;
+    }
+
+    /// \brief Writes all buffered items to the stream and waits until they have been written.
+    ///
+    /// \throws std::ios_base::failure if an item could not be written, or whatever the stream throws
+    void flush() {
+        write_back();
+        m_worker.wait();
+    }
+
+    /// \brief Writes all buffered items to the stream, after which no more items may be written.
+    ///
+    /// \throws std::ios_base::failure if an item could not be written, or whatever the stream throws
+    void close() {
+        if(!m_closed) {
+            m_closed = true;
+            flush();
+        }
+    }
+};
+
+}} // namespace tdc::io
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace tdc {
+namespace io {
+
+/// \brief A thread that executes one job at a time in the background.
+///
+/// This is meant for overlapping I/O with computation, e.g., to read the next buffer of an input while the current one is processed.
+/// Exceptions thrown by a job are rethrown by the next call to \ref wait or \ref submit.
+class BackgroundWorker {
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::function<void()> m_job;
+    bool m_busy;
+    bool m_stop;
+    std::exception_ptr m_error;
+    std::thread m_thread;
+
+    void run();
+    void rethrow();
+
+public:
+    /// \brief Starts the worker thread.
+    BackgroundWorker();
+
+    /// \brief Waits for the current job to finish and stops the worker thread.
+    ~BackgroundWorker();
+
+    BackgroundWorker(const BackgroundWorker&) = delete;
+    BackgroundWorker& operator=(const BackgroundWorker&) = delete;
+
+    /// \brief Waits for the current job to finish and then submits a new job.
+    /// \param job the job
+    void submit(std::function<void()> job);
+
+    /// \brief Waits for the current job to finish.
+    void wait();
+};
+
+}} // namespace tdc::io
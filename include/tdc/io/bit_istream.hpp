@@ -1,63 +1,192 @@
 #pragma once
 
+#include <algorithm>
 #include <cassert>
 #include <climits>
 #include <concepts>
 #include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <memory>
+#include <span>
 
 #include <tdc/math/bit_mask.hpp>
+#include <tdc/util/literals.hpp>
 
 namespace tdc {
 namespace io {
 
 /// \brief Wrapper for input streams that provides bitwise reading functionality.
 ///
+/// Bits are served from a 64-bit word, which is refilled from a byte buffer that is either read from an input stream in large blocks
+/// or that directly refers to a memory region, e.g., a memory mapped file.
+/// Because of the read-ahead, the position of a wrapped input stream is undefined while the wrapper is alive.
+///
 /// Note that when used on a stream that has not been written using a \ref BitOStream, the end of the stream may not be detected correctly on bit level.
 class BitIStream {
 private:
+    static constexpr size_t BUFFER_SIZE = 64_Ki;
+    static constexpr size_t WORD_BITS = 64;
+
     std::istream* m_stream;
+    std::unique_ptr<uint8_t[]> m_buffer;
+
+    const uint8_t* m_ptr; // next byte to load into the word
+    const uint8_t* m_end;
+
+    uint64_t m_word;      // loaded bits, left-aligned
+    size_t   m_word_bits; // number of loaded bits
+
+    size_t m_bytes_total; // number of bytes read from the stream
+    uint8_t m_last_byte;  // the last byte read from the stream, needed to find the lead-out
+
+    size_t m_bits_read;
+    size_t m_bits_total;  // number of valid bits, known once the end of the input has been read
+
+    // determines the number of valid bits from the lead-out written by a BitOStream
+    void read_lead_out(const size_t num_bytes, const uint8_t last);
 
-    static constexpr uint8_t MSB = 7;
+    // reads the next block from the stream into the byte buffer, returns false if there is none
+    bool fill_buffer();
 
-    uint8_t m_current = 0;
-    uint8_t m_next = 0;
+    // loads bytes into the word until it contains at least PEEK_BITS bits or the input is exhausted
+    // the word is only refilled when more bits are needed than it holds, so that consuming bits stays cheap
+    inline void refill() {
+        while(m_word_bits <= WORD_BITS - CHAR_BIT) {
+            if(m_end - m_ptr >= 8) {
+                // load as many full bytes as fit into the word at once
+                uint64_t w;
+                std::memcpy(&w, m_ptr, sizeof(uint64_t));
+                #if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+                    w = __builtin_bswap64(w);
+                #endif
 
-    bool m_is_final = false;
-    uint8_t m_final_bits = 0;
+                const size_t n = (WORD_BITS - m_word_bits) / CHAR_BIT;
+                const size_t take = n * CHAR_BIT;
+                m_word |= (take == WORD_BITS ? w : (w >> (WORD_BITS - take))) << (WORD_BITS - m_word_bits - take);
+                m_word_bits += take;
+                m_ptr += n;
+            } else if(m_ptr != m_end || fill_buffer()) {
+                m_word |= uint64_t(*m_ptr++) << (WORD_BITS - CHAR_BIT - m_word_bits);
+                m_word_bits += CHAR_BIT;
+            } else {
+                break; // input exhausted
+            }
+        }
+    }
 
-    uint8_t m_cursor = 0;
+    inline void consume(const size_t bits) {
+        assert(bits <= m_word_bits);
+        m_word = (bits == WORD_BITS) ? 0ULL : (m_word << bits);
+        m_word_bits -= bits;
+        m_bits_read += bits;
+    }
+
+    // decodes codes directly from the loaded word as long as they fit, using the scalar decoder only for codes that do not
+    // the fast decoder gets the left-aligned word and the number of available bits, and returns the code length, or zero if the code does not fit
+    template<std::integral T, typename fast_t, typename slow_t>
+    void read_codes(std::span<T> values, fast_t fast, slow_t slow) {
+        size_t i = 0;
+        while(i < values.size()) {
+            refill();
+
+            uint64_t w = m_word;
+            size_t avail = m_word_bits;
+            size_t used = 0;
+            uint64_t v;
+            size_t len;
+            while(i < values.size() && (len = fast(w, avail, v)) > 0) {
+                values[i++] = T(v);
+                w = (len == WORD_BITS) ? 0ULL : (w << len);
+                avail -= len;
+                used += len;
+            }
 
-    size_t m_bits_read = 0;
+            if(used) consume(used);
+            else values[i++] = slow();
+        }
+    }
 
-    void read_next_from_stream();
-    void read_next();
-    
 public:
+    /// \brief The number of bits that can always be inspected using \ref peek_binary.
+    static constexpr size_t PEEK_BITS = WORD_BITS - CHAR_BIT + 1;
+
     /// \brief Constructs a bit input stream.
     /// \param stream the wrapped stream
     BitIStream(std::istream& stream);
 
+    /// \brief Constructs a bit input stream reading directly from memory.
+    ///
+    /// The memory region must stay valid while the stream is in use.
+    ///
+    /// \param data the memory region
+    /// \param size the size of the memory region in bytes
+    BitIStream(const void* data, const size_t size);
+
     BitIStream(const BitIStream&) = delete;
     BitIStream(BitIStream&& other) = default;
     BitIStream& operator=(const BitIStream& other) = delete;
     BitIStream& operator=(BitIStream&& other) = default;
 
     /// \brief Tests whether the end of the input stream has been reached.
-    ///iostream
+    ///
     /// If the underlying stream was not written by a \ref BitOStream, the result may be incorrect and must be replaced by manual handling.
-    inline bool eof() const {
-        // If there are no more bytes, and all bits from the current buffer are read,
-        // we are done
-        return m_is_final && (m_cursor <= (MSB - m_final_bits));
+    inline bool eof() {
+        // the total is known once the last block has been read, which may not have been needed for the loaded word yet
+        if(m_bits_total == SIZE_MAX && m_ptr == m_end) fill_buffer();
+        return m_bits_read >= m_bits_total;
     }
 
     /// \brief Reads a single bit from the stream.
-    bool read_bit();
+    inline bool read_bit() {
+        if(!eof()) {
+            if(!m_word_bits) refill();
+            const bool bit = m_word >> (WORD_BITS - 1);
+            consume(1);
+            return bit;
+        } else {
+            return 0; //EOF
+        }
+    }
 
     /// \brief Reports the number of bits read from the stream.
     inline size_t bits_read() const { return m_bits_read; }
 
+    /// \brief Inspects the next bits without consuming them.
+    ///
+    /// The loaded word is refilled only if it holds fewer bits than requested.
+    /// If fewer bits are left in the stream, the missing low bits are undefined.
+    ///
+    /// \tparam T the type of the value to read
+    /// \param bits the number of bits to inspect, at most \ref PEEK_BITS
+    template<std::integral T = uint64_t>
+    T peek_binary(const size_t bits) {
+        assert(bits <= PEEK_BITS);
+        if(bits > m_word_bits) refill();
+        return bits ? T(m_word >> (WORD_BITS - bits)) : T(0);
+    }
+
+    /// \brief Consumes bits without decoding them.
+    /// \param bits the number of bits to skip
+    void skip(size_t bits) {
+        if(bits <= m_word_bits) {
+            // usual case after peek_binary
+            consume(bits);
+            return;
+        }
+
+        while(bits) {
+            if(!m_word_bits) {
+                refill();
+                if(!m_word_bits) break; // input exhausted
+            }
+
+            const size_t n = std::min(bits, m_word_bits);
+            consume(n);
+            bits -= n;
+        }
+    }
+
     /// \brief Decodes the binary encoding of an integer from the input stream.
     /// \tparam T the type of the value to read
     /// \param bits the number of bits to read; defaults to the byte-aligned size of the value type
@@ -65,69 +194,16 @@ public:
     T read_binary(size_t bits = sizeof(T) * CHAR_BIT) {
         assert(bits <= 64ULL);
 
-        const size_t bits_left_in_current = m_cursor + 1ULL;
-        if(bits < bits_left_in_current) {
-            // we are reading only few bits
-            // simply use the bit-by-bit method
-            T value = T(0);
-            for(size_t i = 0; i < bits; i++) {
-                value <<= T(1);
-                value |= read_bit();
-            }
-            return value;
+        if(bits <= PEEK_BITS) {
+            const uint64_t v = peek_binary(bits);
+            consume(std::min(bits, m_word_bits));
+            return T(v);
         } else {
-            // we are at least consuming the current byte
-            const size_t in_bits = bits;
-
-            bits -= bits_left_in_current;
-            uint64_t v = uint64_t(m_current) & math::bit_mask<uint64_t>(bits_left_in_current);
-            v <<= bits;
-
-            // read as many full bytes as possible
-            if(bits >= 8ULL) {
-                if(bits >= 16ULL) {
-                    // use m_next and then read remaining bytes
-                    const size_t n = (bits / 8ULL) - 1;
-                    bits %= 8ULL;
-
-                    const size_t off = sizeof(size_t) - n;
-
-                    uint64_t v_bytes = 0;
-                    m_stream->read(((char*)&v_bytes) + off, n);
-
-                    // convert full bytes into LITTLE ENDIAN (!) representation
-                    #if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
-                        v_bytes = __builtin_bswap64(v_bytes);
-                    #endif
-
-                    v_bytes |= uint64_t(m_next) << (n * 8ULL);
-                    v |= (v_bytes) << bits;
-
-                    // keep data consistency
-                    read_next_from_stream();
-                } else {
-                    // use m_next
-                    bits -= 8ULL;
-                    assert(!eof());
-                    read_next();
-                    v |= uint64_t(m_current) << bits;
-                }
-            }
-
-            // get next byte
-            read_next();
-
-            // read remaining bits
-            // they (must) be available in the next byte, so just mask them out
-            if(bits) {
-                assert(!eof());
-                assert(bits < 8ULL);
-                v |= (m_current >> (8ULL - bits));
-                m_cursor = MSB - bits;
-            }
-
-            m_bits_read += in_bits;
-            return v;
+            // split into two reads
+            const size_t lo_bits = bits / 2;
+            const uint64_t hi = read_binary<uint64_t>(bits - lo_bits);
+            const uint64_t lo = read_binary<uint64_t>(lo_bits);
+            return T((hi << lo_bits) | lo);
         }
     }
 
@@ -135,9 +211,21 @@ public:
     /// \tparam T the type of the value to read
     template<std::integral T = uint64_t>
     T read_unary() {
-        T v = 0;
-        while(!read_bit()) ++v;
-        return v;
+        uint64_t v = 0;
+        while(!eof()) {
+            if(m_word_bits < PEEK_BITS) refill();
+
+            // count the leading zeros in the loaded bits
+            const size_t z = m_word ? size_t(__builtin_clzll(m_word)) : WORD_BITS;
+            if(z < m_word_bits) {
+                consume(z + 1);
+                return T(v + z);
+            } else {
+                v += m_word_bits;
+                consume(m_word_bits);
+            }
+        }
+        return T(v);
     }
 
     /// \brief Decodes the Elias gamma encoding of an integer from the input stream.
@@ -151,7 +239,7 @@ public:
             return T(1);
         }
     }
-    
+
     /// \brief Decodes the Elias delta encoding of an integer from the input stream.
     /// \tparam T the type of the value to read
     template<std::integral T = uint64_t>
@@ -173,6 +261,78 @@ public:
         const auto r = read_binary<>(p);
         return T(q * (1ULL << p) + r);
     }
+
+    /// \brief Decodes a sequence of binary encoded integers from the input stream.
+    /// \tparam T the type of the values to read
+    /// \param values the span to decode into, its size determines the number of values
+    /// \param bits the number of bits per value; defaults to the byte-aligned size of the value type
+    template<std::integral T>
+    void read_binary(std::span<T> values, const size_t bits = sizeof(T) * CHAR_BIT) {
+        if(bits > PEEK_BITS) {
+            for(auto& v : values) v = read_binary<T>(bits);
+        } else if(bits > 0) {
+            read_codes(values, [bits](const uint64_t w, const size_t avail, uint64_t& v){
+                if(bits > avail) return size_t(0);
+                v = w >> (WORD_BITS - bits);
+                return bits;
+            }, [&](){ return read_binary<T>(bits); });
+        } else {
+            std::fill(values.begin(), values.end(), T(0));
+        }
+    }
+
+    /// \brief Decodes a sequence of Elias gamma encoded integers from the input stream.
+    ///
+    /// Codes are decoded from the loaded bits using the leading zero count, without advancing the stream for each code.
+    ///
+    /// \tparam T the type of the values to read
+    /// \param values the span to decode into, its size determines the number of values
+    template<std::integral T>
+    void read_gamma(std::span<T> values) {
+        read_codes(values, [](const uint64_t w, const size_t avail, uint64_t& v){
+            // the code of a value with m+1 significant bits is its binary representation preceded by m zeros
+            const size_t len = w ? 2 * size_t(__builtin_clzll(w)) + 1 : WORD_BITS + 1;
+            if(len > avail) return size_t(0);
+            v = w >> (WORD_BITS - len);
+            return len;
+        }, [&](){ return read_gamma<T>(); });
+    }
+
+    /// \brief Decodes a sequence of Elias delta encoded integers from the input stream.
+    /// \tparam T the type of the values to read
+    /// \param values the span to decode into, its size determines the number of values
+    template<std::integral T>
+    void read_delta(std::span<T> values) {
+        read_codes(values, [](const uint64_t w, const size_t avail, uint64_t& v){
+            const size_t gamma_len = w ? 2 * size_t(__builtin_clzll(w)) + 1 : WORD_BITS + 1;
+            if(gamma_len > avail) return size_t(0);
+
+            const size_t m = (w >> (WORD_BITS - gamma_len)) - 1;
+            const size_t len = gamma_len + m;
+            if(len > avail) return size_t(0);
+
+            v = m ? ((1ULL << m) | ((w << gamma_len) >> (WORD_BITS - m))) : 1ULL;
+            return len;
+        }, [&](){ return read_delta<T>(); });
+    }
+
+    /// \brief Decodes a sequence of Rice encoded integers from the input stream.
+    /// \tparam T the type of the values to read
+    /// \param values the span to decode into, its size determines the number of values
+    /// \param p the exponent of the Golomb code divisor, which will be <tt>2^p</tt>
+    template<std::integral T>
+    void read_rice(std::span<T> values, const uint8_t p) {
+        read_codes(values, [p](const uint64_t w, const size_t avail, uint64_t& v){
+            const size_t gamma_len = w ? 2 * size_t(__builtin_clzll(w)) + 1 : WORD_BITS + 1;
+            const size_t len = gamma_len + p;
+            if(len > avail) return size_t(0);
+
+            const uint64_t q = (w >> (WORD_BITS - gamma_len)) - 1;
+            const uint64_t r = p ? ((w << gamma_len) >> (WORD_BITS - p)) : 0ULL;
+            v = (q << p) | r;
+            return len;
+        }, [&](){ return read_rice<T>(p); });
+    }
 };
 
 }} // namespace tdc::io
@@ -3,34 +3,51 @@
 #include <cassert>
 #include <climits>
 #include <concepts>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <memory>
 #include <utility>
 
 #include <tdc/math/bit_mask.hpp>
 #include <tdc/math/ilog2.hpp>
+#include <tdc/util/literals.hpp>
 
 namespace tdc {
 namespace io {
 
 /// \brief Wrapper for output streams that provides bitwise writing functionality.
 ///
-/// Bits are written into an internal buffer byte which is written to the output when it is either filled or when the wrapper is destroyed.
+/// Bits are collected in a 64-bit word, which is flushed into a byte buffer once it is full.
+/// The byte buffer is written to the output when it is either filled or when the wrapper is destroyed.
+/// Hence, the underlying stream should not be written to directly while the wrapper is alive.
 class BitOStream {
 private:
+    static constexpr size_t BUFFER_SIZE = 64_Ki;
+
     std::ostream* m_stream;
 
-    uint8_t m_next;
-    int8_t m_cursor;
-    static constexpr int8_t MSB = 7;
+    std::unique_ptr<uint8_t[]> m_buffer;
+    size_t m_buffer_pos;
 
-    size_t m_bits_written = 0;
+    uint64_t m_word;       // pending bits, right-aligned
+    size_t   m_word_bits;  // number of pending bits, always less than 64
 
-    inline bool is_dirty() const {
-        return m_cursor != MSB;
-    }
+    size_t m_bits_written;
 
-    void reset();
-    void write_next();
+    void flush_buffer();
+    void finalize();
+
+    // appends a full word to the byte buffer in big endian order
+    inline void write_word(uint64_t w) {
+        if(m_buffer_pos + sizeof(uint64_t) > BUFFER_SIZE) flush_buffer();
+
+        #if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+            w = __builtin_bswap64(w);
+        #endif
+        std::memcpy(m_buffer.get() + m_buffer_pos, &w, sizeof(uint64_t));
+        m_buffer_pos += sizeof(uint64_t);
+    }
 
 public:
     /// \brief Constructs a bit output stream.
@@ -44,11 +61,13 @@ public:
     ~BitOStream();
 
     BitOStream(const BitOStream&) = delete;
-    BitOStream(BitOStream&& other) = default;
+    BitOStream(BitOStream&& other);
     BitOStream& operator=(const BitOStream& other) = delete;
-    BitOStream& operator=(BitOStream&& other) = default;
+    BitOStream& operator=(BitOStream&& other);
 
     /// \brief Gets the underlying output stream.
+    ///
+    /// Note that buffered bits are not yet contained in it.
     inline std::ostream& stream() {
         return *m_stream;
     }
@@ -60,7 +79,9 @@ public:
 
     /// \brief Writes a single bit to the output stream.
     /// \param b the bit to write
-    void write_bit(bool b);
+    inline void write_bit(const bool b) {
+        write_binary(uint64_t(b), 1);
+    }
 
     /// \brief Writes the binary encoding of an integer to the output stream.
     /// \tparam T the type of the value to write
@@ -69,60 +90,24 @@ public:
     template<std::integral T>
     void write_binary(const T value, size_t bits = sizeof(T) * CHAR_BIT) {
         assert(bits <= 64ULL);
-        assert(m_cursor >= 0);
-        const size_t bits_left_in_next = size_t(m_cursor + 1);
-        assert(bits_left_in_next <= 8ULL);
-
-        if(bits < bits_left_in_next) {
-            // we are writing only few bits
-            // simply use the bit-by-bit method
-            for (int i = bits - 1; i >= 0; i--) {
-                write_bit((value & T(1ULL << i)) != T(0));
-            }
+        if(bits == 0) return;
+
+        const uint64_t v = uint64_t(value) & math::bit_mask<uint64_t>(bits);
+        const size_t free = 64ULL - m_word_bits;
+        if(bits < free) {
+            // the bits fit into the pending word
+            m_word = (m_word << bits) | v;
+            m_word_bits += bits;
         } else {
-            // we are at least finishing the next byte
-            const size_t in_bits = bits;
-
-            // mask low bits of value
-            uint64_t v = uint64_t(value) & math::bit_mask<uint64_t>(bits);
-
-            // fill it up next byte and continue with remaining bits
-            bits -= bits_left_in_next;
-            m_next |= (v >> bits);
-            write_next();
-
-            v &= math::bit_mask<uint64_t>(bits); // mask remaining bits
-
-            // write as many full bytes as possible
-            if(bits >= 8ULL) {
-                const size_t n = bits / 8ULL;
-                bits %= 8ULL;
-
-                // convert full bytes into BIG ENDIAN (!) representation
-                #if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
-                    const size_t v_bytes = __builtin_bswap64(v >> bits);
-                #else
-                    const size_t v_bytes = v >> bits;
-                #endif
-
-                const size_t off  = sizeof(size_t) - n;
-                m_stream->write(((const char*)&v_bytes) + off, n);
-
-                v &= math::bit_mask<uint64_t>(bits); // mask remaining bits
-            }
-
-            if(bits) {
-                // write remaining bits
-                // they (must) fit into the next byte, so just stuff them in
-                assert(bits < 8ULL);
-                assert(v < 256ULL);
-                m_next = (v << (8ULL - bits));
-                m_cursor = MSB - int8_t(bits);
-                assert(m_cursor >= 0);
-            }
-
-            m_bits_written += in_bits;
+            // fill up the word, flush it and keep the remaining bits
+            const size_t rest = bits - free;
+            const uint64_t w = (m_word_bits ? (m_word << free) : 0ULL) | (v >> rest);
+            write_word(w);
+
+            m_word = v & math::bit_mask<uint64_t>(rest);
+            m_word_bits = rest;
         }
+        m_bits_written += bits;
     }
 
     /// \brief Writes the unary encoding of an integer to the output stream.
@@ -133,10 +118,12 @@ public:
     /// \param value the value to write
     template<std::integral T>
     void write_unary(T value) {
-        while(value--) {
-            write_bit(0);
+        uint64_t x = uint64_t(value);
+        while(x >= 64ULL) {
+            write_binary(uint64_t(0), 64);
+            x -= 64ULL;
         }
-        write_bit(1);
+        write_binary(uint64_t(1), x + 1);
     }
 
     /// \brief Writes the Elias gamma code for an integer to the output stream.
@@ -147,9 +134,14 @@ public:
     void write_gamma(T value) {
         assert(value > T(0));
 
-        const auto m = math::ilog2_floor(value);
-        write_unary(m);
-        if(m > 0) write_binary(value, m); // cut off leading 1
+        const size_t m = math::ilog2_floor(value);
+        if(2 * m + 1 <= 64ULL) {
+            // the code is the binary representation of the value preceded by m zeros
+            write_binary(value, 2 * m + 1);
+        } else {
+            write_unary(m);
+            write_binary(value, m); // cut off leading 1
+        }
     }
 
     /// \brief Writes the Elias delta code for an integer to the output stream.
@@ -175,8 +167,15 @@ public:
     void write_rice(T value, const uint8_t p) {
         const uint64_t q = uint64_t(value) >> p;
 
-        write_gamma(q + 1);
-        write_binary(value, p); // r is exactly the lowest p bits of v
+        const size_t gamma_len = 2 * math::ilog2_floor(q + 1) + 1;
+        if(gamma_len + p <= 64ULL) {
+            // write both parts at once
+            const uint64_t r = uint64_t(value) & math::bit_mask<uint64_t>(p);
+            write_binary(((q + 1) << p) | r, gamma_len + p);
+        } else {
+            write_gamma(q + 1);
+            write_binary(value, p); // r is exactly the lowest p bits of v
+        }
     }
 };
 
@@ -1,43 +1,64 @@
 #pragma once
 
+#include <algorithm>
+#include <cassert>
+#include <cstring>
 #include <iostream>
+#include <memory>
+
+#include "input_source.hpp"
 
 namespace tdc {
 namespace io {
 
+/// \brief Reads items one at a time from an \ref InputSource.
+///
+/// Items are read directly from the chunks of the input source, so memory backed inputs are not copied.
 template<typename item_t>
 class BufferedReader {
 private:
-    std::istream* m_stream;
-    item_t* m_buffer;
+    std::unique_ptr<InputSource> m_owned_source;
+    InputSource* m_source;
     size_t m_bufsize_bytes;
-    
+
+    const item_t* m_buffer;
     size_t m_count;
     size_t m_cursor;
-    bool m_good;
-    
+
     bool underflow() {
-        // underflow
-        m_stream->read((char*)m_buffer, m_bufsize_bytes);
-        m_count = m_stream->gcount() / sizeof(item_t);
+        // memory backed inputs are read in one chunk
+        const auto chunk = m_source->next(m_source->is_memory() ? SIZE_MAX : m_bufsize_bytes);
+        m_buffer = (const item_t*)chunk.data();
+        m_count = chunk.size() / sizeof(item_t);
         m_cursor = 0;
         return m_count > 0;
     }
 
 public:
-    BufferedReader(std::istream& stream, const size_t bufsize) : m_stream(&stream), m_bufsize_bytes(bufsize * sizeof(item_t)) {
-        m_buffer = new item_t[bufsize];
+    /// \brief Constructs a reader for an input source.
+    /// \param source the input source
+    /// \param bufsize the number of items to read at once from streams
+    BufferedReader(InputSource& source, const size_t bufsize) : m_source(&source), m_bufsize_bytes(bufsize * sizeof(item_t)) {
         underflow();
     }
-    
-    ~BufferedReader() {
-        delete[] m_buffer;
+
+    /// \brief Constructs a reader for a stream.
+    /// \param stream the stream
+    /// \param bufsize the number of items to buffer
+    BufferedReader(std::istream& stream, const size_t bufsize)
+        : m_owned_source(std::make_unique<InputSource>(stream, bufsize * sizeof(item_t))),
+          m_source(m_owned_source.get()),
+          m_bufsize_bytes(bufsize * sizeof(item_t)) {
+        underflow();
     }
-    
+
+    BufferedReader(const BufferedReader&) = delete;
+    BufferedReader& operator=(const BufferedReader&) = delete;
+
     operator bool() {
         return (m_cursor < m_count) ? true : underflow();
     }
-    
+
     item_t read() {
         if(m_cursor >= m_count) {
             underflow();
@@ -48,14 +69,16 @@ public:
 
     size_t read(item_t* buffer, const size_t num) {
         size_t rnum = 0;
-        for(size_t i = 0; i < num; i++) {
+        while(rnum < num) {
             if(m_cursor >= m_count) {
                 const bool read_more = underflow();
                 if(!read_more) break;
             }
 
-            buffer[i] = m_buffer[m_cursor++];
-            ++rnum;
+            const size_t k = std::min(num - rnum, m_count - m_cursor);
+            std::memcpy(buffer + rnum, m_buffer + m_cursor, k * sizeof(item_t));
+            m_cursor += k;
+            rnum += k;
         }
         return rnum;
     }
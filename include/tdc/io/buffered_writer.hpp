@@ -15,7 +15,7 @@ private:
     size_t m_cursor;
 
 public:
-    BufferedWriter(std::ostream& stream, const size_t bufsize) : m_cursor(0), m_stream(&stream), m_bufsize(bufsize) {
+    BufferedWriter(std::ostream& stream, const size_t bufsize) : m_stream(&stream), m_bufsize(bufsize), m_cursor(0) {
         m_buffer = new item_t[bufsize];
     }
     
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "background_worker.hpp"
+#include "io_uring.hpp"
+
+namespace tdc {
+namespace io {
+
+/// \brief Reads a file sequentially in blocks, keeping a configurable number of reads ahead in flight.
+///
+/// Blocks are read into a ring of aligned buffers using \c io_uring if available, each consumed buffer being resubmitted for a block ahead.
+/// Without \c io_uring, blocks are read on a \ref BackgroundWorker, which keeps one block ahead.
+/// With direct I/O, the page cache is bypassed, which is useful for scans of files that are much larger than the memory.
+///
+/// Read errors are reported by throwing a \c std::system_error.
+class FileBlockReader {
+public:
+    /// \brief The alignment of buffers, block sizes and file offsets, as required for direct I/O.
+    static constexpr size_t ALIGNMENT = 4096;
+
+private:
+    int m_fd;
+    size_t m_file_size;
+    size_t m_block_size;
+    size_t m_num_blocks;
+    size_t m_depth;
+    bool m_direct;
+
+    std::vector<char*> m_buffers;
+    std::vector<int64_t> m_results;
+    std::vector<bool> m_done;
+    size_t m_current; // the block returned by the last call to next
+    bool m_started;
+    size_t m_in_flight;      // io_uring requests not completed yet
+    size_t m_last_submitted; // the last block submitted to the worker
+
+    std::unique_ptr<IoUring> m_ring;
+    std::unique_ptr<BackgroundWorker> m_worker;
+
+    void submit(size_t block);
+    void wait(size_t block);
+
+public:
+    /// \brief Opens a file for reading.
+    ///
+    /// If direct I/O is not supported for the file, it is read via the page cache.
+    ///
+    /// \param filename the name of the file
+    /// \param block_size the minimum number of bytes per block, which is rounded up to a multiple of \ref ALIGNMENT
+    /// \param queue_depth the number of blocks being read ahead
+    /// \param direct whether to bypass the page cache (\c O_DIRECT)
+    /// \param backend the I/O backend
+    FileBlockReader(const std::string& filename, size_t block_size, size_t queue_depth = 4, bool direct = false, FileBackend backend = FileBackend::automatic);
+
+    ~FileBlockReader();
+
+    FileBlockReader(const FileBlockReader&) = delete;
+    FileBlockReader& operator=(const FileBlockReader&) = delete;
+
+    /// \brief Returns the next block of the file, which stays valid until the next call.
+    /// \return the next block, or an empty block at the end of the file
+    std::string_view next();
+
+    /// \brief The size of the file in bytes.
+    inline size_t file_size() const { return m_file_size; }
+
+    /// \brief The number of bytes per block.
+    inline size_t block_size() const { return m_block_size; }
+
+    /// \brief The backend in use, either \ref FileBackend::io_uring or \ref FileBackend::thread.
+    inline FileBackend backend() const { return m_ring ? FileBackend::io_uring : FileBackend::thread; }
+
+    /// \brief Tests whether the page cache is bypassed.
+    inline bool is_direct() const { return m_direct; }
+};
+
+/// \brief Reads items one at a time from a file, with the same interface as the \ref BufferedReader.
+///
+/// The file is read ahead asynchronously by a \ref FileBlockReader, and trailing bytes that do not form a whole item are ignored.
+template<typename item_t>
+class FileReader {
+private:
+    static_assert(std::is_trivially_copyable_v<item_t>);
+
+    static size_t block_size(const size_t bufsize) {
+        const size_t unit = std::lcm(FileBlockReader::ALIGNMENT, sizeof(item_t));
+        const size_t bytes = std::max(bufsize, size_t(1)) * sizeof(item_t);
+        return ((bytes + unit - 1) / unit) * unit;
+    }
+
+    FileBlockReader m_blocks;
+
+    const item_t* m_buffer;
+    size_t m_count;
+    size_t m_cursor;
+
+    bool underflow() {
+        const auto block = m_blocks.next();
+        m_buffer = (const item_t*)block.data();
+        m_count = block.size() / sizeof(item_t);
+        m_cursor = 0;
+        return m_count > 0;
+    }
+
+public:
+    /// \brief Opens a file for reading.
+    /// \param filename the name of the file
+    /// \param bufsize the minimum number of items to read at once
+    /// \param queue_depth the number of buffers being read ahead
+    /// \param direct whether to bypass the page cache
+    /// \param backend the I/O backend
+    FileReader(const std::string& filename, const size_t bufsize, const size_t queue_depth = 4, const bool direct = false, const FileBackend backend = FileBackend::automatic)
+        : m_blocks(filename, block_size(bufsize), queue_depth, direct, backend), m_buffer(nullptr), m_count(0), m_cursor(0) {
+        underflow();
+    }
+
+    FileReader(const FileReader&) = delete;
+    FileReader& operator=(const FileReader&) = delete;
+
+    /// \brief The backend in use.
+    FileBackend backend() const { return m_blocks.backend(); }
+
+    /// \brief Tests whether the page cache is bypassed.
+    bool is_direct() const { return m_blocks.is_direct(); }
+
+    operator bool() {
+        return (m_cursor < m_count) ? true : underflow();
+    }
+
+    item_t read() {
+        if(m_cursor >= m_count) {
+            underflow();
+        }
+        assert(m_cursor < m_count);
+        return m_buffer[m_cursor++];
+    }
+
+    size_t read(item_t* buffer, const size_t num) {
+        size_t rnum = 0;
+        while(rnum < num) {
+            if(m_cursor >= m_count) {
+                const bool read_more = underflow();
+                if(!read_more) break;
+            }
+
+            const size_t k = std::min(num - rnum, m_count - m_cursor);
+            std::memcpy(buffer + rnum, m_buffer + m_cursor, k * sizeof(item_t));
+            m_cursor += k;
+            rnum += k;
+        }
+        return rnum;
+    }
+};
+
+}} // namespace tdc::io
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "background_worker.hpp"
+#include "io_uring.hpp"
+
+namespace tdc {
+namespace io {
+
+/// \brief Writes a file sequentially in blocks, keeping a configurable number of writes in flight.
+///
+/// Blocks are filled in a ring of aligned buffers. Using \c io_uring if available, full blocks are submitted to the kernel in batches
+/// and a buffer is only waited for when it is needed again.
+/// Without \c io_uring, blocks are written on a \ref BackgroundWorker while the next block is filled.
+/// With direct I/O, the page cache is bypassed; the last block is then padded and the file is truncated to its actual size.
+///
+/// Write errors are reported by throwing a \c std::system_error.
+class FileBlockWriter {
+public:
+    /// \brief The alignment of buffers, block sizes and file offsets, as required for direct I/O.
+    static constexpr size_t ALIGNMENT = 4096;
+
+private:
+    int m_fd;
+    size_t m_block_size;
+    size_t m_depth;
+    size_t m_batch;
+    bool m_direct;
+
+    std::vector<char*> m_buffers;
+    std::vector<bool> m_busy;
+    std::vector<size_t> m_lengths;
+    std::vector<uint64_t> m_offsets;
+    size_t m_current; // the block being filled
+    uint64_t m_offset; // the file offset of the block being filled
+    size_t m_in_flight;
+
+    std::unique_ptr<IoUring> m_ring;
+    std::unique_ptr<BackgroundWorker> m_worker;
+
+    void write(size_t slot, size_t length);
+    void reap(unsigned min_complete);
+    void wait_all();
+
+public:
+    /// \brief Creates or truncates a file for writing.
+    ///
+    /// If direct I/O is not supported for the file, it is written via the page cache.
+    ///
+    /// \param filename the name of the file
+    /// \param block_size the minimum number of bytes per block, which is rounded up to a multiple of \ref ALIGNMENT
+    /// \param queue_depth the number of blocks that can be in flight
+    /// \param direct whether to bypass the page cache (\c O_DIRECT)
+    /// \param backend the I/O backend
+    FileBlockWriter(const std::string& filename, size_t block_size, size_t queue_depth = 4, bool direct = false, FileBackend backend = FileBackend::automatic);
+
+    /// \brief Waits for pending writes and closes the file.
+    ///
+    /// Data in the current block that has not been passed to \ref sync is discarded.
+    ~FileBlockWriter();
+
+    FileBlockWriter(const FileBlockWriter&) = delete;
+    FileBlockWriter& operator=(const FileBlockWriter&) = delete;
+
+    /// \brief The buffer of the block being filled, which holds \ref block_size bytes.
+    inline char* buffer() { return m_buffers[m_current % m_depth]; }
+
+    /// \brief Writes the full current block and proceeds to the next one.
+    void commit();
+
+    /// \brief Writes the first bytes of the current block and waits until all writes have completed.
+    ///
+    /// The current block keeps its contents, so it can be filled further and written again.
+    ///
+    /// \param num the number of bytes of the current block to write
+    void sync(size_t num);
+
+    /// \brief The number of bytes per block.
+    inline size_t block_size() const { return m_block_size; }
+
+    /// \brief The backend in use, either \ref FileBackend::io_uring or \ref FileBackend::thread.
+    inline FileBackend backend() const { return m_ring ? FileBackend::io_uring : FileBackend::thread; }
+
+    /// \brief Tests whether the page cache is bypassed.
+    inline bool is_direct() const { return m_direct; }
+};
+
+/// \brief Writes items one at a time to a file, with the same interface as the \ref BufferedWriter.
+///
+/// Full buffers are written asynchronously by a \ref FileBlockWriter.
+/// Since the destructor cannot report write errors, \ref flush should be called when all items have been written.
+template<typename item_t>
+class FileWriter {
+private:
+    static_assert(std::is_trivially_copyable_v<item_t>);
+
+    static size_t block_size(const size_t bufsize) {
+        const size_t unit = std::lcm(FileBlockWriter::ALIGNMENT, sizeof(item_t));
+        const size_t bytes = std::max(bufsize, size_t(1)) * sizeof(item_t);
+        return ((bytes + unit - 1) / unit) * unit;
+    }
+
+    FileBlockWriter m_blocks;
+
+    item_t* m_buffer;
+    size_t m_capacity;
+    size_t m_cursor;
+
+public:
+    /// \brief Creates or truncates a file for writing.
+    /// \param filename the name of the file
+    /// \param bufsize the minimum number of items to write at once
+    /// \param queue_depth the number of buffers that can be in flight
+    /// \param direct whether to bypass the page cache
+    /// \param backend the I/O backend
+    FileWriter(const std::string& filename, const size_t bufsize, const size_t queue_depth = 4, const bool direct = false, const FileBackend backend = FileBackend::automatic)
+        : m_blocks(filename, block_size(bufsize), queue_depth, direct, backend),
+          m_buffer((item_t*)m_blocks.buffer()),
+          m_capacity(m_blocks.block_size() / sizeof(item_t)),
+          m_cursor(0) {
+    }
+
+    /// \brief Writes all buffered items to the file, ignoring any errors, and closes it.
+    ~FileWriter() {
+        try {
+            flush();
+        } catch(...) {
+        }
+    }
+
+    FileWriter(const FileWriter&) = delete;
+    FileWriter& operator=(const FileWriter&) = delete;
+
+    /// \brief The backend in use.
+    FileBackend backend() const { return m_blocks.backend(); }
+
+    /// \brief Tests whether the page cache is bypassed.
+    bool is_direct() const { return m_blocks.is_direct(); }
+
+    /// \brief Writes an item.
+    ///
+    /// \throws std::system_error if a previous block could not be written
+    void write(item_t x) {
+        if(m_cursor >= m_capacity) {
+            m_blocks.commit();
+            m_buffer = (item_t*)m_blocks.buffer();
+            m_cursor = 0;
+        }
+        m_buffer[m_cursor++] = x;
+    }
+
+    /// \brief Writes all buffered items to the file and waits until they have been written.
+    ///
+    /// \throws std::system_error if an item could not be written
+    void flush() {
+        m_blocks.sync(m_cursor * sizeof(item_t));
+    }
+};
+
+}} // namespace tdc::io
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "mmap_file.hpp"
+
+namespace tdc {
+namespace io {
+
+/// \brief An input that is read in contiguous chunks, backed by memory, a memory mapped file or a stream.
+///
+/// Memory backed inputs are read in place, i.e., chunks are views of the underlying memory and no data is copied.
+/// Streams are read into an internal buffer.
+class InputSource {
+private:
+    std::unique_ptr<MMapReadOnlyFile> m_file;
+    std::unique_ptr<std::istream> m_owned_stream;
+
+    // memory backed input
+    const char* m_data;
+    size_t m_size;
+
+    // stream backed input
+    std::istream* m_stream;
+    std::vector<char> m_buffer;
+    size_t m_bufsize;
+
+    size_t m_pos;
+
+public:
+    /// \brief The default buffer size for streams.
+    static constexpr size_t DEFAULT_BUFSIZE = 1ULL << 20;
+
+    /// \brief Opens a file, which is mapped to memory if possible and read as a stream otherwise.
+    /// \param filename the name of the file
+    explicit InputSource(const std::string& filename);
+
+    /// \brief Reads a memory mapped file in place, which must remain mapped while reading.
+    /// \param file the memory mapped file
+    explicit InputSource(const MMapReadOnlyFile& file);
+
+    /// \brief Reads memory in place.
+    /// \param data the memory
+    /// \param size the number of bytes
+    InputSource(const void* data, const size_t size);
+
+    /// \brief Reads a stream using an internal buffer.
+    /// \param stream the stream
+    /// \param bufsize the maximum chunk size
+    explicit InputSource(std::istream& stream, const size_t bufsize = DEFAULT_BUFSIZE);
+
+    InputSource(const InputSource&) = delete;
+    InputSource(InputSource&&) = default;
+    InputSource& operator=(const InputSource&) = delete;
+    InputSource& operator=(InputSource&&) = default;
+
+    /// \brief Tests whether the input is read in place.
+    inline bool is_memory() const {
+        return m_stream == nullptr;
+    }
+
+    /// \brief The total number of bytes of a memory backed input, or \c SIZE_MAX for streams.
+    inline size_t size() const {
+        return is_memory() ? m_size : SIZE_MAX;
+    }
+
+    /// \brief The number of bytes read so far.
+    inline size_t pos() const {
+        return m_pos;
+    }
+
+    /// \brief Tests whether the input has been read completely.
+    ///
+    /// For streams, this only becomes true once a read has reached the end of the stream.
+    inline bool eof() const {
+        return is_memory() ? m_pos >= m_size : !m_stream->good();
+    }
+
+    /// \brief Reads the next chunk of input.
+    ///
+    /// The returned view is valid until the next read.
+    ///
+    /// \param max the maximum number of bytes to read
+    /// \return a view of up to \c max bytes, which is empty if and only if the input has been read completely
+    std::string_view next(const size_t max = SIZE_MAX);
+
+    /// \brief Reads the remaining input as a single chunk.
+    ///
+    /// For memory backed inputs, this is a view of the underlying memory.
+    /// Streams are read entirely into the internal buffer.
+    /// The returned view is valid until the next read.
+    std::string_view all();
+
+    /// \brief Copies input into a buffer.
+    ///
+    /// This is meant for consumers that need to modify the data or keep it across reads.
+    /// Streams are read directly into the buffer.
+    ///
+    /// \param buffer the buffer
+    /// \param num the number of bytes to read
+    /// \return the number of bytes read, which is less than \c num only at the end of the input
+    size_t read(void* buffer, const size_t num);
+};
+
+}} // namespace tdc::io
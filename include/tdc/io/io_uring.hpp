@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <sys/uio.h>
+
+namespace tdc {
+namespace io {
+
+/// \brief The I/O backend of a \ref FileReader or \ref FileWriter.
+enum class FileBackend {
+    /// \brief Use \c io_uring if available, and a background thread otherwise.
+    automatic,
+    /// \brief Use \c io_uring.
+    io_uring,
+    /// \brief Use a background thread with blocking reads and writes.
+    thread
+};
+
+/// \brief A minimal Linux \c io_uring instance for asynchronous reads and writes, using the system calls directly.
+///
+/// Requests are prepared in the submission queue and passed to the kernel in batches by \ref submit, which can also wait for completions.
+/// If the kernel does not support \c io_uring, or it is prohibited, the instance is not \ref ok.
+class IoUring {
+private:
+    int m_fd;
+    unsigned m_entries;
+
+    void* m_sq_ring;
+    size_t m_sq_ring_size;
+    void* m_cq_ring;
+    size_t m_cq_ring_size;
+    void* m_sqes;
+    size_t m_sqes_size;
+
+    unsigned* m_sq_head;
+    unsigned* m_sq_tail;
+    unsigned* m_sq_mask;
+    unsigned* m_sq_array;
+    unsigned* m_cq_head;
+    unsigned* m_cq_tail;
+    unsigned* m_cq_mask;
+    void* m_cqes;
+
+    unsigned m_local_tail; // the tail including prepared requests that have not been passed to the kernel yet
+    unsigned m_num_prepared;
+    bool m_registered;
+
+    void prepare(uint8_t opcode, int fd, const void* buffer, unsigned length, uint64_t offset, int buffer_index, uint64_t user_data);
+
+public:
+    /// \brief Sets up an instance.
+    /// \param entries the number of submission queue entries, i.e., the maximum number of requests that can be prepared at once
+    explicit IoUring(unsigned entries);
+
+    /// \brief Releases the instance, which must not have any pending requests.
+    ~IoUring();
+
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    /// \brief Tests whether the instance has been set up successfully.
+    inline bool ok() const { return m_fd >= 0; }
+
+    /// \brief Tests whether buffers have been registered.
+    inline bool has_registered_buffers() const { return m_registered; }
+
+    /// \brief The number of prepared requests that have not been submitted yet.
+    inline unsigned num_prepared() const { return m_num_prepared; }
+
+    /// \brief Registers buffers with the kernel, which saves mapping them for each request.
+    ///
+    /// Registration may fail, e.g., due to the locked memory limit, in which case requests must not use buffer indices.
+    ///
+    /// \param buffers the buffers
+    /// \param num the number of buffers
+    /// \return whether the buffers have been registered
+    bool register_buffers(const struct iovec* buffers, unsigned num);
+
+    /// \brief Prepares a read request, which is passed to the kernel by the next \ref submit.
+    /// \param fd the file descriptor
+    /// \param buffer the buffer to read into
+    /// \param length the number of bytes to read
+    /// \param offset the file offset
+    /// \param buffer_index the index of the registered buffer, or -1
+    /// \param user_data the value identifying the completion
+    /// \return whether the request could be prepared, which fails if the submission queue is full
+    bool prepare_read(int fd, void* buffer, unsigned length, uint64_t offset, int buffer_index, uint64_t user_data);
+
+    /// \brief Prepares a write request, which is passed to the kernel by the next \ref submit.
+    /// \param fd the file descriptor
+    /// \param buffer the buffer to write from
+    /// \param length the number of bytes to write
+    /// \param offset the file offset
+    /// \param buffer_index the index of the registered buffer, or -1
+    /// \param user_data the value identifying the completion
+    /// \return whether the request could be prepared, which fails if the submission queue is full
+    bool prepare_write(int fd, const void* buffer, unsigned length, uint64_t offset, int buffer_index, uint64_t user_data);
+
+    /// \brief Passes all prepared requests to the kernel with a single system call and waits for completions.
+    ///
+    /// If there are no prepared requests and no completions are awaited, no system call is made.
+    ///
+    /// \param min_complete the minimum number of completions to wait for
+    /// \return zero on success, or the negated error number
+    int submit(unsigned min_complete = 0);
+
+    /// \brief Retrieves a completion, if any.
+    /// \param user_data receives the value identifying the request
+    /// \param result receives the result of the request, i.e., the number of bytes transferred or the negated error number
+    /// \return whether a completion has been retrieved
+    bool pop(uint64_t& user_data, int32_t& result);
+};
+
+}} // namespace tdc::io
@@ -1,16 +1,105 @@
 #pragma once
 
+#include <tdc/io/mmap_file.hpp>
 #include <tdc/util/concepts.hpp>
 #include <tdc/util/literals.hpp>
+#include <tdc/util/parallel_for.hpp>
 
+#include <algorithm>
+#include <bit>
 #include <climits>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <memory>
+#include <system_error>
+#include <thread>
 #include <vector>
 
 namespace tdc {
 namespace io {
 
+/// \cond INTERNAL
+namespace internal {
+
+// the minimum number of bytes worth spawning a thread for
+constexpr size_t LOAD_BYTES_PER_THREAD = 1_Mi;
+
+inline size_t load_threads(const size_t num_threads, const size_t num_bytes) {
+    const size_t max_threads = num_threads ? num_threads : std::max(1U, std::thread::hardware_concurrency());
+    return std::max(size_t(1), std::min(max_threads, num_bytes / LOAD_BYTES_PER_THREAD));
+}
+
+inline std::unique_ptr<MMapReadOnlyFile> map_file(const std::filesystem::path& path) {
+    auto file = std::make_unique<MMapReadOnlyFile>(path.string());
+    if(file->error()) throw std::system_error(file->error(), std::generic_category(), path.string());
+    file->advise(MMapAdvice::will_need);
+    return file;
+}
+
+// parses a decimal integer like atoll, but without the overhead of a locale or a null terminator
+inline uint64_t parse_uint(const char* p, const char* end) {
+    while(p < end && (*p == ' ' || *p == '\t')) ++p;
+
+    const bool negative = (p < end && *p == '-');
+    if(p < end && (*p == '-' || *p == '+')) ++p;
+
+    uint64_t x = 0;
+    for(; p < end && *p >= '0' && *p <= '9'; ++p) {
+        x = 10 * x + (*p - '0');
+    }
+    return negative ? -x : x;
+}
+
+// calls f for each non-empty line in [p, end)
+template<typename F>
+inline void for_each_line(const char* p, const char* end, F f) {
+    while(p < end) {
+        const char* eol = (const char*)std::memchr(p, '\n', end - p);
+        if(!eol) eol = end;
+        if(eol > p) f(p, eol);
+        p = eol + 1;
+    }
+}
+
+}
+/// \endcond
+
+/// \brief A read-only view on a binary file of items, which is mapped to memory rather than loaded.
+///
+/// If the file cannot be opened or mapped, a \c std::system_error is thrown.
+///
+/// \tparam T the item type
+template<typename T>
+class MappedVector {
+private:
+    std::unique_ptr<MMapReadOnlyFile> m_file;
+    const T* m_data;
+    size_t m_size;
+
+public:
+    /// \brief Maps a file to memory.
+    /// \param path the path to the file
+    inline MappedVector(const std::filesystem::path& path)
+        : m_file(internal::map_file(path)), m_data((const T*)m_file->data()), m_size(m_file->size() / sizeof(T)) {
+    }
+
+    /// \brief The number of items.
+    inline size_t size() const { return m_size; }
+
+    /// \brief Pointer to the items.
+    inline const T* data() const { return m_data; }
+
+    /// \brief Reads an item.
+    inline const T& operator[](const size_t i) const { return m_data[i]; }
+
+    /// \brief STL-like iterator to the beginning of the items.
+    inline const T* begin() const { return m_data; }
+
+    /// \brief STL-like iterator to the end of the items.
+    inline const T* end() const { return m_data + m_size; }
+};
+
 /// \brief Loads a binary file into an integer vector.
 /// \tparam in_t the input type, which determines the number of bytes read for each integer
 /// \tparam out_t the output type
@@ -30,16 +119,17 @@ inline out_vector_t load_file_as_vector(
 
     {
         std::ifstream f(path);
-        size_t i = 0;
+        size_t offset = 0;
         size_t left = num_items;
         while(left) {
             const size_t num = std::min(bufsize, left);
             f.read((char*)buffer, num * sizeof(in_t));
 
             for(size_t i = 0; i < num; i++) {
-                v[i++] = (out_t)buffer[i];
+                v[offset + i] = (out_t)buffer[i];
             }
 
+            offset += num;
             left -= num;
         }
     }
@@ -48,21 +138,96 @@ inline out_vector_t load_file_as_vector(
     return v;
 }
 
+/// \brief Loads a binary file into an integer vector using multiple threads.
+///
+/// The file is mapped to memory and its items are converted in contiguous chunks, one per thread.
+/// If the output vector is bit-packed, i.e., it has a \c width and a constructor accepting the size, width and initialization flag
+/// like \ref vec::IntVector, the width is chosen as the bit width of the largest item.
+/// Chunks consist of multiples of 64 items, so that threads never write to the same words.
+/// If no conversion is needed, \ref MappedVector allows for accessing the file without copying.
+///
+/// \tparam in_t the input type, which determines the number of bytes read for each integer
+/// \tparam out_t the output type
+/// \tparam out_vector_t the output vector type, must support a constructor accepting the size
+/// \param path the path to the file to read
+/// \param num_threads the maximum number of threads, or zero to use all hardware threads
+template<typename in_t, typename out_t = in_t, SizedIndexAccess out_vector_t = std::vector<out_t>>
+inline out_vector_t load_file_as_vector_parallel(const std::filesystem::path& path, const size_t num_threads = 0) {
+    MappedVector<in_t> in(path);
+    const size_t num_items = in.size();
+    const size_t num_groups = (num_items + 63ULL) / 64ULL;
+    const size_t threads = internal::load_threads(num_threads, num_items * sizeof(in_t));
+
+    auto for_each_chunk = [&](auto f){
+        parallel_for(num_groups, threads, [&](const size_t begin, const size_t end, const size_t t){
+            f(begin * 64ULL, std::min(size_t(end * 64ULL), num_items), t);
+        });
+    };
+
+    out_vector_t v = [&](){
+        if constexpr(requires(out_vector_t x) { { x.width() } -> std::unsigned_integral; }) {
+            std::vector<uint64_t> chunk_max(threads, 0);
+            for_each_chunk([&](const size_t begin, const size_t end, const size_t t){
+                uint64_t max = 0;
+                for(size_t i = begin; i < end; i++) max = std::max(max, uint64_t((out_t)in[i]));
+                chunk_max[t] = max;
+            });
+
+            const uint64_t max = *std::max_element(chunk_max.begin(), chunk_max.end());
+            return out_vector_t(num_items, std::max(size_t(1), size_t(std::bit_width(max))), false);
+        } else {
+            return out_vector_t(num_items);
+        }
+    }();
+
+    for_each_chunk([&](const size_t begin, const size_t end, const size_t){
+        for(size_t i = begin; i < end; i++) {
+            v[i] = (out_t)in[i];
+        }
+    });
+    return v;
+}
+
 /// \brief Loads a text file into an integer vector by parsing each line as an integer value.
+///
+/// The file is mapped to memory and parsed by multiple threads, each handling a contiguous range of lines.
+/// Empty lines are skipped.
+///
 /// \tparam out_t the output type
-/// \tparam out_vector_t the output vector type, must support \c push_back
+/// \tparam out_vector_t the output vector type, must support a constructor accepting the size
 /// \param path the path to the file to read
+/// \param num_threads the maximum number of threads, or zero to use all hardware threads
 template<typename out_t, VectorCompilant<out_t> out_vector_t = std::vector<out_t>>
-inline out_vector_t load_file_lines_as_vector(const std::filesystem::path& path) {
-    out_vector_t v;
-    std::ifstream f(path);
-
-    // 2^64 has 20 decimal digits, so a buffer of size 24 should be safe
-    for(std::array<char, 24> linebuf; f.getline(&linebuf[0], 24);) {
-        if(linebuf[0]) {
-            v.push_back((out_t)uint64_t(std::atoll(&linebuf[0])));
-        }
+inline out_vector_t load_file_lines_as_vector(const std::filesystem::path& path, const size_t num_threads = 0) {
+    MappedVector<char> text(path);
+    const size_t n = text.size();
+    const size_t threads = internal::load_threads(num_threads, n);
+
+    // split the text into chunks of whole lines
+    std::vector<size_t> chunk_begin(threads + 1, n);
+    for(size_t t = 0; t < threads; t++) {
+        size_t begin = std::max(t * (n / threads), t > 0 ? chunk_begin[t - 1] : 0);
+        while(begin > 0 && begin < n && text[begin - 1] != '\n') ++begin;
+        chunk_begin[t] = begin;
     }
+
+    // count the lines in each chunk to determine where to write their values
+    std::vector<size_t> offsets(threads + 1, 0);
+    parallel_for(threads, threads, [&](const size_t t, const size_t, const size_t){
+        size_t num = 0;
+        internal::for_each_line(text.data() + chunk_begin[t], text.data() + chunk_begin[t + 1], [&](const char*, const char*){ ++num; });
+        offsets[t + 1] = num;
+    });
+    for(size_t t = 0; t < threads; t++) offsets[t + 1] += offsets[t];
+
+    // parse
+    out_vector_t v(offsets[threads]);
+    parallel_for(threads, threads, [&](const size_t t, const size_t, const size_t){
+        size_t i = offsets[t];
+        internal::for_each_line(text.data() + chunk_begin[t], text.data() + chunk_begin[t + 1], [&](const char* line, const char* eol){
+            v[i++] = (out_t)internal::parse_uint(line, eol);
+        });
+    });
     return v;
 }
 
@@ -1,30 +1,168 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace tdc {
 namespace io {
 
-/// \brief A memory mapped read-only file.
+/// \brief Access pattern hints for memory mapped files, passed to \c madvise.
+enum class MMapAdvice {
+    /// \brief No particular access pattern.
+    normal,
+    /// \brief Pages are accessed in sequential order, so they may be read ahead aggressively and freed soon after access.
+    sequential,
+    /// \brief Pages are accessed in random order, so reading ahead is useless.
+    random,
+    /// \brief Pages will be accessed soon, so they should be read ahead now.
+    will_need,
+    /// \brief Transparent huge pages should be used for the mapping, which may not be supported for files.
+    huge_page
+};
+
+/// \brief A memory mapped read-only file, or a window of it.
+///
+/// Files larger than the address space that can be spared can be mapped in windows, which can be moved via \ref map.
+/// If the file cannot be opened or mapped, or if the window is empty, \ref data is \c nullptr and \ref error tells why.
 class MMapReadOnlyFile {
 private:
     int m_fd;
+    int m_error;
+    bool m_populate;
+
+    size_t m_file_size;
+    void* m_base; // page aligned start of the mapping
+    size_t m_base_size;
     void* m_data;
     size_t m_size;
+    size_t m_offset;
+
+    void unmap();
 
 public:
     /// \brief Maps a read-only file to memory.
-    MMapReadOnlyFile(const std::string& filename);
-    
+    /// \param filename the name of the file
+    /// \param populate whether to read the whole file into memory right away (\c MAP_POPULATE)
+    MMapReadOnlyFile(const std::string& filename, bool populate = false);
+
+    /// \brief Maps a window of a read-only file to memory.
+    /// \param filename the name of the file
+    /// \param offset the file offset of the window
+    /// \param length the size of the window, which is cut off at the end of the file
+    /// \param populate whether to read the window into memory right away (\c MAP_POPULATE)
+    MMapReadOnlyFile(const std::string& filename, size_t offset, size_t length, bool populate = false);
+
     /// \brief Unmaps and closes the file.
     ~MMapReadOnlyFile();
 
+    MMapReadOnlyFile(const MMapReadOnlyFile&) = delete;
+    MMapReadOnlyFile& operator=(const MMapReadOnlyFile&) = delete;
+
+    /// \brief Maps another window of the file, replacing the current one.
+    /// \param offset the file offset of the window, which needs not be aligned
+    /// \param length the size of the window, which is cut off at the end of the file
+    /// \return whether the window has been mapped
+    bool map(size_t offset, size_t length);
+
+    /// \brief Gives a hint on how the mapped window is going to be accessed.
+    /// \return whether the hint has been accepted
+    bool advise(MMapAdvice advice);
+
     /// \brief Returns the pointer to the mapped file contents.
     inline const void* data() const { return m_data; }
-    
+
+    /// \brief Gets the size of the mapped window, which is the size of the file unless a window has been requested.
+    inline size_t size() const { return m_size; }
+
+    /// \brief Gets the file offset of the mapped window.
+    inline size_t offset() const { return m_offset; }
+
+    /// \brief Gets the size of the file.
+    inline size_t file_size() const { return m_file_size; }
+
+    /// \brief The error number of the last failure to open or map the file, or zero.
+    inline int error() const { return m_error; }
+};
+
+/// \brief A memory mapped file that can be written and resized.
+///
+/// Writes go straight into the page cache and are written back to the file by the kernel, or explicitly by \ref sync.
+/// When the file grows, the mapping is extended with \c mremap, reserving address space for geometric growth,
+/// so that the data may move only for a logarithmic number of resizes.
+///
+/// Failures to open, resize or map the file are reported by throwing a \c std::system_error.
+class MMapFile {
+private:
+    int m_fd;
+    bool m_populate;
+
+    void* m_data;
+    size_t m_size;
+    size_t m_capacity; // the size of the mapping, which may extend beyond the end of the file
+
+    size_t m_written; // the end of the range whose writeback has been started
+    size_t m_evicted; // the end of the range that has been written back and dropped from memory
+
+    void remap(size_t capacity);
+    void write_behind_window(size_t end);
+
+public:
+    /// \brief Opens or creates a file for reading and writing and maps its contents to memory.
+    /// \param filename the name of the file
+    MMapFile(const std::string& filename);
+
+    /// \brief Creates or truncates a file to the given size, filled with zeroes, and maps it to memory.
+    /// \param filename the name of the file
+    /// \param size the size of the file in bytes
+    /// \param populate whether to prefault the mapped pages (\c MAP_POPULATE)
+    MMapFile(const std::string& filename, size_t size, bool populate = false);
+
+    /// \brief Unmaps and closes the file, leaving the writeback to the kernel.
+    ~MMapFile();
+
+    MMapFile(const MMapFile&) = delete;
+    MMapFile& operator=(const MMapFile&) = delete;
+
+    /// \brief Resizes the file, where new bytes are zero.
+    ///
+    /// Pointers into the mapped contents are invalidated if the file grows beyond the reserved address space.
+    ///
+    /// \param size the new size of the file in bytes
+    void resize(size_t size);
+
+    /// \brief Writes modified pages back to the file.
+    /// \param wait whether to wait until the pages have been written
+    void sync(bool wait = true);
+
+    /// \brief Tells that the contents before the given offset are final, for files written sequentially.
+    ///
+    /// Whenever a window of the given size has been completed, its writeback is started,
+    /// and the previous window is dropped from memory after it has been written.
+    /// This keeps the amount of dirty and cached pages bounded when writing files much larger than the memory.
+    /// The contents remain accessible, but dropped pages must be read from the file again.
+    ///
+    /// \param end the file offset up to which the contents are final
+    /// \param window the size of the window
+    inline void write_behind(const size_t end, const size_t window) {
+        if(end >= m_written + window) write_behind_window(end);
+    }
+
+    /// \brief Gives a hint on how the mapped contents are going to be accessed.
+    /// \return whether the hint has been accepted
+    bool advise(MMapAdvice advice);
+
+    /// \brief Returns the pointer to the mapped file contents, or \c nullptr if the file is empty.
+    inline void* data() { return m_data; }
+
+    /// \brief Returns the pointer to the mapped file contents, or \c nullptr if the file is empty.
+    inline const void* data() const { return m_data; }
+
     /// \brief Gets the size of the file.
     inline size_t size() const { return m_size; }
+
+    /// \brief Gets the size of the reserved address space.
+    inline size_t capacity() const { return m_capacity; }
 };
 
 }} // namespace tdc::io
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cstddef>
+
+#include <tdc/util/parallel_for.hpp>
+
 namespace tdc {
 
 /// \brief Computes the LCP array from the suffix array using Kasai's algorithm.
@@ -40,4 +44,51 @@ static void lcp_kasai(const char_t* text, const size_t n, const idx_t* sa, idx_t
     }
 }
 
+/// \brief Computes the LCP array from the suffix array in parallel using the Φ algorithm.
+///
+/// The permuted LCP array is computed in independent chunks of text positions, one per thread.
+/// Each chunk starts comparing from scratch, so the additional work is bounded by the number of threads times the maximum LCP value.
+/// Unlike \ref lcp_kasai, this does not require the text to be zero-terminated.
+///
+/// \tparam char_t the character type
+/// \tparam idx_t the suffix/LCP array entry type, which must be able to represent \c n
+/// \param text the input text
+/// \param n the length of the input text
+/// \param sa the suffix array for the text
+/// \param lcp the output LCP array
+/// \param plcp an array of size n used as working space -- contains the permuted LCP array after the operation
+/// \param num_threads the number of threads to use
+template<typename char_t, typename idx_t>
+static void lcp_phi_parallel(const char_t* text, const size_t n, const idx_t* sa, idx_t* lcp, idx_t* plcp, const size_t num_threads) {
+    if(n == 0) return;
+
+    // compute phi array, marking the lexicographically smallest suffix with n
+    parallel_for(n, num_threads, [&](const size_t begin, const size_t end, size_t){
+        for(size_t i = begin; i < end; i++) {
+            plcp[sa[i]] = (i > 0) ? sa[i-1] : (idx_t)n;
+        }
+    });
+
+    // compute PLCP array
+    parallel_for(n, num_threads, [&](const size_t begin, const size_t end, size_t){
+        for(size_t i = begin, l = 0; i < end; ++i) {
+            const size_t phi_i = plcp[i];
+            if(phi_i == n) {
+                l = 0;
+            } else {
+                while(i + l < n && phi_i + l < n && text[i + l] == text[phi_i + l]) ++l;
+            }
+            plcp[i] = l;
+            if(l) --l;
+        }
+    });
+
+    // compute LCP array
+    parallel_for(n, num_threads, [&](const size_t begin, const size_t end, size_t){
+        for(size_t i = begin; i < end; i++) {
+            lcp[i] = plcp[sa[i]];
+        }
+    });
+}
+
 } // namespace tdc
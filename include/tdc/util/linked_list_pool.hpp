@@ -21,6 +21,7 @@ private:
 
     // linked list management
     std::vector<index_t> list_head_;
+    std::vector<index_t> list_tail_;
     std::vector<index_t> list_free_;
 
     index_t free_list() {
@@ -30,10 +31,12 @@ private:
             list = list_free_.back();
             list_free_.pop_back();
             list_head_[list] = NONE;
+            list_tail_[list] = NONE;
         } else {
             // allocate new
             list = list_head_.size();
             list_head_.emplace_back(NONE);
+            list_tail_.emplace_back(NONE);
         }
         return list;
     }
@@ -120,6 +123,8 @@ public:
 
             if(head != NONE) {
                 pool_->item_entry_[head].prev = item;
+            } else {
+                pool_->list_tail_[list_] = item;
             }
             
             head = item;
@@ -141,6 +146,11 @@ public:
             return Iterator(*pool_, NONE);
         }
 
+        /// \brief Returns an iterator to the last item, or \ref end if the list is empty.
+        Iterator last() {
+            return Iterator(*pool_, pool_->list_tail_[list_]);
+        }
+
         void erase(const Iterator& it) {
             const index_t item = it.item_;
             const index_t prev = pool_->item_entry_[item].prev;
@@ -148,6 +158,10 @@ public:
 
             if(next != NONE) {
                 pool_->item_entry_[next].prev = prev;
+            } else {
+                auto& tail = pool_->list_tail_[list_];
+                assert(item == tail);
+                tail = prev;
             }
             
             if(prev != NONE) {
@@ -170,6 +184,7 @@ public:
                 prev = item;
                 item = pool_->item_entry_[item].next;
             }
+            assert(pool_->list_tail_[list_] == prev);
         #endif
         }
     };
@@ -231,6 +246,7 @@ public:
 
     LinkedListPool(size_t initial_list_capacity = 0, size_t initial_item_capacity = 0) {
         list_head_.reserve(initial_list_capacity);
+        list_tail_.reserve(initial_list_capacity);
         item_entry_.reserve(initial_item_capacity);
     }
 
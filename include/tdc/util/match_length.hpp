@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include <tdc/intrisics/tzcnt.hpp>
+
+namespace tdc {
+
+/// \brief Computes the length of the longest common prefix of two strings, comparing multiple characters per step.
+///
+/// Characters are compared 32 (AVX2) or 16 (SSE2) at a time using vector compares and movemask, falling back to
+/// 8 at a time using XOR and trailing zero counts.
+/// Neither string is read beyond the given maximum length, so it is safe to use at the end of a buffer.
+///
+/// \tparam char_t the character type, which must be one byte wide
+/// \param a the first string
+/// \param b the second string
+/// \param max the maximum length to compare
+/// \return the number of leading characters that both strings have in common, at most \c max
+template<typename char_t>
+inline size_t match_length(const char_t* a, const char_t* b, const size_t max) {
+    static_assert(sizeof(char_t) == 1, "match_length requires one-byte characters");
+
+    const uint8_t* p = (const uint8_t*)a;
+    const uint8_t* q = (const uint8_t*)b;
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    while(i + 32 <= max) {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(p + i));
+        const __m256i y = _mm256_loadu_si256((const __m256i*)(q + i));
+        const uint32_t neq = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y));
+        if(neq) return i + intrisics::tzcnt(neq);
+        i += 32;
+    }
+#endif
+
+#if defined(__SSE2__)
+    while(i + 16 <= max) {
+        const __m128i x = _mm_loadu_si128((const __m128i*)(p + i));
+        const __m128i y = _mm_loadu_si128((const __m128i*)(q + i));
+        const uint32_t neq = (~(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(x, y))) & 0xFFFFU;
+        if(neq) return i + intrisics::tzcnt(neq);
+        i += 16;
+    }
+#endif
+
+    while(i + 8 <= max) {
+        uint64_t x, y;
+        std::memcpy(&x, p + i, 8);
+        std::memcpy(&y, q + i, 8);
+        const uint64_t diff = x ^ y;
+        if(diff) {
+            // the first mismatching byte is the lowest non-zero byte on little endian machines
+            return i + (intrisics::tzcnt(diff) >> 3);
+        }
+        i += 8;
+    }
+
+    while(i < max && p[i] == q[i]) ++i;
+    return i;
+}
+
+} // namespace tdc
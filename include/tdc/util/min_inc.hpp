@@ -56,6 +56,23 @@ private:
     LinkedListPool<Item> item_pool_;
     LinkedList<Bucket>   buckets_;
 
+    void remove(BucketRef bucket, MinEntry entry) {
+        bucket->erase(entry);
+
+        // delete empty buckets
+        if(bucket->empty()) {
+            bucket->release();
+            buckets_.erase(bucket);
+        }
+    }
+
+    Item extract(MinEntry entry) {
+        assert(!buckets_.empty());
+        const auto item = *entry;
+        remove(buckets_.begin(), entry);
+        return item;
+    }
+
 public:
     MinInc() {
     }
@@ -81,6 +98,11 @@ public:
         return Handle { bucket, bucket->emplace_front(item) };
     }
 
+    /// \brief Tests whether the data structure contains no items.
+    bool empty() const {
+        return buckets_.empty();
+    }
+
     /// \brief Reports the current minimum key.
     Key min() const {
         assert(!buckets_.empty());
@@ -89,21 +111,20 @@ public:
 
     /// \brief Extracts any item whose key equals the current minimum key.
     Item extract_min() {
-        // extract first item from first bucket
-        auto bucket = buckets_.begin();
-        auto it = bucket->items.begin();
-
-        const auto min_item = *it;
-        bucket->erase(it);
+        return extract(buckets_.begin()->items.begin());
+    }
 
-        // delete empty buckets
-        if(bucket->empty()) {
-            bucket->release();
-            buckets_.erase(bucket);
-        }
+    /// \brief Extracts the item whose key has been the current minimum key for the longest time.
+    ///
+    /// Among items with the minimum key, this is the one that was inserted or had its key increased the longest time ago.
+    Item extract_oldest_min() {
+        return extract(buckets_.begin()->items.last());
+    }
 
-        // return
-        return min_item;
+    /// \brief Removes an item.
+    /// \param h the item handle
+    void erase(const Handle& h) {
+        remove(h.bucket, h.entry);
     }
 
     /// \brief Increases the key of an item by one.
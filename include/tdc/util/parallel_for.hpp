@@ -0,0 +1,46 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace tdc {
+
+/// \brief Processes a range of indices in parallel by splitting it into contiguous chunks, one per thread.
+///
+/// The function is called as <tt>f(begin, end, t)</tt> for each chunk <tt>[begin, end)</tt>, where \c t is the zero-based chunk number.
+/// Chunks are non-empty and ordered, i.e., chunk \c t precedes chunk \c t+1.
+/// If only one thread is requested, the function is called directly in the calling thread.
+///
+/// \tparam F the function type
+/// \param n the number of indices
+/// \param num_threads the number of threads to use
+/// \param f the function to call for each chunk
+/// \return the number of chunks that were processed
+template<typename F>
+size_t parallel_for(const size_t n, const size_t num_threads, F f) {
+    const size_t num_chunks = std::max(size_t(1), std::min(num_threads, n));
+    if(num_chunks == 1) {
+        if(n > 0) f(size_t(0), n, size_t(0));
+        return n > 0 ? 1 : 0;
+    }
+
+    const size_t chunk_size = (n + num_chunks - 1) / num_chunks;
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_chunks);
+
+    size_t num = 0;
+    for(size_t begin = 0; begin < n; begin += chunk_size) {
+        const size_t end = std::min(begin + chunk_size, n);
+        threads.emplace_back(f, begin, end, num++);
+    }
+
+    for(auto& thread : threads) {
+        thread.join();
+    }
+    return num;
+}
+
+} // namespace tdc
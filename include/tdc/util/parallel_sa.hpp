@@ -0,0 +1,137 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include <ips4o.hpp>
+
+#include <tdc/util/parallel_for.hpp>
+
+namespace tdc {
+
+/// \cond INTERNAL
+namespace parallel_sa_detail {
+
+template<typename idx_t>
+struct Tuple {
+    uint64_t key;
+    uint64_t key2;
+    idx_t    pos;
+
+    inline bool operator<(const Tuple& other) const {
+        return key < other.key || (key == other.key && key2 < other.key2);
+    }
+
+    inline bool same_keys(const Tuple& other) const {
+        return key == other.key && key2 == other.key2;
+    }
+};
+
+}
+/// \endcond
+
+/// \brief Constructs the suffix array of a text in parallel using prefix doubling.
+///
+/// In the initial round, suffixes are sorted by their first eight bytes.
+/// In each subsequent round, suffixes are sorted by pairs of ranks from the previous round, doubling the sorted prefix length, until all ranks are unique.
+/// Sorting is done using the parallel \c ips4o sorter and the ranking is done using parallel prefix scans.
+/// The number of rounds is logarithmic in the length of the longest repeated substring.
+///
+/// Suffixes are ordered as by \c divsufsort, i.e., a proper prefix is smaller than the suffix it is a prefix of, so no terminator is required.
+/// The working space is about <tt>n * (24 + sizeof(idx_t))</tt> bytes in addition to the suffix array.
+///
+/// \tparam char_t the character type
+/// \tparam idx_t the suffix array entry type
+/// \param text the input text
+/// \param n the length of the input text
+/// \param sa the output suffix array of size \c n
+/// \param num_threads the number of threads to use
+template<typename char_t, typename idx_t>
+void parallel_suffix_array(const char_t* text, const size_t n, idx_t* sa, const size_t num_threads) {
+    using Tuple = parallel_sa_detail::Tuple<idx_t>;
+    using uchar_t = std::make_unsigned_t<char_t>;
+
+    static constexpr size_t char_bits = 8 * sizeof(char_t);
+    static constexpr size_t initial_prefix = 64 / char_bits;
+    static_assert(initial_prefix > 0, "characters must not be wider than 64 bits");
+
+    if(n == 0) return;
+
+    std::vector<Tuple> tuples(n);
+    std::vector<idx_t> rank(n);
+
+    // initial round: sort by packed prefix, ties broken by suffix length for suffixes shorter than the prefix
+    parallel_for(n, num_threads, [&](const size_t begin, const size_t end, size_t){
+        for(size_t i = begin; i < end; i++) {
+            const size_t len = std::min(initial_prefix, n - i);
+            uint64_t key = 0;
+            for(size_t k = 0; k < initial_prefix; k++) {
+                key <<= (char_bits % 64);
+                if(k < len) key |= (uint64_t)(uchar_t)text[i + k];
+            }
+            tuples[i] = Tuple { key, len, (idx_t)i };
+        }
+    });
+
+    std::vector<size_t> chunk_last_head(num_threads);
+    std::vector<size_t> chunk_num_heads(num_threads);
+
+    for(size_t h = initial_prefix;; h *= 2) {
+        ips4o::parallel::sort(tuples.begin(), tuples.end(), std::less<Tuple>(), num_threads);
+
+        // rank each suffix by the position of the first tuple in its group (which has equal keys)
+        // pass 1: find the last group head in each chunk and count the groups
+        const size_t num_chunks = parallel_for(n, num_threads, [&](const size_t begin, const size_t end, const size_t t){
+            size_t last = SIZE_MAX;
+            size_t num = 0;
+            for(size_t j = begin; j < end; j++) {
+                if(j == 0 || !tuples[j].same_keys(tuples[j-1])) {
+                    last = j;
+                    ++num;
+                }
+            }
+            chunk_last_head[t] = last;
+            chunk_num_heads[t] = num;
+        });
+
+        // propagate heads over chunk boundaries
+        size_t num_groups = 0;
+        for(size_t t = 0, head = 0; t < num_chunks; t++) {
+            num_groups += chunk_num_heads[t];
+            const size_t last = chunk_last_head[t];
+            chunk_last_head[t] = head; // head of the group that the chunk starts in
+            if(last != SIZE_MAX) head = last;
+        }
+
+        if(num_groups == n) {
+            // all ranks are unique, we are done
+            parallel_for(n, num_threads, [&](const size_t begin, const size_t end, size_t){
+                for(size_t j = begin; j < end; j++) sa[j] = tuples[j].pos;
+            });
+            break;
+        }
+
+        // pass 2: assign ranks
+        parallel_for(n, num_threads, [&](const size_t begin, const size_t end, const size_t t){
+            size_t head = chunk_last_head[t];
+            for(size_t j = begin; j < end; j++) {
+                if(j == 0 || !tuples[j].same_keys(tuples[j-1])) head = j;
+                rank[(size_t)tuples[j].pos] = (idx_t)head;
+            }
+        });
+
+        // next round: sort by rank pairs, where a suffix ending within the next h characters ranks lowest
+        parallel_for(n, num_threads, [&](const size_t begin, const size_t end, size_t){
+            for(size_t i = begin; i < end; i++) {
+                const uint64_t key2 = (i + h < n) ? (uint64_t)rank[i + h] + 1 : 0;
+                tuples[i] = Tuple { (uint64_t)rank[i], key2, (idx_t)i };
+            }
+        });
+    }
+}
+
+} // namespace tdc
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+
+namespace tdc {
+
+/// \brief Computes the previous and next smaller values of each suffix array entry, indexed by text position.
+///
+/// For a text position \c i, <tt>psv[i]</tt> is the position \c j < \c i whose suffix is the lexicographically closest smaller one than suffix \c i,
+/// and <tt>nsv[i]</tt> is the position \c j < \c i whose suffix is the lexicographically closest larger one.
+/// These are the two candidates for the longest previous factor starting at \c i (Kärkkäinen, Kempa and Puglisi, 2013).
+/// The computation takes linear time and, apart from the output arrays, uses no additional working space.
+///
+/// \tparam sa_t the suffix array entry type
+/// \tparam idx_t the output entry type, which must be able to represent \c n
+/// \param sa the suffix array
+/// \param n the length of the suffix array
+/// \param psv the output array for the previous smaller values, of size \c n -- entries for which there is none are set to \c n
+/// \param nsv the output array for the next smaller values, of size \c n -- entries for which there is none are set to \c n
+template<typename sa_t, typename idx_t>
+static void psv_nsv(const sa_t* sa, const size_t n, idx_t* psv, idx_t* nsv) {
+    // scan the suffix array, maintaining a stack of increasing text positions that is linked through the PSV array
+    size_t top = n;
+    for(size_t i = 0; i < n; i++) {
+        const size_t x = (size_t)sa[i];
+        while(top != n && top > x) {
+            nsv[top] = x;
+            top = (size_t)psv[top];
+        }
+        psv[x] = top;
+        top = x;
+    }
+
+    // whatever remains on the stack has no next smaller value
+    while(top != n) {
+        nsv[top] = n;
+        top = (size_t)psv[top];
+    }
+}
+
+} // namespace tdc
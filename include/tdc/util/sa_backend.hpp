@@ -0,0 +1,81 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+
+#include <divsufsort.h>
+#include <divsufsort64.h>
+
+#include <tdc/util/lcp.hpp>
+
+#ifdef TDC_PARALLEL_SA
+#include <tdc/util/parallel_sa.hpp>
+#endif
+
+namespace tdc {
+
+/// \brief Suffix and LCP array construction using the backend selected at compile time.
+///
+/// By default, suffix arrays are constructed using \c divsufsort and LCP arrays using \ref lcp_kasai.
+/// If \c TDC_PARALLEL_SA is defined, the parallel prefix doubling (\ref parallel_suffix_array) and Φ (\ref lcp_phi_parallel) algorithms are used instead,
+/// with as many threads as there are hardware threads.
+/// Inputs shorter than \ref parallel_threshold are always processed sequentially.
+namespace sa_backend {
+
+/// \brief The minimum input length for which the parallel backend uses more than one thread.
+constexpr size_t parallel_threshold = 1ULL << 16;
+
+/// \brief The number of threads used for an input of the given length.
+inline size_t num_threads(const size_t n) {
+#ifdef TDC_PARALLEL_SA
+    return n >= parallel_threshold ? std::max(1U, std::thread::hardware_concurrency()) : 1;
+#else
+    return 1;
+#endif
+}
+
+/// \brief Constructs the suffix array of a text.
+/// \param text the input text
+/// \param n the length of the input text
+/// \param sa the output suffix array of size \c n
+template<typename char_t>
+inline void suffix_array(const char_t* text, const size_t n, saidx_t* sa) {
+#ifdef TDC_PARALLEL_SA
+    parallel_suffix_array(text, n, sa, num_threads(n));
+#else
+    static_assert(sizeof(char_t) == 1, "divsufsort requires one-byte characters");
+    divsufsort((const sauchar_t*)text, sa, (saidx_t)n);
+#endif
+}
+
+/// \brief Constructs the 64-bit suffix array of a text.
+/// \param text the input text
+/// \param n the length of the input text
+/// \param sa the output suffix array of size \c n
+template<typename char_t>
+inline void suffix_array(const char_t* text, const size_t n, saidx64_t* sa) {
+#ifdef TDC_PARALLEL_SA
+    parallel_suffix_array(text, n, sa, num_threads(n));
+#else
+    static_assert(sizeof(char_t) == 1, "divsufsort requires one-byte characters");
+    divsufsort64((const sauchar_t*)text, sa, (saidx64_t)n);
+#endif
+}
+
+/// \brief Constructs the LCP array of a zero-terminated text from its suffix array.
+/// \param text the input text, assuming to be zero-terminated
+/// \param n the length of the input text including the zero-terminator
+/// \param sa the suffix array for the text
+/// \param lcp the output LCP array
+/// \param plcp an array of size n used as working space
+template<typename char_t, typename idx_t>
+inline void lcp_array(const char_t* text, const size_t n, const idx_t* sa, idx_t* lcp, idx_t* plcp) {
+#ifdef TDC_PARALLEL_SA
+    lcp_phi_parallel(text, n, sa, lcp, plcp, num_threads(n));
+#else
+    lcp_kasai(text, n, sa, lcp, plcp);
+#endif
+}
+
+}} // namespace tdc::sa_backend
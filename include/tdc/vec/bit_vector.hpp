@@ -6,8 +6,8 @@
 #include <vector>
 #include <utility>
 
-#include "allocate.hpp"
 #include "item_ref.hpp"
+#include "storage.hpp"
 #include "vector_builder.hpp"
 
 #include <tdc/math/idiv.hpp>
@@ -35,7 +35,7 @@ private:
     }
 
     size_t m_size;
-    std::unique_ptr<uint64_t[]> m_bits;
+    VectorStorage<uint64_t> m_bits;
 
     inline bool get(const size_t i) const {
         //~ const size_t q = block(i);
@@ -64,23 +64,22 @@ public:
     /// \brief Constructs a bit vector of the specified length with all bits initialized to zero.
     /// \param size the number of bits in the bit vector
     /// \param initialize if \c true, the bits will be initialized with zero
-    inline BitVector(const size_t size, const bool initialize = true) : m_size(size) {
-        m_bits = allocate_integers(m_size, 1, initialize);
+    inline BitVector(const size_t size, const bool initialize = true) : m_size(size), m_bits(math::idiv_ceil(size, 64ULL), initialize) {
+    }
+
+    /// \brief Constructs a bit vector of the specified length stored in a memory mapped file, with all bits initialized to zero.
+    /// \param size the number of bits in the bit vector
+    /// \param storage the file storage parameters
+    inline BitVector(const size_t size, const FileStorage& storage) : m_size(size), m_bits(math::idiv_ceil(size, 64ULL), storage) {
     }
 
     /// \brief Constructs a bit vector from the given \c std bit vector
     BitVector(const std::vector<bool>& bits);
     
-    inline BitVector(const BitVector& other) { *this = other; }
+    /// \brief Copies a bit vector, where the copy is always allocated on the heap.
+    BitVector(const BitVector& other) = default;
     BitVector(BitVector&& other) = default;
-
-    inline BitVector& operator=(const BitVector& other) {
-        m_size = other.m_size;
-        m_bits = allocate_integers(m_size, 1, false);
-        std::memcpy(m_bits.get(), other.m_bits.get(), math::idiv_ceil(m_size, 64ULL) * sizeof(uint64_t));
-        return *this;
-    }
-
+    BitVector& operator=(const BitVector& other) = default;
     BitVector& operator=(BitVector&& other) = default;
 
     /// \brief Gets all bits in the interval <tt>[64i,64i+63]</tt> packed in a 64-bit integer, with the least significant bit representing bit <tt>64i</tt>.
@@ -107,9 +106,23 @@ public:
     }
 
     /// \brief Resizes the bit vector.
+    ///
+    /// Bit vectors stored in files are resized in place.
+    ///
     /// \param size the new size
     void resize(const size_t size);
 
+    /// \brief Tells that the bits before the given position are final, so they can be written back if the bit vector is stored in a file.
+    /// \param i the position of the first bit that is not final
+    inline void write_behind(const size_t i) {
+        m_bits.write_behind(block(i));
+    }
+
+    /// \brief Tests whether the bits are stored in a memory mapped file.
+    inline bool is_file() const {
+        return m_bits.is_file();
+    }
+
     /// \brief The number of bits contained in this bit vector.
     inline size_t size() const {
         return m_size;
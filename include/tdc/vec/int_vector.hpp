@@ -4,9 +4,9 @@
 #include <memory>
 #include <utility>
 
-#include "allocate.hpp"
 #include "item_ref.hpp"
 #include "iterator.hpp"
+#include "storage.hpp"
 #include "vector_builder.hpp"
 
 #include <tdc/math/bit_mask.hpp>
@@ -32,11 +32,13 @@ private:
     size_t m_size;
     size_t m_width;
     size_t m_mask;
-    std::unique_ptr<uint64_t[]> m_data;
+    VectorStorage<uint64_t> m_data;
 
     uint64_t get(const size_t i) const;
     void set(const size_t i, const uint64_t v);
 
+    void resize_in_place(const size_t size, const size_t width);
+
 public:
     /// \brief Proxy for reading and writing a single integer.
     using IntRef = ItemRef<IntVector, uint64_t>;
@@ -52,25 +54,22 @@ public:
     /// \param size the number of integers
     /// \param width the width of each integer in bits
     /// \param initialize if \c true, all values will be initialized with zero
-    inline IntVector(const size_t size, const size_t width, const bool initialize = true) {
-        m_size = size;
-        m_width = width;
-        m_mask = math::bit_mask<size_t>(width);
-        m_data = allocate_integers(size, width, initialize);
+    inline IntVector(const size_t size, const size_t width, const bool initialize = true)
+        : m_size(size), m_width(width), m_mask(math::bit_mask<size_t>(width)), m_data(math::idiv_ceil(size * width, 64ULL), initialize) {
     }
 
-    inline IntVector(const IntVector& other) { *this = other; }
-    IntVector(IntVector&& other) = default;
-
-    inline IntVector& operator=(const IntVector& other) {
-        m_size = other.m_size;
-        m_width = other.m_width;
-        m_mask = other.m_mask;
-        m_data = allocate_integers(m_size, m_width, false);
-        memcpy(m_data.get(), other.m_data.get(), math::idiv_ceil(m_size * m_width, 64ULL) * sizeof(uint64_t));
-        return *this;
+    /// \brief Constructs an integer vector with the specified length and width stored in a memory mapped file, with all values initialized to zero.
+    /// \param size the number of integers
+    /// \param width the width of each integer in bits
+    /// \param storage the file storage parameters
+    inline IntVector(const size_t size, const size_t width, const FileStorage& storage)
+        : m_size(size), m_width(width), m_mask(math::bit_mask<size_t>(width)), m_data(math::idiv_ceil(size * width, 64ULL), storage) {
     }
 
+    /// \brief Copies an integer vector, where the copy is always allocated on the heap.
+    IntVector(const IntVector& other) = default;
+    IntVector(IntVector&& other) = default;
+    IntVector& operator=(const IntVector& other) = default;
     IntVector& operator=(IntVector&& other) = default;
     
     /// \brief Exchanges the contents of this vector with that of the other.
@@ -85,6 +84,8 @@ public:
 
     /// \brief Resizes the integer vector with the specified new length and width.
     ///
+    /// Integer vectors stored in files are resized in place.
+    ///
     /// \param size the new number of integers
     /// \param width the new width of each integer in bits
     void resize(const size_t size, const size_t width);
@@ -128,6 +129,17 @@ public:
         return IntRef(*this, m_size-1);
     }
 
+    /// \brief Tells that the integers before the given index are final, so they can be written back if the vector is stored in a file.
+    /// \param i the index of the first integer that is not final
+    inline void write_behind(const size_t i) {
+        m_data.write_behind((i * m_width) >> 6ULL);
+    }
+
+    /// \brief Tests whether the integers are stored in a memory mapped file.
+    inline bool is_file() const {
+        return m_data.is_file();
+    }
+
     /// \brief The width of each integer in bits.
     inline size_t width() const {
         return m_width;
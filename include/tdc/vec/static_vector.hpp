@@ -8,6 +8,7 @@
 
 #include "item_ref.hpp"
 #include "iterator.hpp"
+#include "storage.hpp"
 #include "vector_builder.hpp"
 #include <tdc/math/idiv.hpp>
 
@@ -32,20 +33,8 @@ private:
     friend class ItemRef<StaticVector<T>, T>;
     friend class ConstItemRef<StaticVector<T>, T>;
 
-    static constexpr size_t s_item_size = sizeof(T);
-    
-    static std::unique_ptr<T[]> allocate(const size_t num, const bool initialize = true) {
-        T* p = new T[num];
-        
-        if(initialize) {
-            memset(p, 0, num * s_item_size);
-        }
-        
-        return std::unique_ptr<T[]>(p);
-    }
-
     size_t m_size;
-    std::unique_ptr<T[]> m_data;
+    VectorStorage<T> m_data;
 
     T get(const size_t i) const {
         return m_data[i];
@@ -69,35 +58,40 @@ public:
     /// \brief Constructs a vector with the specified length.
     /// \param size the number of items
     /// \param initialize if \c true, the items will be initialized using their default constructor
-    inline StaticVector(const size_t size, const bool initialize = true) {
-        m_size = size;
-        m_data = allocate(size, initialize);
+    inline StaticVector(const size_t size, const bool initialize = true) : m_size(size), m_data(size, initialize) {
     }
 
-    inline StaticVector(const StaticVector& other) { *this = other; }
-    StaticVector(StaticVector&& other) = default;
-
-    inline StaticVector& operator=(const StaticVector& other) {
-        m_size = other.m_size;
-        m_data = allocate(m_size, false);
-        memcpy(m_data.get(), other.m_data.get(), m_size * s_item_size);
-        return *this;
+    /// \brief Constructs a vector with the specified length stored in a memory mapped file, with all items initialized to zero.
+    /// \param size the number of items
+    /// \param storage the file storage parameters
+    inline StaticVector(const size_t size, const FileStorage& storage) : m_size(size), m_data(size, storage) {
     }
 
+    /// \brief Copies a vector, where the copy is always allocated on the heap.
+    StaticVector(const StaticVector& other) = default;
+    StaticVector(StaticVector&& other) = default;
+    StaticVector& operator=(const StaticVector& other) = default;
     StaticVector& operator=(StaticVector&& other) = default;
     
     /// \brief Resizes the vector with the specified new length.
     ///
+    /// Vectors stored in files are resized in place.
+    ///
     /// \param size the new number of items
     inline void resize(const size_t size) {
-        StaticVector<T> new_v(size, size >= m_size); // no init if new size is smaller
-        
-        const size_t num_to_copy = std::min(size, m_size);
-        for(size_t i = 0; i < num_to_copy; i++) {
-            new_v.set(i, get(i));
-        }
-        
-        *this = std::move(new_v);
+        m_data.resize(size);
+        m_size = size;
+    }
+
+    /// \brief Tells that the items before the given index are final, so they can be written back if the vector is stored in a file.
+    /// \param i the index of the first item that is not final
+    inline void write_behind(const size_t i) {
+        m_data.write_behind(i);
+    }
+
+    /// \brief Tests whether the items are stored in a memory mapped file.
+    inline bool is_file() const {
+        return m_data.is_file();
     }
 
     /// \brief Reads the specified item.
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <tdc/io/mmap_file.hpp>
+
+namespace tdc {
+namespace vec {
+
+/// \brief Requests a vector to store its data in a memory mapped file rather than on the heap.
+///
+/// This allows for vectors larger than the memory: the kernel loads pages into the page cache when they are accessed
+/// and writes modified pages back to the file. Vectors filled sequentially, e.g., using a \ref VectorBuilder,
+/// write their data back in windows as they go (see \ref io::MMapFile::write_behind).
+struct FileStorage {
+    /// \brief The name of the file, which is created or truncated.
+    std::string filename;
+
+    /// \brief Whether the file is kept after the vector has been destroyed.
+    ///
+    /// If not, the file is removed right after it has been created and its space is released when the vector is destroyed.
+    bool keep = false;
+
+    /// \brief The size of the write-behind window in bytes.
+    size_t window = 64ULL << 20ULL;
+};
+
+/// \brief The memory backing a vector, which is either allocated on the heap or a memory mapped file.
+///
+/// Copies are always allocated on the heap.
+///
+/// \tparam T the item type
+template<typename T>
+class VectorStorage {
+private:
+    static_assert(std::is_trivially_copyable_v<T>);
+
+    static T* allocate(const size_t num, const bool initialize) {
+        T* p = new T[num];
+        if(initialize) {
+            std::memset((void*)p, 0, num * sizeof(T));
+        }
+        return p;
+    }
+
+    T* m_data;
+    size_t m_size;
+    std::unique_ptr<T[]> m_heap;
+    std::unique_ptr<io::MMapFile> m_file;
+    size_t m_window;
+
+public:
+    /// \brief Constructs an empty storage on the heap.
+    inline VectorStorage() : m_data(nullptr), m_size(0), m_window(0) {
+    }
+
+    /// \brief Allocates items on the heap.
+    /// \param size the number of items
+    /// \param initialize if \c true, the items are initialized with zero
+    inline VectorStorage(const size_t size, const bool initialize = true)
+        : m_data(allocate(size, initialize)), m_size(size), m_heap(m_data), m_window(0) {
+    }
+
+    /// \brief Maps items from a file, which is created or truncated and filled with zeroes.
+    /// \param size the number of items
+    /// \param storage the file storage parameters
+    inline VectorStorage(const size_t size, const FileStorage& storage)
+        : m_size(size), m_file(std::make_unique<io::MMapFile>(storage.filename, size * sizeof(T))), m_window(storage.window) {
+
+        m_data = (T*)m_file->data();
+        if(!storage.keep) std::filesystem::remove(storage.filename);
+    }
+
+    inline VectorStorage(const VectorStorage& other) { *this = other; }
+
+    inline VectorStorage(VectorStorage&& other) { *this = std::move(other); }
+
+    inline VectorStorage& operator=(const VectorStorage& other) {
+        if(this != &other) {
+            m_file.reset();
+            m_size = other.m_size;
+            m_data = allocate(m_size, false);
+            m_heap.reset(m_data);
+            m_window = 0;
+            if(m_size > 0) std::memcpy(m_data, other.m_data, m_size * sizeof(T));
+        }
+        return *this;
+    }
+
+    inline VectorStorage& operator=(VectorStorage&& other) {
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_heap = std::move(other.m_heap);
+        m_file = std::move(other.m_file);
+        m_window = other.m_window;
+        return *this;
+    }
+
+    /// \brief Tests whether the items are stored in a file.
+    inline bool is_file() const {
+        return bool(m_file);
+    }
+
+    /// \brief Resizes the storage, where new items are zero in files.
+    ///
+    /// Files are resized in place, whereas heap storage is reallocated.
+    ///
+    /// \param size the new number of items
+    /// \param initialize if \c true, new items on the heap are initialized with zero
+    inline void resize(const size_t size, const bool initialize = true) {
+        if(m_file) {
+            m_file->resize(size * sizeof(T));
+            m_data = (T*)m_file->data();
+        } else {
+            T* p = allocate(size, false);
+            const size_t num_to_copy = std::min(size, m_size);
+            if(num_to_copy > 0) std::memcpy(p, m_data, num_to_copy * sizeof(T));
+            if(initialize && size > num_to_copy) std::memset((void*)(p + num_to_copy), 0, (size - num_to_copy) * sizeof(T));
+            m_data = p;
+            m_heap.reset(p);
+        }
+        m_size = size;
+    }
+
+    /// \brief Tells that the items before the given index are final, so they can be written back to the file.
+    /// \param i the index of the first item that is not final
+    inline void write_behind(const size_t i) {
+        if(m_file) m_file->write_behind(i * sizeof(T), m_window);
+    }
+
+    /// \brief The number of items.
+    inline size_t size() const { return m_size; }
+
+    /// \brief Pointer to the items.
+    inline T* data() { return m_data; }
+
+    /// \brief Pointer to the items.
+    inline const T* data() const { return m_data; }
+
+    /// \brief Accesses an item.
+    inline T& operator[](const size_t i) { return m_data[i]; }
+
+    /// \brief Reads an item.
+    inline const T& operator[](const size_t i) const { return m_data[i]; }
+};
+
+}} // namespace tdc::vec
@@ -24,6 +24,9 @@ protected:
     vector_t m_vector;
 
 private:
+    // the number of items after which the builder tells the vector that the preceding items are final
+    static constexpr size_t WRITE_BEHIND_INTERVAL_MASK = 4095;
+
     size_t   m_size;
 
 public:
@@ -35,6 +38,14 @@ public:
         }
     }
 
+    /// \brief Builds into the given vector, whose size becomes the initial capacity.
+    ///
+    /// This allows for building vectors that have been constructed with special parameters, e.g., ones stored in files.
+    ///
+    /// \param vector the vector to build into
+    explicit VectorBuilder(vector_t&& vector) : m_vector(std::move(vector)), m_size(0) {
+    }
+
     VectorBuilder(const VectorBuilder& other) = default;
     VectorBuilder(VectorBuilder&& other) = default;
     VectorBuilder& operator=(const VectorBuilder& other) = default;
@@ -72,6 +83,11 @@ public:
         }
 
         m_vector[m_size++] = item;
+
+        // vectors stored in files may write back their contents as they are built
+        if constexpr(requires { m_vector.write_behind(m_size); }) {
+            if((m_size & WRITE_BEHIND_INTERVAL_MASK) == 0) m_vector.write_behind(m_size);
+        }
     }
     
     /// \brief Appends an item to the end of the vector.
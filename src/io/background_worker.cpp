@@ -0,0 +1,66 @@
+#include <tdc/io/background_worker.hpp>
+
+#include <utility>
+
+using namespace tdc::io;
+
+BackgroundWorker::BackgroundWorker() : m_busy(false), m_stop(false), m_thread([this](){ run(); }) {
+}
+
+BackgroundWorker::~BackgroundWorker() {
+    {
+        std::unique_lock lock(m_mutex);
+        m_cv.wait(lock, [this](){ return !m_busy; });
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    m_thread.join();
+}
+
+void BackgroundWorker::run() {
+    std::unique_lock lock(m_mutex);
+    while(true) {
+        m_cv.wait(lock, [this](){ return m_busy || m_stop; });
+        if(!m_busy) break; // stopped
+
+        auto job = std::move(m_job);
+        lock.unlock();
+        try {
+            job();
+        } catch(...) {
+            lock.lock();
+            m_error = std::current_exception();
+            lock.unlock();
+        }
+        lock.lock();
+
+        m_busy = false;
+        m_cv.notify_all();
+    }
+}
+
+void BackgroundWorker::rethrow() {
+    if(m_error) {
+        auto error = std::move(m_error);
+        m_error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+void BackgroundWorker::submit(std::function<void()> job) {
+    {
+        std::unique_lock lock(m_mutex);
+        m_cv.wait(lock, [this](){ return !m_busy; });
+        rethrow();
+
+        m_job = std::move(job);
+        m_busy = true;
+    }
+    m_cv.notify_all();
+}
+
+void BackgroundWorker::wait() {
+    std::unique_lock lock(m_mutex);
+    m_cv.wait(lock, [this](){ return !m_busy; });
+    rethrow();
+}
@@ -3,71 +3,72 @@
 
 using namespace tdc::io;
 
-void BitIStream::read_next_from_stream() {
-    char c;
-    if(m_stream->get(c)) {
-        m_next = c;
+BitIStream::BitIStream(std::istream& input)
+    : m_stream(&input),
+      m_buffer(std::make_unique<uint8_t[]>(BUFFER_SIZE)),
+      m_ptr(nullptr),
+      m_end(nullptr),
+      m_word(0),
+      m_word_bits(0),
+      m_bytes_total(0),
+      m_last_byte(0),
+      m_bits_read(0),
+      m_bits_total(SIZE_MAX) {
 
-        if(m_stream->get(c)) {
-            // stream still going
-            m_stream->unget();
-        } else {
-            // stream over after next, do some checks
-            m_final_bits = c;
-            m_final_bits &= 0b111;
-            if(m_final_bits >= 6) {
-                // special case - already final
-                m_is_final = true;
-                m_next = 0;
-            }
-        }
-    } else {
-        m_is_final = true;
-        m_final_bits = m_current & 0b111;
-
-        m_next = 0;
-    }
+    refill();
 }
 
-void BitIStream::read_next() {
-    m_current = m_next;
-    m_cursor = MSB;
+BitIStream::BitIStream(const void* data, const size_t size)
+    : m_stream(nullptr),
+      m_ptr((const uint8_t*)data),
+      m_end((const uint8_t*)data + size),
+      m_word(0),
+      m_word_bits(0),
+      m_bytes_total(size),
+      m_last_byte(size ? m_end[-1] : 0),
+      m_bits_read(0),
+      m_bits_total(SIZE_MAX) {
 
-    read_next_from_stream();
+    // the entire input is available, so the lead-out can be read right away
+    read_lead_out(m_bytes_total, m_last_byte);
+    refill();
 }
 
-BitIStream::BitIStream(std::istream& input) : m_stream(&input) {
-    char c;
-    if(m_stream->get(c)) {
-        // prepare the state by reading the first byte into to the `m_next`
-        // member. `read_next()` will then shift it to the `m_current`
-        // member, from which the `read_XXX()` methods take away bits.
-        m_is_final = false;
-        m_next = c;
-
-        read_next();
-    } else {
+void BitIStream::read_lead_out(const size_t num_bytes, const uint8_t last) {
+    if(num_bytes == 0) {
         // special case: if the stream is empty to begin with, we
         // never read the last 3 bits and just treat it as completely empty
-        m_is_final = true;
-        m_final_bits = 0;
+        m_bits_total = 0;
+    } else {
+        const size_t final_bits = last & 0b111;
+        if(final_bits >= 6) {
+            // the last byte only contains the lead-out,
+            // the number of valid bits refers to the byte before
+            m_bits_total = (num_bytes >= 2) ? (num_bytes - 2) * CHAR_BIT + final_bits : 0;
+        } else {
+            m_bits_total = (num_bytes - 1) * CHAR_BIT + final_bits;
+        }
     }
 }
 
-bool BitIStream::read_bit() {
-    if(!eof()) {
-        const bool bit = (m_current >> m_cursor) & 1;
-        if(m_cursor) {
-            --m_cursor;
-        } else {
-            read_next();
-        }
+bool BitIStream::fill_buffer() {
+    if(!m_stream || m_bits_total != SIZE_MAX) return false; // end already reached
 
-        ++m_bits_read;
-        return bit;
-    } else {
-        return 0; //EOF
+    m_stream->read((char*)m_buffer.get(), BUFFER_SIZE);
+    const size_t n = m_stream->gcount();
+    if(n > 0) {
+        m_bytes_total += n;
+        m_last_byte = m_buffer[n - 1];
+    }
+
+    // detect the end of the stream as early as possible, so eof() can be answered before the last bit is read
+    if(n < BUFFER_SIZE || m_stream->peek() == std::char_traits<char>::eof()) {
+        read_lead_out(m_bytes_total, m_last_byte);
     }
+
+    m_ptr = m_buffer.get();
+    m_end = m_ptr + n;
+    return n > 0;
 }
 
 template uint8_t BitIStream::read_binary<uint8_t>(size_t);
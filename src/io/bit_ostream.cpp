@@ -3,45 +3,74 @@
 
 using namespace tdc::io;
 
-void BitOStream::reset() {
-    m_next = 0;
-    m_cursor = MSB;
+BitOStream::BitOStream(std::ostream& stream)
+    : m_stream(&stream),
+      m_buffer(std::make_unique<uint8_t[]>(BUFFER_SIZE)),
+      m_buffer_pos(0),
+      m_word(0),
+      m_word_bits(0),
+      m_bits_written(0) {
 }
 
-void BitOStream::write_next() {
-    m_stream->put(char(m_next));
-    reset();
+BitOStream::BitOStream(BitOStream&& other)
+    : m_stream(std::exchange(other.m_stream, nullptr)),
+      m_buffer(std::move(other.m_buffer)),
+      m_buffer_pos(other.m_buffer_pos),
+      m_word(other.m_word),
+      m_word_bits(other.m_word_bits),
+      m_bits_written(other.m_bits_written) {
 }
 
-BitOStream::BitOStream(std::ostream& stream) : m_stream(&stream) {
-    reset();
+BitOStream& BitOStream::operator=(BitOStream&& other) {
+    finalize();
+
+    m_stream = std::exchange(other.m_stream, nullptr);
+    m_buffer = std::move(other.m_buffer);
+    m_buffer_pos = other.m_buffer_pos;
+    m_word = other.m_word;
+    m_word_bits = other.m_word_bits;
+    m_bits_written = other.m_bits_written;
+    return *this;
 }
 
 BitOStream::~BitOStream() {
-    uint8_t set_bits = MSB - m_cursor; // will only be in range 0 to 7
-    if(m_cursor >= 2) {
-        // if there are at least 3 bits free in the byte buffer,
-        // write them into the cursor at the last 3 bit positions
-        m_next |= set_bits;
-        write_next();
-    } else {
-        // else write out the byte, and write the length into the
-        // last 3 bit positions of the next byte
-        write_next();
-        m_next = set_bits;
-        write_next();
-    }
+    finalize();
+}
+
+void BitOStream::flush_buffer() {
+    m_stream->write((const char*)m_buffer.get(), m_buffer_pos);
+    m_buffer_pos = 0;
 }
 
-void BitOStream::write_bit(const bool b) {
-    m_next |= (b << m_cursor);
+void BitOStream::finalize() {
+    if(!m_stream) return; // moved away
 
-    --m_cursor;
-    if(m_cursor < 0) {
-        write_next();
+    // make room for the pending word and two lead-out bytes
+    if(m_buffer_pos + sizeof(uint64_t) + 2 > BUFFER_SIZE) flush_buffer();
+
+    // write out the full bytes of the pending word
+    const size_t set_bits = m_word_bits % 8ULL; // will only be in range 0 to 7
+    size_t bits = m_word_bits;
+    while(bits >= 8ULL) {
+        bits -= 8ULL;
+        m_buffer[m_buffer_pos++] = uint8_t(m_word >> bits);
+    }
+
+    // left-align the remaining bits in the last byte
+    uint8_t last = set_bits ? uint8_t(m_word << (8ULL - set_bits)) : 0;
+    if(set_bits <= 5) {
+        // if there are at least 3 bits free in the last byte,
+        // write the number of set bits into the last 3 bit positions
+        m_buffer[m_buffer_pos++] = last | set_bits;
+    } else {
+        // else write out the byte, and write the number of set bits into the
+        // last 3 bit positions of the next byte
+        m_buffer[m_buffer_pos++] = last;
+        m_buffer[m_buffer_pos++] = uint8_t(set_bits);
     }
 
-    ++m_bits_written;
+    flush_buffer();
+    m_stream = nullptr;
 }
 
 template void BitOStream::write_binary<uint8_t>(const uint8_t, size_t bits);
@@ -0,0 +1,206 @@
+#include <tdc/io/file_reader.hpp>
+
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace tdc::io;
+
+namespace {
+
+// reads at least min bytes, requesting up to num bytes at a time, or until the end of the file has been reached
+// under direct I/O, a short read is continued at the preceding multiple of align, so the unaligned tail is read again
+int64_t read_fully(const int fd, char* buffer, const size_t num, const size_t offset, const size_t min, const size_t align) {
+    size_t total = 0;
+    while(total < min) {
+        const ssize_t r = pread(fd, buffer + total, num - total, offset + total);
+        if(r > 0) {
+            const size_t end = total + r;
+            const size_t aligned = end - end % align;
+            if(end >= min || aligned == total) {
+                // done, or the file ended within the alignment unit
+                total = end;
+                break;
+            }
+            total = aligned;
+        } else if(r == 0) {
+            break;
+        } else if(errno != EINTR) {
+            return -errno;
+        }
+    }
+    return total;
+}
+
+}
+
+FileBlockReader::FileBlockReader(const std::string& filename, const size_t block_size, const size_t queue_depth, const bool direct, const FileBackend backend)
+    : m_block_size(std::max(((block_size + ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT, ALIGNMENT)),
+      m_depth(std::max(queue_depth, size_t(1))),
+      m_direct(direct),
+      m_current(0),
+      m_started(false),
+      m_in_flight(0),
+      m_last_submitted(0) {
+
+    m_fd = open(filename.c_str(), O_RDONLY | O_CLOEXEC | (direct ? O_DIRECT : 0));
+    if(m_fd < 0 && direct) {
+        // direct I/O is not supported by all file systems
+        m_direct = false;
+        m_fd = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    }
+    if(m_fd < 0) throw std::system_error(errno, std::generic_category(), filename);
+
+    struct stat st;
+    if(fstat(m_fd, &st) < 0) {
+        const int error = errno;
+        close(m_fd);
+        throw std::system_error(error, std::generic_category(), filename);
+    }
+    m_file_size = st.st_size;
+    m_num_blocks = (m_file_size + m_block_size - 1) / m_block_size;
+
+    if(backend != FileBackend::thread) {
+        m_ring = std::make_unique<IoUring>(m_depth);
+        if(!m_ring->ok()) {
+            m_ring.reset();
+            if(backend == FileBackend::io_uring) {
+                close(m_fd);
+                throw std::system_error(ENOSYS, std::generic_category(), "io_uring");
+            }
+        }
+    }
+
+    if(!m_ring) {
+        // a single worker reads one block at a time, so more buffers would not read further ahead
+        m_depth = std::min(m_depth, size_t(2));
+        m_worker = std::make_unique<BackgroundWorker>();
+    }
+
+    m_buffers.resize(m_depth);
+    for(auto& buffer : m_buffers) {
+        buffer = (char*)std::aligned_alloc(ALIGNMENT, m_block_size);
+        if(!buffer) {
+            for(auto allocated : m_buffers) std::free(allocated);
+            close(m_fd);
+            throw std::bad_alloc();
+        }
+    }
+    m_results.resize(m_depth, 0);
+    m_done.resize(m_depth, false);
+
+    if(m_ring) {
+        std::vector<struct iovec> iov(m_depth);
+        for(size_t i = 0; i < m_depth; i++) {
+            iov[i].iov_base = m_buffers[i];
+            iov[i].iov_len = m_block_size;
+        }
+        m_ring->register_buffers(iov.data(), m_depth);
+    }
+
+    // start reading ahead
+    for(size_t b = 0; b < std::min(m_depth, m_num_blocks); b++) {
+        submit(b);
+    }
+}
+
+FileBlockReader::~FileBlockReader() {
+    if(m_ring) {
+        // the kernel may still write into the buffers
+        uint64_t user_data;
+        int32_t result;
+        while(m_in_flight > 0 && m_ring->submit(1) == 0) {
+            while(m_ring->pop(user_data, result)) --m_in_flight;
+        }
+        m_ring.reset();
+    } else {
+        try {
+            m_worker->wait();
+        } catch(...) {
+        }
+    }
+
+    for(auto buffer : m_buffers) {
+        std::free(buffer);
+    }
+    close(m_fd);
+}
+
+void FileBlockReader::submit(const size_t block) {
+    const size_t slot = block % m_depth;
+    const size_t offset = block * m_block_size;
+    m_done[slot] = false;
+
+    if(m_ring) {
+        const int buffer_index = m_ring->has_registered_buffers() ? int(slot) : -1;
+        [[maybe_unused]] const bool prepared = m_ring->prepare_read(m_fd, m_buffers[slot], m_block_size, offset, buffer_index, block);
+        assert(prepared);
+        ++m_in_flight;
+    } else {
+        m_last_submitted = block;
+        const size_t expected = std::min(m_block_size, m_file_size - offset);
+        m_worker->submit([this, slot, offset, expected](){
+            m_results[slot] = read_fully(m_fd, m_buffers[slot], m_block_size, offset, expected, m_direct ? ALIGNMENT : 1);
+        });
+    }
+}
+
+void FileBlockReader::wait(const size_t block) {
+    const size_t slot = block % m_depth;
+    if(m_ring) {
+        // submit the reads ahead in one batch and wait for the block unless it has already been read
+        do {
+            const int error = m_ring->submit(m_done[slot] ? 0 : 1);
+            if(error < 0) throw std::system_error(-error, std::generic_category(), "io_uring_enter");
+
+            uint64_t user_data;
+            int32_t result;
+            while(m_ring->pop(user_data, result)) {
+                const size_t s = user_data % m_depth;
+                m_results[s] = result;
+                m_done[s] = true;
+                --m_in_flight;
+            }
+        } while(!m_done[slot]);
+    } else if(block == m_last_submitted) {
+        // submitting a block waits for the previous one, so only the last block submitted may be pending
+        m_worker->wait();
+    }
+}
+
+std::string_view FileBlockReader::next() {
+    if(m_started) {
+        if(m_current >= m_num_blocks) return std::string_view();
+
+        // the buffer of the consumed block is reused for reading ahead
+        const size_t ahead = m_current + m_depth;
+        if(ahead < m_num_blocks) submit(ahead);
+        ++m_current;
+    } else {
+        m_started = true;
+    }
+
+    if(m_current >= m_num_blocks) return std::string_view();
+    wait(m_current);
+
+    const size_t slot = m_current % m_depth;
+    const size_t offset = m_current * m_block_size;
+    size_t expected = std::min(m_block_size, m_file_size - offset);
+
+    const int64_t result = m_results[slot];
+    if(result < 0) throw std::system_error(-result, std::generic_category(), "read");
+    if(size_t(result) < expected) {
+        // complete a short read synchronously, resuming at an aligned position for direct I/O
+        const size_t align = m_direct ? ALIGNMENT : 1;
+        const size_t done = size_t(result) - size_t(result) % align;
+        const int64_t rest = read_fully(m_fd, m_buffers[slot] + done, m_block_size - done, offset + done, expected - done, align);
+        if(rest < 0) throw std::system_error(-rest, std::generic_category(), "read");
+        expected = std::min(expected, done + size_t(rest));
+    }
+    return std::string_view(m_buffers[slot], expected);
+}
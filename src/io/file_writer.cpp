@@ -0,0 +1,184 @@
+#include <tdc/io/file_writer.hpp>
+
+#include <cassert>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <system_error>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace tdc::io;
+
+namespace {
+
+// writes the requested number of bytes
+// under direct I/O, a short write is continued at the preceding multiple of align, so the unaligned tail is written again
+void write_fully(const int fd, const char* buffer, const size_t num, const size_t offset, const size_t align) {
+    size_t total = 0;
+    while(total < num) {
+        const ssize_t r = pwrite(fd, buffer + total, num - total, offset + total);
+        if(r >= 0) {
+            const size_t end = total + r;
+            total = (end < num) ? end - end % align : end;
+        } else if(errno != EINTR) {
+            throw std::system_error(errno, std::generic_category(), "write");
+        }
+    }
+}
+
+}
+
+FileBlockWriter::FileBlockWriter(const std::string& filename, const size_t block_size, const size_t queue_depth, const bool direct, const FileBackend backend)
+    : m_block_size(std::max(((block_size + ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT, ALIGNMENT)),
+      m_depth(std::max(queue_depth, size_t(1))),
+      m_direct(direct),
+      m_current(0),
+      m_offset(0),
+      m_in_flight(0) {
+
+    const int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+    m_fd = open(filename.c_str(), flags | (direct ? O_DIRECT : 0), 0666);
+    if(m_fd < 0 && direct) {
+        // direct I/O is not supported by all file systems
+        m_direct = false;
+        m_fd = open(filename.c_str(), flags, 0666);
+    }
+    if(m_fd < 0) throw std::system_error(errno, std::generic_category(), filename);
+
+    if(backend != FileBackend::thread) {
+        m_ring = std::make_unique<IoUring>(m_depth);
+        if(!m_ring->ok()) {
+            m_ring.reset();
+            if(backend == FileBackend::io_uring) {
+                close(m_fd);
+                throw std::system_error(ENOSYS, std::generic_category(), "io_uring");
+            }
+        }
+    }
+
+    if(!m_ring) {
+        // a single worker writes one block at a time while the other is filled
+        m_depth = 2;
+        m_worker = std::make_unique<BackgroundWorker>();
+    }
+    m_batch = std::max(m_depth / 2, size_t(1));
+
+    m_buffers.resize(m_depth);
+    for(auto& buffer : m_buffers) {
+        buffer = (char*)std::aligned_alloc(ALIGNMENT, m_block_size);
+        if(!buffer) {
+            for(auto allocated : m_buffers) std::free(allocated);
+            close(m_fd);
+            throw std::bad_alloc();
+        }
+    }
+    m_busy.resize(m_depth, false);
+    m_lengths.resize(m_depth, 0);
+    m_offsets.resize(m_depth, 0);
+
+    if(m_ring) {
+        std::vector<struct iovec> iov(m_depth);
+        for(size_t i = 0; i < m_depth; i++) {
+            iov[i].iov_base = m_buffers[i];
+            iov[i].iov_len = m_block_size;
+        }
+        m_ring->register_buffers(iov.data(), m_depth);
+    }
+}
+
+FileBlockWriter::~FileBlockWriter() {
+    try {
+        wait_all();
+    } catch(...) {
+    }
+    m_ring.reset();
+
+    for(auto buffer : m_buffers) {
+        std::free(buffer);
+    }
+    close(m_fd);
+}
+
+void FileBlockWriter::write(const size_t slot, const size_t length) {
+    const uint64_t offset = m_offset;
+    if(m_ring) {
+        m_busy[slot] = true;
+        m_lengths[slot] = length;
+        m_offsets[slot] = offset;
+
+        const int buffer_index = m_ring->has_registered_buffers() ? int(slot) : -1;
+        [[maybe_unused]] const bool prepared = m_ring->prepare_write(m_fd, m_buffers[slot], length, offset, buffer_index, slot);
+        assert(prepared);
+        ++m_in_flight;
+
+        // submit in batches
+        if(m_ring->num_prepared() >= m_batch) reap(0);
+    } else {
+        m_worker->submit([this, slot, length, offset](){
+            write_fully(m_fd, m_buffers[slot], length, offset, m_direct ? ALIGNMENT : 1);
+        });
+    }
+}
+
+void FileBlockWriter::reap(const unsigned min_complete) {
+    const int error = m_ring->submit(min_complete);
+    if(error < 0) throw std::system_error(-error, std::generic_category(), "io_uring_enter");
+
+    uint64_t user_data;
+    int32_t result;
+    while(m_ring->pop(user_data, result)) {
+        const size_t slot = user_data;
+        m_busy[slot] = false;
+        --m_in_flight;
+
+        if(result < 0) throw std::system_error(-result, std::generic_category(), "write");
+        if(size_t(result) < m_lengths[slot]) {
+            // complete a short write synchronously, resuming at an aligned position for direct I/O
+            const size_t align = m_direct ? ALIGNMENT : 1;
+            const size_t done = size_t(result) - size_t(result) % align;
+            write_fully(m_fd, m_buffers[slot] + done, m_lengths[slot] - done, m_offsets[slot] + done, align);
+        }
+    }
+}
+
+void FileBlockWriter::wait_all() {
+    if(m_ring) {
+        while(m_in_flight > 0) reap(1);
+    } else {
+        m_worker->wait();
+    }
+}
+
+void FileBlockWriter::commit() {
+    write(m_current % m_depth, m_block_size);
+    m_offset += m_block_size;
+    ++m_current;
+
+    // the next buffer may still be in flight
+    if(m_ring) {
+        const size_t next = m_current % m_depth;
+        while(m_busy[next]) reap(1);
+    }
+}
+
+void FileBlockWriter::sync(const size_t num) {
+    assert(num <= m_block_size);
+
+    size_t length = num;
+    if(num > 0) {
+        if(m_direct) {
+            // direct I/O requires aligned lengths, the padding is truncated below
+            length = ((num + ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT;
+            std::memset(buffer() + num, 0, length - num);
+        }
+        write(m_current % m_depth, length);
+    }
+    wait_all();
+
+    if(length > num && ftruncate(m_fd, m_offset + num) < 0) {
+        throw std::system_error(errno, std::generic_category(), "ftruncate");
+    }
+}
@@ -0,0 +1,72 @@
+#include <tdc/io/input_source.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+using namespace tdc::io;
+
+InputSource::InputSource(const std::string& filename)
+    : m_file(std::make_unique<MMapReadOnlyFile>(filename)), m_data(nullptr), m_size(0), m_stream(nullptr), m_bufsize(DEFAULT_BUFSIZE), m_pos(0) {
+
+    if(m_file->data()) {
+        m_data = (const char*)m_file->data();
+        m_size = m_file->size();
+    } else {
+        // empty files and special files cannot be mapped
+        m_file.reset();
+        m_owned_stream = std::make_unique<std::ifstream>(filename, std::ios::binary);
+        m_stream = m_owned_stream.get();
+    }
+}
+
+InputSource::InputSource(const MMapReadOnlyFile& file)
+    : InputSource(file.data(), file.size()) {
+}
+
+InputSource::InputSource(const void* data, const size_t size)
+    : m_data((const char*)data), m_size(data ? size : 0), m_stream(nullptr), m_bufsize(0), m_pos(0) {
+}
+
+InputSource::InputSource(std::istream& stream, const size_t bufsize)
+    : m_data(nullptr), m_size(0), m_stream(&stream), m_bufsize(std::max(bufsize, size_t(1))), m_pos(0) {
+}
+
+std::string_view InputSource::next(const size_t max) {
+    size_t num;
+    const char* chunk;
+    if(is_memory()) {
+        num = std::min(max, m_size - m_pos);
+        chunk = m_data + m_pos;
+    } else {
+        m_buffer.resize(std::min(max, m_bufsize));
+        m_stream->read(m_buffer.data(), m_buffer.size());
+        num = m_stream->gcount();
+        chunk = m_buffer.data();
+    }
+    m_pos += num;
+    return std::string_view(chunk, num);
+}
+
+std::string_view InputSource::all() {
+    if(is_memory()) return next();
+
+    m_buffer.assign(std::istreambuf_iterator<char>(*m_stream), {});
+    m_pos += m_buffer.size();
+    return std::string_view(m_buffer.data(), m_buffer.size());
+}
+
+size_t InputSource::read(void* buffer, const size_t num) {
+    size_t r;
+    if(is_memory()) {
+        const auto chunk = next(num);
+        if(chunk.size() > 0) std::memcpy(buffer, chunk.data(), chunk.size());
+        r = chunk.size();
+    } else {
+        m_stream->read((char*)buffer, num);
+        r = m_stream->gcount();
+        m_pos += r;
+    }
+    return r;
+}
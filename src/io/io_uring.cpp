@@ -0,0 +1,197 @@
+#include <tdc/io/io_uring.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define TDC_HAS_IO_URING
+#endif
+
+using namespace tdc::io;
+
+#ifdef TDC_HAS_IO_URING
+
+namespace {
+
+template<typename T>
+inline T load_acquire(const T* p) {
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+template<typename T>
+inline void store_release(T* p, const T x) {
+    __atomic_store_n(p, x, __ATOMIC_RELEASE);
+}
+
+template<typename T>
+inline T* offset_ptr(void* base, const size_t offset) {
+    return (T*)((char*)base + offset);
+}
+
+}
+
+IoUring::IoUring(const unsigned entries)
+    : m_fd(-1), m_entries(0),
+      m_sq_ring(MAP_FAILED), m_sq_ring_size(0), m_cq_ring(MAP_FAILED), m_cq_ring_size(0), m_sqes(MAP_FAILED), m_sqes_size(0),
+      m_local_tail(0), m_num_prepared(0), m_registered(false) {
+
+    struct io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    const int fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+    if(fd < 0) return;
+
+    // map the rings, which share a mapping on recent kernels
+    m_sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    m_cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if(single_mmap) {
+        m_sq_ring_size = std::max(m_sq_ring_size, m_cq_ring_size);
+        m_cq_ring_size = 0;
+    }
+
+    m_sq_ring = mmap(nullptr, m_sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if(m_sq_ring == MAP_FAILED) {
+        close(fd);
+        return;
+    }
+
+    if(single_mmap) {
+        m_cq_ring = m_sq_ring;
+    } else {
+        m_cq_ring = mmap(nullptr, m_cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if(m_cq_ring == MAP_FAILED) {
+            munmap(m_sq_ring, m_sq_ring_size);
+            m_sq_ring = MAP_FAILED;
+            close(fd);
+            return;
+        }
+    }
+
+    m_sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    m_sqes = mmap(nullptr, m_sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if(m_sqes == MAP_FAILED) {
+        if(!single_mmap) munmap(m_cq_ring, m_cq_ring_size);
+        munmap(m_sq_ring, m_sq_ring_size);
+        m_sq_ring = m_cq_ring = MAP_FAILED;
+        close(fd);
+        return;
+    }
+
+    m_sq_head = offset_ptr<unsigned>(m_sq_ring, params.sq_off.head);
+    m_sq_tail = offset_ptr<unsigned>(m_sq_ring, params.sq_off.tail);
+    m_sq_mask = offset_ptr<unsigned>(m_sq_ring, params.sq_off.ring_mask);
+    m_sq_array = offset_ptr<unsigned>(m_sq_ring, params.sq_off.array);
+    m_cq_head = offset_ptr<unsigned>(m_cq_ring, params.cq_off.head);
+    m_cq_tail = offset_ptr<unsigned>(m_cq_ring, params.cq_off.tail);
+    m_cq_mask = offset_ptr<unsigned>(m_cq_ring, params.cq_off.ring_mask);
+    m_cqes = offset_ptr<void>(m_cq_ring, params.cq_off.cqes);
+
+    m_fd = fd;
+    m_entries = params.sq_entries;
+    m_local_tail = *m_sq_tail;
+}
+
+IoUring::~IoUring() {
+    if(m_fd >= 0) {
+        munmap(m_sqes, m_sqes_size);
+        if(m_cq_ring != m_sq_ring) munmap(m_cq_ring, m_cq_ring_size);
+        munmap(m_sq_ring, m_sq_ring_size);
+        close(m_fd);
+    }
+}
+
+bool IoUring::register_buffers(const struct iovec* buffers, const unsigned num) {
+    m_registered = syscall(__NR_io_uring_register, m_fd, IORING_REGISTER_BUFFERS, buffers, num) >= 0;
+    return m_registered;
+}
+
+void IoUring::prepare(const uint8_t opcode, const int fd, const void* buffer, const unsigned length, const uint64_t offset, const int buffer_index, const uint64_t user_data) {
+    const unsigned index = m_local_tail & *m_sq_mask;
+    struct io_uring_sqe* sqe = (struct io_uring_sqe*)m_sqes + index;
+    std::memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = opcode;
+    sqe->fd = fd;
+    sqe->addr = (uint64_t)(uintptr_t)buffer;
+    sqe->len = length;
+    sqe->off = offset;
+    sqe->buf_index = (buffer_index >= 0) ? uint16_t(buffer_index) : 0;
+    sqe->user_data = user_data;
+
+    m_sq_array[index] = index;
+    ++m_local_tail;
+    ++m_num_prepared;
+}
+
+bool IoUring::prepare_read(const int fd, void* buffer, const unsigned length, const uint64_t offset, const int buffer_index, const uint64_t user_data) {
+    if(m_local_tail - load_acquire(m_sq_head) >= m_entries) return false;
+    prepare(buffer_index >= 0 ? IORING_OP_READ_FIXED : IORING_OP_READ, fd, buffer, length, offset, buffer_index, user_data);
+    return true;
+}
+
+bool IoUring::prepare_write(const int fd, const void* buffer, const unsigned length, const uint64_t offset, const int buffer_index, const uint64_t user_data) {
+    if(m_local_tail - load_acquire(m_sq_head) >= m_entries) return false;
+    prepare(buffer_index >= 0 ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE, fd, buffer, length, offset, buffer_index, user_data);
+    return true;
+}
+
+int IoUring::submit(const unsigned min_complete) {
+    if(m_num_prepared == 0 && min_complete == 0) return 0;
+
+    store_release(m_sq_tail, m_local_tail);
+    while(true) {
+        const int r = (int)syscall(__NR_io_uring_enter, m_fd, m_num_prepared, min_complete, min_complete ? IORING_ENTER_GETEVENTS : 0, nullptr, 0);
+        if(r >= 0) {
+            m_num_prepared -= std::min(unsigned(r), m_num_prepared);
+            if(m_num_prepared == 0) return 0;
+        } else if(errno != EINTR) {
+            return -errno;
+        }
+    }
+}
+
+bool IoUring::pop(uint64_t& user_data, int32_t& result) {
+    const unsigned head = *m_cq_head;
+    if(head == load_acquire(m_cq_tail)) return false;
+
+    const struct io_uring_cqe* cqe = (const struct io_uring_cqe*)m_cqes + (head & *m_cq_mask);
+    user_data = cqe->user_data;
+    result = cqe->res;
+    store_release(m_cq_head, head + 1);
+    return true;
+}
+
+#else
+
+IoUring::IoUring(const unsigned entries) : m_fd(-1), m_entries(0), m_num_prepared(0), m_registered(false) {
+}
+
+IoUring::~IoUring() {
+}
+
+bool IoUring::register_buffers(const struct iovec* buffers, const unsigned num) {
+    return false;
+}
+
+bool IoUring::prepare_read(const int fd, void* buffer, const unsigned length, const uint64_t offset, const int buffer_index, const uint64_t user_data) {
+    return false;
+}
+
+bool IoUring::prepare_write(const int fd, const void* buffer, const unsigned length, const uint64_t offset, const int buffer_index, const uint64_t user_data) {
+    return false;
+}
+
+int IoUring::submit(const unsigned min_complete) {
+    return -ENOSYS;
+}
+
+bool IoUring::pop(uint64_t& user_data, int32_t& result) {
+    return false;
+}
+
+#endif
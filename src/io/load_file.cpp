@@ -7,8 +7,14 @@ template std::vector<uint32_t> tdc::io::load_file_as_vector<uint32_t>(const std:
 template std::vector<tdc::uint40_t> tdc::io::load_file_as_vector<tdc::uint40_t>(const std::filesystem::path&, const size_t);
 template std::vector<uint64_t> tdc::io::load_file_as_vector<uint64_t>(const std::filesystem::path&, const size_t);
 
-template std::vector<uint8_t> tdc::io::load_file_lines_as_vector<uint8_t>(const std::filesystem::path&);
-template std::vector<uint16_t> tdc::io::load_file_lines_as_vector<uint16_t>(const std::filesystem::path&);
-template std::vector<uint32_t> tdc::io::load_file_lines_as_vector<uint32_t>(const std::filesystem::path&);
-template std::vector<tdc::uint40_t> tdc::io::load_file_lines_as_vector<tdc::uint40_t>(const std::filesystem::path&);
-template std::vector<uint64_t> tdc::io::load_file_lines_as_vector<uint64_t>(const std::filesystem::path&);
+template std::vector<uint8_t> tdc::io::load_file_as_vector_parallel<uint8_t>(const std::filesystem::path&, const size_t);
+template std::vector<uint16_t> tdc::io::load_file_as_vector_parallel<uint16_t>(const std::filesystem::path&, const size_t);
+template std::vector<uint32_t> tdc::io::load_file_as_vector_parallel<uint32_t>(const std::filesystem::path&, const size_t);
+template std::vector<tdc::uint40_t> tdc::io::load_file_as_vector_parallel<tdc::uint40_t>(const std::filesystem::path&, const size_t);
+template std::vector<uint64_t> tdc::io::load_file_as_vector_parallel<uint64_t>(const std::filesystem::path&, const size_t);
+
+template std::vector<uint8_t> tdc::io::load_file_lines_as_vector<uint8_t>(const std::filesystem::path&, const size_t);
+template std::vector<uint16_t> tdc::io::load_file_lines_as_vector<uint16_t>(const std::filesystem::path&, const size_t);
+template std::vector<uint32_t> tdc::io::load_file_lines_as_vector<uint32_t>(const std::filesystem::path&, const size_t);
+template std::vector<tdc::uint40_t> tdc::io::load_file_lines_as_vector<tdc::uint40_t>(const std::filesystem::path&, const size_t);
+template std::vector<uint64_t> tdc::io::load_file_lines_as_vector<uint64_t>(const std::filesystem::path&, const size_t);
@@ -1,6 +1,10 @@
 #include <tdc/io/mmap_file.hpp>
 
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
 #include <cstdlib>
+#include <system_error>
 
 #include <fcntl.h>
 #include <unistd.h>
@@ -10,26 +14,181 @@
 
 using namespace tdc::io;
 
-MMapReadOnlyFile::MMapReadOnlyFile(const std::string& filename) : m_data(nullptr), m_size(0) {
-    m_fd = open(filename.c_str(), O_RDONLY);
+namespace {
+
+size_t page_size() {
+    static const size_t size = sysconf(_SC_PAGESIZE);
+    return size;
+}
+
+int madvise_flag(const MMapAdvice advice) {
+    switch(advice) {
+        case MMapAdvice::sequential: return MADV_SEQUENTIAL;
+        case MMapAdvice::random:     return MADV_RANDOM;
+        case MMapAdvice::will_need:  return MADV_WILLNEED;
+        case MMapAdvice::huge_page:  return MADV_HUGEPAGE;
+        default:                     return MADV_NORMAL;
+    }
+}
+
+}
+
+MMapReadOnlyFile::MMapReadOnlyFile(const std::string& filename, const bool populate) : MMapReadOnlyFile(filename, 0, SIZE_MAX, populate) {
+}
+
+MMapReadOnlyFile::MMapReadOnlyFile(const std::string& filename, const size_t offset, const size_t length, const bool populate)
+    : m_error(0), m_populate(populate), m_file_size(0), m_base(nullptr), m_base_size(0), m_data(nullptr), m_size(0), m_offset(0) {
+
+    m_fd = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
     if(m_fd >= 0) {
         struct stat st;
         if(fstat(m_fd, &st) >= 0) {
-            void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, m_fd, 0U);
-            if(data != MAP_FAILED) {
-                m_data = data;
-                m_size = st.st_size;
-            }
+            m_file_size = st.st_size;
+            map(offset, length);
+        } else {
+            m_error = errno;
         }
+    } else {
+        m_error = errno;
     }
 }
 
 MMapReadOnlyFile::~MMapReadOnlyFile() {
-    if(m_data) {
-        munmap(m_data, m_size);
-    }
-    
+    unmap();
+
     if(m_fd >= 0) {
         close(m_fd);
     }
 }
+
+void MMapReadOnlyFile::unmap() {
+    if(m_base) {
+        munmap(m_base, m_base_size);
+    }
+    m_base = nullptr;
+    m_base_size = 0;
+    m_data = nullptr;
+    m_size = 0;
+}
+
+bool MMapReadOnlyFile::map(const size_t offset, const size_t length) {
+    unmap();
+    m_offset = std::min(offset, m_file_size);
+
+    const size_t size = std::min(length, m_file_size - m_offset);
+    if(m_fd < 0 || size == 0) return false;
+
+    // mappings must start at a page boundary
+    const size_t aligned_offset = m_offset - m_offset % page_size();
+    const size_t base_size = size + (m_offset - aligned_offset);
+    void* base = mmap(nullptr, base_size, PROT_READ, MAP_PRIVATE | (m_populate ? MAP_POPULATE : 0), m_fd, aligned_offset);
+    if(base == MAP_FAILED) {
+        m_error = errno;
+        return false;
+    }
+
+    m_error = 0;
+    m_base = base;
+    m_base_size = base_size;
+    m_data = (char*)base + (m_offset - aligned_offset);
+    m_size = size;
+    return true;
+}
+
+bool MMapReadOnlyFile::advise(const MMapAdvice advice) {
+    return m_base && madvise(m_base, m_base_size, madvise_flag(advice)) == 0;
+}
+
+MMapFile::MMapFile(const std::string& filename) : m_populate(false), m_data(nullptr), m_size(0), m_capacity(0), m_written(0), m_evicted(0) {
+    m_fd = open(filename.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0666);
+    if(m_fd < 0) throw std::system_error(errno, std::generic_category(), filename);
+
+    struct stat st;
+    if(fstat(m_fd, &st) < 0) {
+        const int error = errno;
+        close(m_fd);
+        throw std::system_error(error, std::generic_category(), filename);
+    }
+
+    try {
+        remap(st.st_size);
+    } catch(...) {
+        close(m_fd);
+        throw;
+    }
+    m_size = st.st_size;
+}
+
+MMapFile::MMapFile(const std::string& filename, const size_t size, const bool populate)
+    : m_populate(populate), m_data(nullptr), m_size(0), m_capacity(0), m_written(0), m_evicted(0) {
+
+    m_fd = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+    if(m_fd < 0) throw std::system_error(errno, std::generic_category(), filename);
+
+    try {
+        resize(size);
+    } catch(...) {
+        close(m_fd);
+        throw;
+    }
+}
+
+MMapFile::~MMapFile() {
+    if(m_data) {
+        munmap(m_data, m_capacity);
+    }
+    close(m_fd);
+}
+
+void MMapFile::remap(const size_t capacity) {
+    if(capacity == 0) return;
+
+    void* data;
+    if(m_data) {
+        data = mremap(m_data, m_capacity, capacity, MREMAP_MAYMOVE);
+    } else {
+        data = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | (m_populate ? MAP_POPULATE : 0), m_fd, 0);
+    }
+    if(data == MAP_FAILED) throw std::system_error(errno, std::generic_category(), "mmap");
+
+    m_data = data;
+    m_capacity = capacity;
+}
+
+void MMapFile::resize(const size_t size) {
+    if(ftruncate(m_fd, size) < 0) throw std::system_error(errno, std::generic_category(), "ftruncate");
+
+    // the mapping may extend beyond the end of the file, as long as those pages are not accessed
+    if(size > m_capacity) remap(std::max(size, 2 * m_capacity));
+    m_size = size;
+    m_written = std::min(m_written, size);
+    m_evicted = std::min(m_evicted, size);
+}
+
+void MMapFile::sync(const bool wait) {
+    if(m_data && m_size > 0 && msync(m_data, m_size, wait ? MS_SYNC : MS_ASYNC) < 0) {
+        throw std::system_error(errno, std::generic_category(), "msync");
+    }
+}
+
+void MMapFile::write_behind_window(const size_t end) {
+    const size_t window_end = (std::min(end, m_size) / page_size()) * page_size();
+    if(window_end <= m_written) return;
+
+    // wait for the writeback of the previous window, which has had the time to complete, and drop it from memory
+    if(m_written > m_evicted) {
+        const size_t num = m_written - m_evicted;
+        sync_file_range(m_fd, m_evicted, num, SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+        madvise((char*)m_data + m_evicted, num, MADV_DONTNEED);
+        posix_fadvise(m_fd, m_evicted, num, POSIX_FADV_DONTNEED);
+        m_evicted = m_written;
+    }
+
+    // start the writeback of the completed window
+    sync_file_range(m_fd, m_written, window_end - m_written, SYNC_FILE_RANGE_WRITE);
+    m_written = window_end;
+}
+
+bool MMapFile::advise(const MMapAdvice advice) {
+    return m_data && madvise(m_data, m_capacity, madvise_flag(advice)) == 0;
+}
@@ -1,9 +1,10 @@
+#include <algorithm>
+#include <tdc/math/bit_mask.hpp>
 #include <tdc/vec/bit_vector.hpp>
 
 using namespace tdc::vec;
 
-BitVector::BitVector(const std::vector<bool>& bits) : m_size(bits.size()) {
-    m_bits = allocate_integers(m_size, 1, false);
+BitVector::BitVector(const std::vector<bool>& bits) : m_size(bits.size()), m_bits(math::idiv_ceil(bits.size(), 64ULL), false) {
     
     // TODO: is there a faster way?
     for(size_t i = 0; i < m_size; i++) {
@@ -12,6 +13,21 @@ BitVector::BitVector(const std::vector<bool>& bits) : m_size(bits.size()) {
 }
 
 void BitVector::resize(const size_t size) {
+    if(m_bits.is_file()) {
+        // clear the bits beyond the current size in the last block, the file is extended with zeroes
+        const size_t num_blocks = m_bits.size();
+        if(size > m_size && m_size < num_blocks * 64ULL) {
+            const size_t end = std::min(size, size_t(num_blocks * 64ULL));
+            const size_t lo = m_size & 63ULL;
+            const size_t hi = ((end - 1ULL) & 63ULL) + 1ULL;
+            m_bits[block(m_size)] &= ~(math::bit_mask<uint64_t>(hi) & ~math::bit_mask<uint64_t>(lo));
+        }
+
+        m_bits.resize(math::idiv_ceil(size, 64ULL));
+        m_size = size;
+        return;
+    }
+
     BitVector new_bv(size, size >= m_size); // no initialization needed if new size is smaller
 
     const size_t num_to_copy = std::min(size, m_size);
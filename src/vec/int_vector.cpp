@@ -62,7 +62,69 @@ void IntVector::set(const size_t i, const uint64_t v_) {
     }
 }
 
+namespace {
+
+// sets the bits in [from, to) to zero
+void clear_bits(uint64_t* data, const size_t from, const size_t to) {
+    if(from >= to) return;
+
+    const size_t a = from >> 6ULL;
+    const size_t b = (to - 1ULL) >> 6ULL;
+    const uint64_t mask_a = ~tdc::math::bit_mask<uint64_t>(from & 63ULL);
+    const uint64_t mask_b = tdc::math::bit_mask<uint64_t>(((to - 1ULL) & 63ULL) + 1ULL);
+    if(a == b) {
+        data[a] &= ~(mask_a & mask_b);
+    } else {
+        data[a] &= ~mask_a;
+        std::fill(data + a + 1, data + b, 0ULL);
+        data[b] &= ~mask_b;
+    }
+}
+
+}
+
+void IntVector::resize_in_place(const size_t size, const size_t width) {
+    const size_t old_width = m_width;
+    const uint64_t old_mask = m_mask;
+    const uint64_t new_mask = math::bit_mask<uint64_t>(width);
+    const size_t old_num_words = m_data.size();
+    const size_t new_num_words = math::idiv_ceil(size * width, 64ULL);
+    const size_t num_to_keep = std::min(size, m_size);
+
+    // the file is extended with zeroes
+    if(new_num_words > old_num_words) m_data.resize(new_num_words);
+
+    // re-pack the kept integers if the width changes, moving from the back if they grow so nothing is overwritten before it is read
+    auto repack = [&](const size_t i){
+        m_width = old_width;
+        m_mask = old_mask;
+        const uint64_t v = get(i);
+        m_width = width;
+        m_mask = new_mask;
+        set(i, v);
+    };
+
+    if(width > old_width) {
+        for(size_t i = num_to_keep; i > 0; i--) repack(i - 1);
+    } else if(width < old_width) {
+        for(size_t i = 0; i < num_to_keep; i++) repack(i);
+    }
+    m_width = width;
+    m_mask = new_mask;
+
+    // clear what remains of the old contents beyond the kept integers
+    clear_bits(m_data.data(), num_to_keep * width, std::min(size * width, size_t(old_num_words * 64ULL)));
+
+    if(new_num_words < m_data.size()) m_data.resize(new_num_words);
+    m_size = size;
+}
+
 void IntVector::resize(const size_t size, const size_t width) {
+    if(m_data.is_file()) {
+        resize_in_place(size, width);
+        return;
+    }
+
     IntVector new_iv(size, width, size * width >= m_size * m_width); // no initialization needed if new size is smaller
     
     const size_t num_to_copy = std::min(size, m_size);
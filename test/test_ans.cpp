@@ -0,0 +1,171 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <tdc/code/ans/rans_coder.hpp>
+#include <tdc/code/ans/tans_coder.hpp>
+#include <tdc/test/assert.hpp>
+
+using namespace tdc::code;
+
+template<typename coder_t, typename T>
+void test_roundtrip(const std::vector<T>& values) {
+    std::ostringstream enc;
+    {
+        BitOStream out(enc);
+        coder_t coder;
+        coder.encode_init(out, values.data(), values.size());
+        for(const auto v : values) coder.encode(out, v);
+    }
+
+    const auto s = enc.str();
+    {
+        BitIStream in(s.data(), s.size());
+        coder_t coder;
+        coder.decode_init(in);
+        for(const auto v : values) ASSERT_EQ(coder.template decode<T>(in), v);
+        ASSERT_TRUE(in.eof());
+    }
+    {
+        BitIStream in(s.data(), s.size());
+        coder_t coder;
+        coder.decode_init(in);
+        std::vector<T> dec(values.size());
+        // odd chunk sizes to test realignment with the interleaved states
+        for(size_t i = 0; i < dec.size();) {
+            const size_t n = std::min(dec.size() - i, size_t(1 + i % 7));
+            coder.decode(in, std::span<T>(dec.data() + i, n));
+            i += n;
+        }
+        ASSERT_TRUE((dec == values));
+        ASSERT_TRUE(in.eof());
+    }
+}
+
+// simulates an LZ77 factor stream: literals and lengths are each coded with their own coder, mixed with flag bits on one stream
+template<typename coder_t>
+void test_mixed(std::mt19937_64& gen) {
+    const size_t n = 10000;
+    std::vector<bool> is_literal(n);
+    std::vector<uint8_t> literals;
+    std::vector<uint32_t> lengths;
+    for(size_t i = 0; i < n; i++) {
+        is_literal[i] = gen() % 3 != 0;
+        if(is_literal[i]) literals.push_back(uint8_t('a' + std::min(gen() % 26, gen() % 26)));
+        else lengths.push_back(uint32_t(2 + std::min(gen() % 1000, gen() % 1000)));
+    }
+
+    std::ostringstream enc;
+    {
+        BitOStream out(enc);
+        coder_t lit_coder, len_coder;
+        lit_coder.encode_init(out, literals.data(), literals.size());
+        len_coder.encode_init(out, lengths.data(), lengths.size());
+
+        size_t l = 0, r = 0;
+        for(size_t i = 0; i < n; i++) {
+            out.write_bit(is_literal[i]);
+            if(is_literal[i]) lit_coder.encode(out, literals[l++]);
+            else len_coder.encode(out, lengths[r++]);
+        }
+    }
+
+    std::istringstream enc_in(enc.str());
+    BitIStream in(enc_in);
+    coder_t lit_coder, len_coder;
+    lit_coder.decode_init(in);
+    len_coder.decode_init(in);
+
+    size_t l = 0, r = 0;
+    for(size_t i = 0; i < n; i++) {
+        ASSERT_EQ(in.read_bit(), is_literal[i]);
+        if(is_literal[i]) {
+            ASSERT_EQ(lit_coder.template decode<uint8_t>(in), literals[l++]);
+        } else {
+            ASSERT_EQ(len_coder.template decode<uint32_t>(in), lengths[r++]);
+        }
+    }
+    ASSERT_TRUE(in.eof());
+}
+
+template<typename coder_t>
+void test_block(const std::vector<uint8_t>& s) {
+    // two blocks in a row, the second being a suffix of the first
+    const std::vector<uint8_t> t(s.begin() + s.size() / 3, s.end());
+
+    std::ostringstream enc;
+    coder_t coder;
+    const size_t bytes_s = coder.encode(s.data(), s.size(), enc);
+    const size_t bytes_t = coder.encode(t.data(), t.size(), enc);
+
+    const auto buf = enc.str();
+    ASSERT_EQ(buf.size(), bytes_s + bytes_t);
+
+    std::vector<uint8_t> dec;
+    coder_t decoder;
+    ASSERT_EQ(decoder.decode(buf.data(), buf.size(), dec), bytes_s);
+    ASSERT_TRUE((dec == s));
+    ASSERT_EQ(decoder.decode(buf.data() + bytes_s, buf.size() - bytes_s, dec), bytes_t);
+    ASSERT_TRUE((dec == t));
+}
+
+template<typename coder_t>
+void test_blocks(std::mt19937_64& gen) {
+    test_block<coder_t>(std::vector<uint8_t>());
+    test_block<coder_t>(std::vector<uint8_t>{ 42 });
+    test_block<coder_t>(std::vector<uint8_t>(1000, 7));
+
+    for(size_t sigma : { 2, 26, 256 }) {
+        for(size_t n : { 10, 1001, 100000 }) {
+            std::vector<uint8_t> values(n);
+            for(auto& v : values) v = uint8_t(std::min(gen() % sigma, gen() % sigma));
+            test_block<coder_t>(values);
+        }
+    }
+}
+
+template<typename coder_t>
+void test(std::mt19937_64& gen) {
+    test_roundtrip<coder_t>(std::vector<uint8_t>());
+    test_roundtrip<coder_t>(std::vector<uint8_t>{ 42 });
+    test_roundtrip<coder_t>(std::vector<uint8_t>(1000, 7));
+
+    for(size_t sigma : { 2, 26, 256 }) {
+        for(size_t n : { 10, 1000, 100000 }) {
+            // skewed distribution
+            std::vector<uint8_t> values(n);
+            for(auto& v : values) v = uint8_t(std::min(gen() % sigma, gen() % sigma));
+            test_roundtrip<coder_t>(values);
+        }
+    }
+
+    // a large alphabet requiring a scale beyond the requested one
+    {
+        std::vector<uint32_t> values(200000);
+        for(auto& v : values) v = uint32_t(gen() % 20000);
+        test_roundtrip<coder_t>(values);
+    }
+
+    test_mixed<coder_t>(gen);
+}
+
+int main(int argc, char** argv) {
+    std::mt19937_64 gen(67);
+
+    std::cout << "test rANS" << std::endl;
+    test<RANSCoder<>>(gen);
+    test<RANSCoder<11, 1>>(gen);
+    test<RANSCoder<16, 2>>(gen);
+    test_blocks<RANSCoder<>>(gen);
+    test_blocks<RANSCoder<11, 1>>(gen);
+    test_blocks<RANSCoder<16, 3>>(gen);
+
+    std::cout << "test tANS" << std::endl;
+    test<TANSCoder<>>(gen);
+    test<TANSCoder<9, 1>>(gen);
+    test<TANSCoder<16, 3>>(gen);
+}
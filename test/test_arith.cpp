@@ -0,0 +1,97 @@
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <tdc/code/arith/binary_range_coder.hpp>
+#include <tdc/code/arith/context_mixing_coder.hpp>
+#include <tdc/test/assert.hpp>
+
+using namespace tdc::code;
+
+void test_range_coder(std::mt19937_64& gen, const size_t n) {
+    // random bits with random, partly extreme probabilities
+    std::vector<uint32_t> probs(n);
+    std::vector<bool> bits(n);
+    for(size_t i = 0; i < n; i++) {
+        const uint32_t p = (gen() % 4 == 0) ? ((gen() & 1) ? 1 : BinaryRangeCoder::PROB_ONE - 1) : 1 + gen() % (BinaryRangeCoder::PROB_ONE - 1);
+        probs[i] = p;
+        bits[i] = (gen() % BinaryRangeCoder::PROB_ONE) < p;
+    }
+
+    // surround the arithmetic code by other data
+    std::ostringstream enc;
+    {
+        BitOStream out(enc);
+        out.write_binary(0b101U, 3);
+        BinaryRangeCoder rc;
+        for(size_t i = 0; i < n; i++) rc.encode(out, bits[i], probs[i]);
+        rc.encode_finalize(out);
+        out.write_delta(uint64_t(12345));
+    }
+
+    const auto buf = enc.str();
+    BitIStream in(buf.data(), buf.size());
+    ASSERT_EQ(in.read_binary<>(3), 5ULL);
+    BinaryRangeCoder rc;
+    rc.decode_init(in);
+    for(size_t i = 0; i < n; i++) ASSERT_EQ(rc.decode(in, probs[i]), bits[i]);
+    ASSERT_EQ(in.read_delta<>(), 12345ULL);
+    ASSERT_TRUE(in.eof());
+}
+
+template<typename coder_t>
+size_t test_roundtrip(const std::string& s) {
+    std::ostringstream enc;
+    {
+        BitOStream out(enc);
+        coder_t coder;
+        for(const char c : s) coder.encode(out, (uint8_t)c);
+        coder.encode_finalize(out);
+    }
+
+    const auto buf = enc.str();
+    BitIStream in(buf.data(), buf.size());
+    coder_t coder;
+    coder.decode_init(in);
+    std::string dec;
+    for(size_t i = 0; i < s.length(); i++) dec.push_back((char)coder.template decode<uint8_t>(in));
+    ASSERT_EQ(dec, s);
+    ASSERT_TRUE(in.eof());
+    return buf.size();
+}
+
+int main(int argc, char** argv) {
+    std::mt19937_64 gen(70);
+    for(const size_t n : { 0, 1, 10, 1000, 100000 }) {
+        test_range_coder(gen, n);
+    }
+
+    test_roundtrip<ContextMixingCoder<>>("");
+    test_roundtrip<ContextMixingCoder<>>("a");
+    test_roundtrip<ContextMixingCoder<>>("abracadabra");
+    test_roundtrip<ContextMixingCoder<>>(std::string("\0\xff\xff\x80\x7f", 5));
+
+    for(size_t sigma : { 2, 26, 256 }) {
+        for(size_t n : { 10, 1000, 100000 }) {
+            std::cout << "test sigma=" << sigma << " n=" << n << std::endl;
+            std::string s;
+            for(size_t i = 0; i < n; i++) s.push_back(char(std::min(gen() % sigma, gen() % sigma)));
+            test_roundtrip<ContextMixingCoder<>>(s);
+            test_roundtrip<ContextMixingCoder<9>>(s);
+        }
+    }
+
+    {
+        // an order-2 source, where each byte is mostly determined by the previous two
+        std::string s = "ab";
+        for(size_t i = 2; i < 100000; i++) {
+            const char c = (gen() % 16 == 0) ? char('a' + gen() % 26) : char('a' + (s[i - 1] * 7 + s[i - 2] * 3) % 26);
+            s.push_back(c);
+        }
+        const size_t bytes = test_roundtrip<ContextMixingCoder<>>(s);
+        std::cout << "order-2 source: " << bytes << " bytes for " << s.length() << " symbols" << std::endl;
+        ASSERT_TRUE((bytes * 4 < s.length()));
+    }
+}
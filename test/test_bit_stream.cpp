@@ -0,0 +1,155 @@
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <tdc/io/bit_istream.hpp>
+#include <tdc/io/bit_ostream.hpp>
+#include <tdc/test/assert.hpp>
+
+using namespace tdc::io;
+
+// writes a random sequence of codes determined by the seed
+std::string write_random(const uint64_t seed, const size_t num) {
+    std::mt19937_64 gen(seed);
+    std::ostringstream os;
+    {
+        BitOStream out(os);
+        for(size_t i = 0; i < num; i++) {
+            switch(gen() % 6) {
+                case 0: out.write_bit(gen() & 1); break;
+                case 1: { const size_t bits = gen() % 65; out.write_binary(gen(), bits); break; }
+                case 2: out.write_unary(gen() % 200); break;
+                case 3: out.write_gamma(gen() % 100000 + 1); break;
+                case 4: out.write_delta((gen() >> 1) + 1); break;
+                case 5: { const uint8_t p = gen() % 20; out.write_rice(gen() % 1000000, p); break; }
+            }
+        }
+    }
+    return os.str();
+}
+
+void read_random(BitIStream& in, const uint64_t seed, const size_t num) {
+    std::mt19937_64 gen(seed);
+    for(size_t i = 0; i < num; i++) {
+        ASSERT_FALSE(in.eof());
+        switch(gen() % 6) {
+            case 0: ASSERT_EQ(in.read_bit(), bool(gen() & 1)); break;
+            case 1: {
+                const size_t bits = gen() % 65;
+                const uint64_t v = gen();
+                ASSERT_EQ(in.read_binary<uint64_t>(bits), (bits ? (v & tdc::math::bit_mask<uint64_t>(bits)) : 0ULL));
+                break;
+            }
+            case 2: ASSERT_EQ(in.read_unary<uint64_t>(), gen() % 200); break;
+            case 3: ASSERT_EQ(in.read_gamma<uint64_t>(), gen() % 100000 + 1); break;
+            case 4: ASSERT_EQ(in.read_delta<uint64_t>(), (gen() >> 1) + 1); break;
+            case 5: { const uint8_t p = gen() % 20; ASSERT_EQ(in.read_rice<uint64_t>(p), gen() % 1000000); break; }
+        }
+    }
+    ASSERT_TRUE(in.eof());
+}
+
+void test_roundtrip(const uint64_t seed, const size_t num) {
+    const auto enc = write_random(seed, num);
+    {
+        std::istringstream is(enc);
+        BitIStream in(is);
+        read_random(in, seed, num);
+    }
+    {
+        BitIStream in(enc.data(), enc.size());
+        read_random(in, seed, num);
+    }
+}
+
+void test_format() {
+    // the number of valid bits in the last byte is stored in its lowest three bits
+    {
+        std::ostringstream os;
+        {
+            BitOStream out(os);
+            out.write_binary(0b101U, 3);
+        }
+        ASSERT_EQ(os.str(), std::string("\xA3", 1));
+    }
+
+    // if there is no room, it is stored in an additional byte
+    {
+        std::ostringstream os;
+        {
+            BitOStream out(os);
+            out.write_binary(0b1111111U, 7);
+        }
+        ASSERT_EQ(os.str(), std::string("\xFE\x07", 2));
+    }
+
+    // an empty stream consists of the lead-out only
+    {
+        std::ostringstream os;
+        {
+            BitOStream out(os);
+        }
+        ASSERT_EQ(os.str(), std::string("\x00", 1));
+
+        std::istringstream is(os.str());
+        BitIStream in(is);
+        ASSERT_TRUE(in.eof());
+    }
+}
+
+void test_block_boundaries() {
+    // streams whose size is close to a multiple of the internal buffer size
+    for(size_t bytes : { 64_Ki - 1, 64_Ki, 64_Ki + 1, 128_Ki }) {
+        for(size_t extra_bits = 0; extra_bits < 8; extra_bits++) {
+            const size_t bits = (bytes - 2) * 8 + extra_bits;
+
+            std::ostringstream os;
+            {
+                BitOStream out(os);
+                for(size_t i = 0; i < bits; i++) out.write_bit(i % 3 == 0);
+            }
+
+            std::istringstream is(os.str());
+            BitIStream in(is);
+            for(size_t i = 0; i < bits; i++) {
+                ASSERT_FALSE(in.eof());
+                ASSERT_EQ(in.read_bit(), (i % 3 == 0));
+            }
+            ASSERT_TRUE(in.eof());
+        }
+    }
+}
+
+void test_peek_skip() {
+    std::mt19937_64 gen(65);
+    std::vector<uint64_t> values(10000);
+    for(auto& v : values) v = gen();
+
+    std::ostringstream os;
+    {
+        BitOStream out(os);
+        for(const auto v : values) out.write_binary(v, 64);
+    }
+
+    const auto enc = os.str();
+    BitIStream in(enc.data(), enc.size());
+    for(size_t i = 0; i < values.size(); i++) {
+        const size_t bits = 1 + i % BitIStream::PEEK_BITS;
+        ASSERT_EQ(in.peek_binary<uint64_t>(bits), (values[i] >> (64 - bits)));
+        in.skip(bits);
+        ASSERT_EQ(in.read_binary<uint64_t>(64 - bits), (values[i] & tdc::math::bit_mask<uint64_t>(64 - bits)));
+    }
+    ASSERT_TRUE(in.eof());
+}
+
+int main(int argc, char** argv) {
+    test_format();
+    test_block_boundaries();
+    test_peek_skip();
+
+    for(uint64_t seed = 0; seed < 100; seed++) {
+        test_roundtrip(seed, seed);
+        test_roundtrip(seed, 10000 + seed * 100);
+    }
+}
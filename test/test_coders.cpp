@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <tdc/code/binary_coder.hpp>
+#include <tdc/code/delta_coder.hpp>
+#include <tdc/code/delta0_coder.hpp>
+#include <tdc/code/rice_coder.hpp>
+#include <tdc/test/assert.hpp>
+
+using namespace tdc::code;
+
+// encodes values one by one and in a batch, and decodes both encodings in either way
+template<typename T, typename coder_t>
+void test_batch(coder_t coder, const std::vector<T>& values) {
+    std::ostringstream scalar_enc;
+    {
+        BitOStream out(scalar_enc);
+        for(const auto v : values) coder.encode(out, v);
+    }
+
+    std::ostringstream batch_enc;
+    {
+        BitOStream out(batch_enc);
+        coder.encode(out, std::span<const T>(values));
+    }
+    ASSERT_EQ(scalar_enc.str(), batch_enc.str());
+
+    const auto enc = batch_enc.str();
+    {
+        BitIStream in(enc.data(), enc.size());
+        for(const auto v : values) ASSERT_EQ(coder.template decode<T>(in), v);
+        ASSERT_TRUE(in.eof());
+    }
+    {
+        // decode in chunks of varying size
+        BitIStream in(enc.data(), enc.size());
+        std::vector<T> dec(values.size());
+        size_t i = 0;
+        for(size_t chunk = 1; i < dec.size(); chunk = chunk * 2 + 1) {
+            const size_t n = std::min(chunk, dec.size() - i);
+            coder.decode(in, std::span<T>(dec.data() + i, n));
+            i += n;
+        }
+        ASSERT_TRUE((dec == values));
+        ASSERT_TRUE(in.eof());
+    }
+}
+
+template<typename T>
+std::vector<T> random_values(std::mt19937_64& gen, const size_t n, const size_t max_bits, const uint64_t min) {
+    std::vector<T> values(n);
+    for(auto& v : values) {
+        // geometric-like distribution of magnitudes, with the occasional large value
+        const size_t bits = (gen() % 8 == 0) ? gen() % (max_bits + 1) : gen() % std::min(max_bits + 1, size_t(12));
+        const uint64_t x = bits ? (gen() & tdc::math::bit_mask<uint64_t>(bits)) : 0;
+        v = T(std::max(x, min));
+    }
+    return values;
+}
+
+int main(int argc, char** argv) {
+    std::mt19937_64 gen(66);
+
+    for(const size_t n : { 0, 1, 10, 1000, 100000 }) {
+        std::cout << "test n=" << n << std::endl;
+
+        test_batch<uint8_t>(BinaryCoder<8>(), random_values<uint8_t>(gen, n, 8, 0));
+        test_batch<uint64_t>(BinaryCoder<13>(), random_values<uint64_t>(gen, n, 13, 0));
+        test_batch<uint64_t>(BinaryCoder<64>(), random_values<uint64_t>(gen, n, 64, 0));
+
+        test_batch<uint64_t>(DeltaCoder(), random_values<uint64_t>(gen, n, 63, 1));
+        test_batch<uint32_t>(DeltaCoder(), random_values<uint32_t>(gen, n, 32, 1));
+        test_batch<uint8_t>(Delta0Coder(), random_values<uint8_t>(gen, n, 8, 0));
+        test_batch<uint64_t>(Delta0Coder(), random_values<uint64_t>(gen, n, 62, 0));
+
+        for(const size_t p : { 0, 1, 4, 8, 20 }) {
+            test_batch<uint8_t>(RiceCoder(p), random_values<uint8_t>(gen, n, 8, 0));
+            test_batch<uint64_t>(RiceCoder(p), random_values<uint64_t>(gen, n, p + 20, 0));
+        }
+    }
+}
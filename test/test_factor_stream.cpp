@@ -0,0 +1,138 @@
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include <tdc/comp/lz77/factor_buffer.hpp>
+#include <tdc/comp/lz77/factor_stream_index.hpp>
+#include <tdc/comp/lz77/factor_stream_index_output.hpp>
+#include <tdc/comp/lz77/factor_stream_output.hpp>
+#include <tdc/comp/lz77/factor_stream_reader.hpp>
+#include <tdc/io/mmap_file.hpp>
+#include <tdc/test/assert.hpp>
+
+using namespace tdc::comp::lz77;
+
+std::string filename = "factors";
+std::string index_filename = "factors.index";
+
+// generates a random factorization of a text of length n
+FactorBuffer random_factors(std::mt19937_64& gen, const size_t n, const size_t max_len) {
+    FactorBuffer buf;
+    while(buf.input_size() < n) {
+        const size_t i = buf.input_size();
+        if(i == 0 || gen() % 3 == 0) {
+            buf.emplace_back(tdc::char_t(gen()));
+        } else {
+            const size_t len = std::min(n - i, 1 + gen() % max_len);
+            const size_t dist = 1 + (gen() % 2 ? gen() % i : gen() % std::min(i, size_t(100)));
+            buf.emplace_back(i - dist, len);
+        }
+    }
+    return buf;
+}
+
+void write(const FactorBuffer& buf) {
+    std::ofstream out(filename);
+    FactorStreamOutput stream(out, 64); // small buffer to exercise flushing
+    for(const auto& f : buf.factors()) stream.emplace_back(f);
+}
+
+void test_roundtrip(const FactorBuffer& buf) {
+    write(buf);
+
+    tdc::io::MMapReadOnlyFile file(filename);
+    FactorStreamReader reader(file);
+    for(const auto& f : buf.factors()) {
+        ASSERT_TRUE(reader);
+        const auto g = reader.read();
+        ASSERT_EQ(f.src, g.src);
+        ASSERT_EQ(f.len, g.len);
+    }
+    ASSERT_FALSE(reader);
+    ASSERT_EQ(reader.pos(), buf.input_size());
+}
+
+void test_merge(const FactorBuffer& a, const FactorBuffer& b) {
+    FactorBuffer expected;
+    FactorBuffer::merge(a, b, expected);
+
+    write(b);
+    tdc::io::MMapReadOnlyFile file(filename);
+    FactorBuffer merged;
+    FactorBuffer::merge(FactorBuffer::Reader(a), FactorStreamReader(file), merged);
+
+    ASSERT_EQ(expected.size(), merged.size());
+    for(size_t i = 0; i < expected.size(); i++) {
+        ASSERT_EQ(expected.factors()[i].src, merged.factors()[i].src);
+        ASSERT_EQ(expected.factors()[i].len, merged.factors()[i].len);
+    }
+}
+
+// decodes a factorization
+std::vector<tdc::char_t> decode(const FactorBuffer& buf) {
+    std::vector<tdc::char_t> text;
+    for(const auto& f : buf.factors()) {
+        if(f.is_reference()) {
+            for(size_t k = 0; k < f.len; k++) text.push_back(text[f.src + k]);
+        } else {
+            text.push_back(f.literal());
+        }
+    }
+    return text;
+}
+
+void test_index(std::mt19937_64& gen, const FactorBuffer& buf, const size_t interval, const size_t max_window) {
+    const auto text = decode(buf);
+    {
+        std::ofstream out(filename);
+        std::ofstream index(index_filename);
+        FactorStreamIndexOutput stream(text.data(), out, index, interval, max_window);
+        for(const auto& f : buf.factors()) stream.emplace_back(f);
+    }
+
+    tdc::io::MMapReadOnlyFile file(filename);
+    tdc::io::MMapReadOnlyFile index_file(index_filename);
+    FactorStreamIndex index(file, index_file);
+    ASSERT_EQ(index.size(), text.size());
+
+    for(size_t q = 0; q < 100; q++) {
+        const size_t pos = gen() % text.size();
+        const size_t len = std::min(text.size() - pos, size_t(1 + gen() % 100));
+        const auto s = index.extract(pos, len);
+        ASSERT_TRUE(std::equal(s.begin(), s.end(), text.begin() + pos));
+    }
+
+    // whole text
+    const auto s = index.extract(0, text.size());
+    ASSERT_TRUE(std::equal(s.begin(), s.end(), text.begin()));
+}
+
+int main(int argc, char** argv) {
+    std::mt19937_64 gen(55);
+    for(size_t n : { 1, 2, 10, 100, 10000 }) {
+        std::cout << "test n=" << n << std::endl;
+        for(size_t max_len : { 1, 8, 1000 }) {
+            test_roundtrip(random_factors(gen, n, max_len));
+            test_merge(random_factors(gen, n, max_len), random_factors(gen, n, max_len));
+            for(size_t interval : { 1, 16, 1000 }) {
+                for(size_t max_window : { 0, 8, 100000 }) {
+                    test_index(gen, random_factors(gen, n, max_len), interval, max_window);
+                }
+            }
+        }
+    }
+
+    // large values
+    {
+        FactorBuffer buf;
+        buf.emplace_back('a');
+        buf.emplace_back(0, tdc::index_t(1) << 40);
+        buf.emplace_back(0, 5);
+        test_roundtrip(buf);
+    }
+
+    std::filesystem::remove(filename);
+    std::filesystem::remove(index_filename);
+}
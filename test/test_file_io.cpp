@@ -0,0 +1,121 @@
+#include <tdc/io/file_reader.hpp>
+#include <tdc/io/file_writer.hpp>
+#include <tdc/test/assert.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace tdc::io;
+
+std::string filename = "output";
+
+std::string contents() {
+    std::ifstream file(filename);
+    std::ostringstream s;
+    s << file.rdbuf();
+    return s.str();
+}
+
+void test(const std::string& text, const FileBackend backend, const bool direct) {
+    for(size_t depth : { 1, 4 }) {
+        for(size_t bufsize : { 1, 5000 }) {
+            // write item by item, flushing in between
+            {
+                FileWriter<char> writer(filename, bufsize, depth, direct, backend);
+                if(backend != FileBackend::automatic) ASSERT_EQ(writer.backend(), backend);
+
+                for(size_t i = 0; i < text.length(); i++) {
+                    writer.write(text[i]);
+                    if(i == text.length() / 3) {
+                        // flushing makes the written data visible
+                        writer.flush();
+                        ASSERT_EQ(contents(), text.substr(0, i + 1));
+                    }
+                }
+            }
+            ASSERT_EQ(contents(), text);
+
+            // read item by item and in bulk
+            {
+                FileReader<char> reader(filename, bufsize, depth, direct, backend);
+                if(backend != FileBackend::automatic) ASSERT_EQ(reader.backend(), backend);
+
+                std::string s;
+                for(size_t num = 1; reader; num = num * 2 + 1) {
+                    if(num % 3 == 0) {
+                        s.push_back(reader.read());
+                    } else {
+                        std::string chunk(num, 0);
+                        chunk.resize(reader.read(chunk.data(), num));
+                        s.append(chunk);
+                    }
+                }
+                ASSERT_EQ(s, text);
+            }
+
+            // items spanning blocks, where a partial item at the end is dropped
+            {
+                FileReader<uint32_t> reader(filename, bufsize, depth, direct, backend);
+                std::vector<uint32_t> items;
+                while(reader) items.push_back(reader.read());
+                ASSERT_EQ(items.size(), text.length() / sizeof(uint32_t));
+                ASSERT_TRUE((items.empty() || std::memcmp(items.data(), text.data(), items.size() * sizeof(uint32_t)) == 0));
+            }
+
+            // reader destroyed while reads are in flight
+            {
+                FileReader<char> reader(filename, bufsize, depth, direct, backend);
+                if(!text.empty()) ASSERT_EQ(reader.read(), text[0]);
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    std::mt19937_64 gen(72);
+    for(size_t n : { 0, 1, 10, 4096, 100000 }) {
+        std::string text;
+        for(size_t i = 0; i < n; i++) text.push_back(char(gen()));
+
+        for(bool direct : { false, true }) {
+            test(text, FileBackend::automatic, direct);
+            test(text, FileBackend::thread, direct);
+        }
+    }
+
+    // write errors are reported by flush, but not by the destructor
+    if(std::filesystem::exists("/dev/full")) {
+        for(const auto backend : { FileBackend::automatic, FileBackend::thread }) {
+            bool thrown = false;
+            try {
+                FileWriter<char> writer("/dev/full", 1, 4, false, backend);
+                for(size_t i = 0; i < 3 * FileBlockWriter::ALIGNMENT; i++) writer.write('x');
+                writer.flush();
+            } catch(const std::system_error&) {
+                thrown = true;
+            }
+            ASSERT_TRUE(thrown);
+
+            {
+                FileWriter<char> writer("/dev/full", 1, 4, false, backend);
+                writer.write('x');
+            }
+        }
+    }
+
+    // a missing file is reported
+    bool thrown = false;
+    try {
+        FileReader<char> reader("missing", 1);
+    } catch(const std::system_error&) {
+        thrown = true;
+    }
+    ASSERT_TRUE(thrown);
+
+    std::filesystem::remove(filename);
+}
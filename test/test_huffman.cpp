@@ -0,0 +1,186 @@
+#include <algorithm>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include <tdc/code/binary_coder.hpp>
+#include <tdc/code/delta_coder.hpp>
+#include <tdc/code/huff/block_adaptive_huffman_coder.hpp>
+#include <tdc/code/huff/forward_coder.hpp>
+#include <tdc/code/huff/huffman_coder.hpp>
+#include <tdc/code/huff/hybrid_forward_coder.hpp>
+#include <tdc/code/huff/knuth_coder.hpp>
+#include <tdc/code/huff/multi_stream_huffman_coder.hpp>
+#include <tdc/code/huff/package_merge.hpp>
+#include <tdc/code/huff/vitter_coder.hpp>
+#include <tdc/test/assert.hpp>
+
+using namespace tdc::code;
+
+template<typename coder_t>
+void test_roundtrip(const std::string& s) {
+    std::ostringstream enc;
+    {
+        BitOStream out(enc);
+        coder_t coder(s, out);
+        for(const char c : s) coder.encode(out, (uint8_t)c);
+    }
+
+    std::istringstream enc_in(enc.str());
+    BitIStream in(enc_in);
+    coder_t coder(in);
+    std::string dec;
+    for(size_t i = 0; i < s.length(); i++) dec.push_back((char)coder.decode(in));
+    ASSERT_EQ(dec, s);
+}
+
+void test_table(std::mt19937_64& gen) {
+    // random code lengths satisfying the Kraft equality, obtained by repeatedly splitting a random leaf
+    for(size_t sigma = 2; sigma <= 256; sigma++) {
+        std::vector<uint8_t> len = { 1, 1 };
+        while(len.size() < sigma) {
+            const size_t k = gen() % len.size();
+            if(len[k] >= 40) continue;
+            ++len[k];
+            len.push_back(len[k]);
+        }
+
+        uint8_t syms[256];
+        uint8_t lengths[256];
+        for(size_t c = 0; c < sigma; c++) {
+            syms[c] = uint8_t(255 - c);
+            lengths[syms[c]] = len[c];
+        }
+
+        CanonicalHuffmanTable table;
+        table.assign(syms, sigma, lengths);
+
+        std::string s;
+        for(size_t i = 0; i < 1000; i++) s.push_back(char(syms[gen() % sigma]));
+
+        std::ostringstream enc;
+        {
+            BitOStream out(enc);
+            for(const char c : s) table.encode(out, (uint8_t)c);
+        }
+        std::istringstream enc_in(enc.str());
+        BitIStream in(enc_in);
+        for(const char c : s) ASSERT_EQ(table.decode(in), (uint8_t)c);
+        ASSERT_TRUE(in.eof());
+    }
+}
+
+void test_package_merge(std::mt19937_64& gen) {
+    for(size_t n = 2; n <= 256; n++) {
+        // exponentially distributed weights, for which unlimited Huffman codes get long
+        std::vector<uint64_t> weights(n);
+        for(auto& w : weights) w = 1ULL << (gen() % 40);
+
+        // cost of an optimal unlimited code
+        uint64_t huffman_cost = 0;
+        {
+            std::priority_queue<uint64_t, std::vector<uint64_t>, std::greater<uint64_t>> queue(weights.begin(), weights.end());
+            while(queue.size() > 1) {
+                const auto a = queue.top(); queue.pop();
+                const auto b = queue.top(); queue.pop();
+                huffman_cost += a + b;
+                queue.push(a + b);
+            }
+        }
+
+        for(const size_t max_length : { size_t(8), size_t(15), size_t(60) }) {
+            if((1ULL << max_length) < n) continue;
+
+            std::vector<uint8_t> lengths(n);
+            package_merge(weights.data(), n, max_length, lengths.data());
+
+            // the code must be complete and respect the limit
+            double kraft = 0;
+            uint64_t cost = 0;
+            for(size_t i = 0; i < n; i++) {
+                ASSERT_TRUE((lengths[i] > 0 && lengths[i] <= max_length));
+                kraft += 1.0 / double(1ULL << lengths[i]);
+                cost += weights[i] * lengths[i];
+            }
+            ASSERT_TRUE((kraft == 1.0));
+            ASSERT_TRUE((cost >= huffman_cost));
+            if(max_length == 60) ASSERT_EQ(cost, huffman_cost);
+        }
+    }
+}
+
+template<typename coder_t>
+void test_block(const std::string& s) {
+    // two blocks in a row, the second being a suffix of the first
+    const std::string t = s.substr(s.length() / 3);
+
+    std::ostringstream enc;
+    coder_t coder;
+    const size_t bytes_s = coder.encode((const uint8_t*)s.data(), s.length(), enc);
+    const size_t bytes_t = coder.encode((const uint8_t*)t.data(), t.length(), enc);
+
+    const auto buf = enc.str();
+    ASSERT_EQ(buf.size(), bytes_s + bytes_t);
+
+    std::vector<uint8_t> dec;
+    coder_t decoder;
+    ASSERT_EQ(decoder.decode(buf.data(), buf.size(), dec), bytes_s);
+    ASSERT_TRUE((std::string(dec.begin(), dec.end()) == s));
+    ASSERT_EQ(decoder.decode(buf.data() + bytes_s, buf.size() - bytes_s, dec), bytes_t);
+    ASSERT_TRUE((std::string(dec.begin(), dec.end()) == t));
+}
+
+void test(const std::string& s) {
+    test_roundtrip<HuffmanCoder<BinaryCoder<8>>>(s);
+    test_roundtrip<HuffmanCoder<BinaryCoder<8>, 8>>(s);
+    test_roundtrip<ForwardCoder<BinaryCoder<8>, DeltaCoder>>(s);
+    test_roundtrip<HybridForwardCoder<BinaryCoder<8>, DeltaCoder>>(s);
+    test_roundtrip<KnuthCoder<BinaryCoder<8>>>(s);
+    test_roundtrip<VitterCoder<BinaryCoder<8>>>(s);
+    test_roundtrip<BlockAdaptiveHuffmanCoder<>>(s);
+    test_roundtrip<BlockAdaptiveHuffmanCoder<32, 8>>(s);
+    test_roundtrip<BlockAdaptiveHuffmanCoder<1000, 20>>(s);
+    test_block<MultiStreamHuffmanCoder<>>(s);
+    test_block<MultiStreamHuffmanCoder<1>>(s);
+    test_block<MultiStreamHuffmanCoder<3, 20>>(s);
+}
+
+int main(int argc, char** argv) {
+    std::mt19937_64 gen(63);
+    test_table(gen);
+    test_package_merge(gen);
+
+    test_block<MultiStreamHuffmanCoder<>>("");
+    test("a");
+    test("ab");
+    test("abracadabra");
+    test(std::string("\0\xff\xff\x80\x7f", 5));
+    for(size_t sigma : { 2, 26, 256 }) {
+        for(size_t n : { 10, 1000, 100000 }) {
+            std::cout << "test sigma=" << sigma << " n=" << n << std::endl;
+            std::string s;
+            for(size_t i = 0; i < n; i++) {
+                // skewed distribution for long codes
+                s.push_back(char(std::min(gen() % sigma, gen() % sigma)));
+            }
+            test(s);
+        }
+    }
+
+    // Fibonacci frequencies result in the longest codes, which take more than one table lookup
+    {
+        std::string s;
+        size_t a = 1, b = 1;
+        for(size_t c = 0; c < 24; c++) {
+            s.append(a, char('a' + c));
+            b = std::exchange(a, a + b);
+        }
+        std::shuffle(s.begin(), s.end(), gen);
+        test_block<MultiStreamHuffmanCoder<>>(s);
+        test_block<MultiStreamHuffmanCoder<3, 20>>(s);
+        test_block<MultiStreamHuffmanCoder<2, 57>>(s);
+    }
+}
@@ -0,0 +1,162 @@
+#include <tdc/io/async_buffered_reader.hpp>
+#include <tdc/io/async_buffered_writer.hpp>
+#include <tdc/io/buffered_reader.hpp>
+#include <tdc/io/buffered_writer.hpp>
+#include <tdc/io/input_source.hpp>
+#include <tdc/io/mmap_file.hpp>
+#include <tdc/test/assert.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+std::string filename = "input";
+
+// reads the input in chunks of the given size
+std::string read_chunks(tdc::io::InputSource& in, const size_t max) {
+    std::string s;
+    for(auto chunk = in.next(max); chunk.size() > 0; chunk = in.next(max)) {
+        ASSERT_LEQ(chunk.size(), max);
+        s.append(chunk);
+        ASSERT_EQ(in.pos(), s.length());
+    }
+    ASSERT_TRUE(in.eof());
+    return s;
+}
+
+void test(const std::string& text) {
+    {
+        std::ofstream file(filename);
+        file.write(text.data(), text.length());
+    }
+
+    // file, which is mapped to memory unless it is empty
+    for(size_t max : { size_t(1), size_t(7), size_t(1000), SIZE_MAX }) {
+        tdc::io::InputSource in(filename);
+        ASSERT_EQ(in.is_memory(), !text.empty());
+        ASSERT_EQ(read_chunks(in, max), text);
+    }
+
+    // memory mapped file
+    {
+        tdc::io::MMapReadOnlyFile file(filename);
+        tdc::io::InputSource in(file);
+        ASSERT_TRUE(in.is_memory());
+        ASSERT_EQ(in.size(), text.length());
+        const auto all = in.all();
+        ASSERT_EQ(std::string(all), text);
+        if(!text.empty()) ASSERT_EQ((const void*)all.data(), file.data()); // not copied
+    }
+
+    // stream
+    for(size_t bufsize : { 1, 7, 1000 }) {
+        std::istringstream stream(text);
+        tdc::io::InputSource in(stream, bufsize);
+        ASSERT_FALSE(in.is_memory());
+        ASSERT_EQ(read_chunks(in, SIZE_MAX), text);
+    }
+    {
+        std::istringstream stream(text);
+        tdc::io::InputSource in(stream);
+        ASSERT_EQ(std::string(in.all()), text);
+        ASSERT_EQ(in.pos(), text.length());
+    }
+
+    // copying reads and buffered reader, mixed
+    for(size_t num : { 1, 5, 1000 }) {
+        std::istringstream stream(text);
+        tdc::io::InputSource sources[] = { tdc::io::InputSource(text.data(), text.length()), tdc::io::InputSource(stream, 3) };
+        for(auto& in : sources) {
+            std::string s(num, 0);
+            s.resize(in.read(s.data(), num));
+
+            tdc::io::BufferedReader<char> reader(in, 4);
+            while(reader) s.push_back(reader.read());
+            ASSERT_EQ(s, text);
+        }
+    }
+
+    // asynchronous reader, item by item and in bulk
+    for(size_t bufsize : { 1, 7, 1000 }) {
+        std::istringstream stream(text);
+        tdc::io::InputSource sources[] = { tdc::io::InputSource(text.data(), text.length()), tdc::io::InputSource(stream, 3) };
+        for(auto& in : sources) {
+            tdc::io::AsyncBufferedReader<char> reader(in, bufsize);
+            std::string s;
+            for(size_t num = 1; reader; num = num * 2 + 1) {
+                if(num % 3 == 0) {
+                    s.push_back(reader.read());
+                } else {
+                    std::string chunk(num, 0);
+                    chunk.resize(reader.read(chunk.data(), num));
+                    s.append(chunk);
+                }
+            }
+            ASSERT_EQ(s, text);
+        }
+    }
+
+    // items spanning buffers, where a partial item at the end is dropped
+    {
+        std::istringstream stream(text);
+        tdc::io::AsyncBufferedReader<uint32_t> reader(stream, 5);
+        std::vector<uint32_t> items;
+        while(reader) items.push_back(reader.read());
+        ASSERT_EQ(items.size(), text.length() / sizeof(uint32_t));
+        ASSERT_TRUE((items.empty() || std::memcmp(items.data(), text.data(), items.size() * sizeof(uint32_t)) == 0));
+    }
+
+    // synchronous and asynchronous writers
+    for(size_t bufsize : { 1, 7, 1000 }) {
+        std::ostringstream sync_out, async_out;
+        {
+            tdc::io::BufferedWriter<char> sync_writer(sync_out, bufsize);
+            tdc::io::AsyncBufferedWriter<char> async_writer(async_out, bufsize);
+            for(size_t i = 0; i < text.length(); i++) {
+                sync_writer.write(text[i]);
+                async_writer.write(text[i]);
+                if(i == text.length() / 2) {
+                    // flushing makes the written data visible
+                    async_writer.flush();
+                    ASSERT_EQ(async_out.str(), text.substr(0, i + 1));
+                }
+            }
+        }
+        ASSERT_EQ(sync_out.str(), text);
+        ASSERT_EQ(async_out.str(), text);
+    }
+
+    // write errors are reported by the next write or by close, but not by the destructor
+    if(!text.empty()) {
+        for(const bool close : { false, true }) {
+            std::ostringstream out;
+            out.setstate(std::ios_base::badbit);
+
+            bool failed = false;
+            try {
+                tdc::io::AsyncBufferedWriter<char> writer(out, 7);
+                for(const char c : text) writer.write(c);
+                if(close) writer.close();
+            } catch(const std::ios_base::failure&) {
+                failed = true;
+            }
+
+            // the error of the first buffer is reported when the third one is started
+            ASSERT_EQ(failed, (close || text.length() > 14));
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    std::mt19937_64 gen(59);
+    for(size_t n : { 0, 1, 10, 1000, 100000 }) {
+        std::string text;
+        for(size_t i = 0; i < n; i++) text.push_back(char(gen()));
+        test(text);
+    }
+    std::filesystem::remove(filename);
+}
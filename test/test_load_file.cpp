@@ -0,0 +1,83 @@
+#include <tdc/io/load_file.hpp>
+#include <tdc/test/assert.hpp>
+#include <tdc/vec/int_vector.hpp>
+#include <tdc/vec/static_vector.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+const std::string binary_filename = "numbers.bin";
+const std::string text_filename = "numbers.txt";
+
+int main(int argc, char** argv) {
+    // large enough for several threads, with a number of items that is not a multiple of 64
+    const size_t n = 1'000'003;
+
+    std::vector<uint32_t> numbers(n);
+    for(size_t i = 0; i < n; i++) numbers[i] = uint32_t(i * 2654435761ULL) >> 7;
+    {
+        std::ofstream file(binary_filename);
+        file.write((const char*)numbers.data(), n * sizeof(uint32_t));
+    }
+    {
+        std::ofstream file(text_filename);
+        file << "  -1\n\n";
+        for(size_t i = 0; i < n; i++) file << numbers[i] << "\n";
+        file << "18446744073709551615";
+    }
+
+    // load with conversion
+    for(const size_t threads : { 1, 3, 0 }) {
+        auto v = tdc::io::load_file_as_vector_parallel<uint32_t, uint64_t>(binary_filename, threads);
+        ASSERT_EQ(v.size(), n);
+        for(size_t i = 0; i < n; i++) ASSERT_EQ(v[i], uint64_t(numbers[i]));
+
+        auto narrow = tdc::io::load_file_as_vector_parallel<uint32_t, uint8_t, tdc::vec::StaticVector<uint8_t>>(binary_filename, threads);
+        ASSERT_EQ(narrow.size(), n);
+        for(size_t i = 0; i < n; i++) ASSERT_EQ(narrow[i], uint8_t(numbers[i]));
+
+        // bit-packed with the width of the largest number
+        auto packed = tdc::io::load_file_as_vector_parallel<uint32_t, uint64_t, tdc::vec::IntVector>(binary_filename, threads);
+        ASSERT_EQ(packed.size(), n);
+        ASSERT_EQ(packed.width(), 25U);
+        for(size_t i = 0; i < n; i++) ASSERT_EQ(uint64_t(packed[i]), uint64_t(numbers[i]));
+    }
+
+    // load sequentially, using a buffer much smaller than the file
+    {
+        auto v = tdc::io::load_file_as_vector<uint32_t, uint64_t>(binary_filename, 1000);
+        ASSERT_EQ(v.size(), n);
+        for(size_t i = 0; i < n; i++) ASSERT_EQ(v[i], uint64_t(numbers[i]));
+    }
+
+    // map without copying
+    {
+        tdc::io::MappedVector<uint32_t> view(binary_filename);
+        ASSERT_EQ(view.size(), n);
+        ASSERT_TRUE(std::equal(view.begin(), view.end(), numbers.begin()));
+    }
+
+    // parse lines, skipping empty ones
+    for(const size_t threads : { 1, 3, 0 }) {
+        auto v = tdc::io::load_file_lines_as_vector<uint64_t>(text_filename, threads);
+        ASSERT_EQ(v.size(), n + 2);
+        ASSERT_EQ(v[0], UINT64_MAX);
+        for(size_t i = 0; i < n; i++) ASSERT_EQ(v[i + 1], uint64_t(numbers[i]));
+        ASSERT_EQ(v[n + 1], UINT64_MAX);
+    }
+
+    // failures are reported
+    {
+        bool thrown = false;
+        try {
+            tdc::io::load_file_as_vector_parallel<uint32_t>("missing");
+        } catch(const std::system_error&) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+    }
+
+    std::filesystem::remove(binary_filename);
+    std::filesystem::remove(text_filename);
+}
@@ -0,0 +1,119 @@
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include <tdc/code/binary_coder.hpp>
+#include <tdc/code/arith/context_mixing_coder.hpp>
+#include <tdc/code/huff/knuth_coder.hpp>
+#include <tdc/comp/lz77/factor_buffer.hpp>
+#include <tdc/comp/lz77/factor_coder.hpp>
+#include <tdc/comp/lz77/lz77_sa.hpp>
+#include <tdc/test/assert.hpp>
+
+using namespace tdc::comp::lz77;
+
+struct StatMap {
+    std::map<std::string, size_t> stats;
+
+    void log(const std::string& key, const size_t value) {
+        stats[key] = value;
+    }
+};
+
+// length of the longest previous factor starting at position i, computed naively
+size_t naive_lpf(const std::string& s, const size_t i) {
+    size_t max = 0;
+    for(size_t j = 0; j < i; j++) {
+        size_t len = 0;
+        while(i + len < s.length() && s[j + len] == s[i + len]) ++len;
+        max = std::max(max, len);
+    }
+    return max;
+}
+
+// encodes the factorization, surrounded by other data, and decodes it again
+template<typename LiteralCoder>
+void test_coding(const FactorBuffer& factors) {
+    std::ostringstream enc;
+    {
+        tdc::io::BitOStream out(enc);
+        out.write_binary(0b101U, 3);
+        FactorCoder<LiteralCoder>::encode(factors.factors(), out);
+        out.write_delta(uint64_t(12345));
+    }
+
+    const auto buf = enc.str();
+    tdc::io::BitIStream in(buf.data(), buf.size());
+    ASSERT_EQ(in.read_binary<>(3), 5ULL);
+    FactorBuffer dec;
+    FactorCoder<LiteralCoder>::decode(in, dec);
+    ASSERT_EQ(in.read_delta<>(), 12345ULL);
+    ASSERT_TRUE(in.eof());
+
+    ASSERT_EQ(dec.size(), factors.size());
+    for(size_t i = 0; i < factors.size(); i++) {
+        ASSERT_EQ(dec.factors()[i].src, factors.factors()[i].src);
+        ASSERT_EQ(dec.factors()[i].len, factors.factors()[i].len);
+    }
+    ASSERT_EQ(dec.decode(), factors.decode());
+}
+
+void test(const std::string& s, const size_t threshold, const std::string& work_dir) {
+    // the heap and the file-backed factorizations must both be the greedy parse
+    for(const size_t mem_limit : { SIZE_MAX, size_t(0) }) {
+        FactorBuffer factors;
+        LZ77SA c(threshold, work_dir, mem_limit);
+        c.compress((const tdc::char_t*)s.data(), s.length(), factors);
+
+        StatMap stats;
+        c.log_stats(stats);
+        ASSERT_EQ(stats.stats["file_backed"], size_t(mem_limit == 0 && !s.empty()));
+
+        ASSERT_EQ(factors.decode(), s);
+
+        size_t i = 0;
+        for(const auto& f : factors.factors()) {
+            const size_t lpf = naive_lpf(s, i);
+            if(lpf >= threshold) {
+                ASSERT_TRUE(f.is_reference());
+                ASSERT_EQ(size_t(f.len), lpf);
+            } else {
+                ASSERT_TRUE(f.is_literal());
+            }
+            i += f.decoded_length();
+        }
+
+        test_coding<tdc::code::KnuthCoder<tdc::code::BinaryCoder<8>>>(factors);
+        test_coding<tdc::code::ContextMixingCoder<16>>(factors);
+    }
+}
+
+int main(int argc, char** argv) {
+    const auto work_dir = std::filesystem::temp_directory_path() / "tdc-test-lz77-sa";
+    std::filesystem::create_directories(work_dir);
+
+    test("", 2, work_dir);
+    test("a", 2, work_dir);
+    test("aaaaaaaa", 2, work_dir);
+    test("abracadabra", 2, work_dir);
+    test("abracadabra", 4, work_dir);
+
+    std::mt19937_64 gen(52);
+    for(size_t sigma : { 2, 4, 26 }) {
+        for(size_t n : { 10, 100, 1000 }) {
+            std::cout << "test sigma=" << sigma << " n=" << n << std::endl;
+
+            std::string s;
+            for(size_t i = 0; i < n; i++) s.push_back(char('a' + gen() % sigma));
+            test(s, 2, work_dir);
+            test(s, 5, work_dir);
+        }
+    }
+
+    // the working files are removed right after they have been created
+    ASSERT_TRUE(std::filesystem::is_empty(work_dir));
+    std::filesystem::remove(work_dir);
+}
@@ -0,0 +1,61 @@
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include <tdc/comp/lz78/binary_trie.hpp>
+#include <tdc/comp/lz78/bounded_lz78.hpp>
+#include <tdc/comp/lz78/hash_trie.hpp>
+#include <tdc/comp/lz78/lz78.hpp>
+#include <tdc/comp/lz78/lzw.hpp>
+#include <tdc/test/assert.hpp>
+
+using namespace tdc::comp::lz78;
+
+template<typename compressor_t, typename decoder_t, typename... args_t>
+void test_roundtrip(const std::string& s, args_t... args) {
+    std::istringstream in(s);
+    std::ostringstream enc;
+    compressor_t c(args...);
+    c.compress(in, enc);
+
+    std::istringstream enc_in(enc.str());
+    std::ostringstream dec;
+    decoder_t d(args...);
+    d.decompress(enc_in, dec);
+    ASSERT_EQ(dec.str(), s);
+}
+
+void test(const std::string& s) {
+    for(const auto policy : { DictionaryPolicy::freeze, DictionaryPolicy::reset }) {
+        for(const size_t max : { size_t(2), size_t(3), size_t(100), size_t(300), size_t(4096), SIZE_MAX }) {
+            test_roundtrip<LZ78<BinaryTrie<char>>, LZ78Decoder>(s, max, policy);
+            test_roundtrip<LZ78<HashTrie<char>>, LZ78Decoder>(s, max, policy);
+            test_roundtrip<LZW<BinaryTrie<char>>, LZWDecoder>(s, max, policy);
+            test_roundtrip<LZW<HashTrie<char>>, LZWDecoder>(s, max, policy);
+        }
+    }
+    for(const size_t max : { size_t(2), size_t(3), size_t(4), size_t(100), size_t(4096) }) {
+        test_roundtrip<BoundedLZ78<LRUEviction>, BoundedLZ78Decoder<LRUEviction>>(s, max);
+        test_roundtrip<BoundedLZ78<LFUEviction>, BoundedLZ78Decoder<LFUEviction>>(s, max);
+    }
+}
+
+int main(int argc, char** argv) {
+    std::mt19937_64 gen(61);
+
+    test("");
+    test("a");
+    test("ab");
+    test("aaaaaaaaaaaaaaaaaaaa");
+    test("abababababababababababa");
+    test(std::string("\0\xff\x80\x7f", 4));
+    for(size_t sigma : { 2, 26, 256 }) {
+        for(size_t n : { 10, 1000, 100000 }) {
+            std::cout << "test sigma=" << sigma << " n=" << n << std::endl;
+            std::string s;
+            for(size_t i = 0; i < n; i++) s.push_back(char(gen() % sigma));
+            test(s);
+        }
+    }
+}
@@ -0,0 +1,68 @@
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include <tdc/comp/lz78/binary_trie.hpp>
+#include <tdc/comp/lz78/hash_trie.hpp>
+#include <tdc/comp/lz78/hybrid_trie.hpp>
+#include <tdc/comp/lz78/lz78.hpp>
+#include <tdc/test/assert.hpp>
+
+using namespace tdc::comp::lz78;
+
+template<typename trie_t>
+std::string compress(const std::string& s) {
+    std::istringstream in(s);
+    std::ostringstream out;
+    LZ78<trie_t> c;
+    c.compress(in, out);
+    return out.str();
+}
+
+void test(const std::string& s) {
+    const auto expected = compress<BinaryTrie<char>>(s);
+    ASSERT_EQ(compress<HashTrie<char>>(s), expected);
+    ASSERT_EQ((compress<HybridTrie<char>>(s)), expected);
+    ASSERT_EQ((compress<HybridTrie<char, 1>>(s)), expected);
+    ASSERT_EQ((compress<HybridTrie<char, 4>>(s)), expected);
+}
+
+void test_table(std::mt19937_64& gen) {
+    // insert and erase random edges, comparing against the trie semantics of a child map
+    TrieHashTable<char> table(2);
+    std::vector<std::pair<tdc::index_t, char>> edges;
+    for(size_t i = 0; i < 10000; i++) {
+        const tdc::index_t node = gen() % 100;
+        const char c = char(gen() % 8);
+        if(table.find(node, c) == 0) {
+            table.insert(node, c, i + 1);
+            edges.emplace_back(node, c);
+        }
+        if(gen() % 3 == 0 && !edges.empty()) {
+            const size_t k = gen() % edges.size();
+            table.erase(edges[k].first, edges[k].second);
+            ASSERT_EQ(table.find(edges[k].first, edges[k].second), 0);
+            edges.erase(edges.begin() + k);
+        }
+        ASSERT_EQ(table.size(), edges.size());
+    }
+    for(const auto& e : edges) ASSERT_NEQ(table.find(e.first, e.second), 0);
+}
+
+int main(int argc, char** argv) {
+    std::mt19937_64 gen(60);
+    test_table(gen);
+
+    test("");
+    test("a");
+    test("aaaaaaaaaaaaaaaaaaaa");
+    for(size_t sigma : { 2, 26, 256 }) {
+        for(size_t n : { 10, 1000, 100000 }) {
+            std::cout << "test sigma=" << sigma << " n=" << n << std::endl;
+            std::string s;
+            for(size_t i = 0; i < n; i++) s.push_back(char(gen() % sigma));
+            test(s);
+        }
+    }
+}
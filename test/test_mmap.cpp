@@ -1,8 +1,10 @@
 #include <tdc/io/mmap_file.hpp>
 #include <tdc/test/assert.hpp>
 
+#include <cstring>
 #include <fstream>
 #include <filesystem>
+#include <system_error>
 #include <type_traits>
 
 std::string filename = "numbers";
@@ -14,17 +16,102 @@ int main(int argc, char** argv) {
         std::ofstream file(filename);
         file.write((const char*)&numbers, sizeof(numbers));
     }
-    
+
     // map file and check numbers
     {
         auto mapped = tdc::io::MMapReadOnlyFile(filename);
         const uint64_t* data = (const uint64_t*)mapped.data();
-        
+
         for(size_t i = 0; i < std::extent<decltype(numbers)>::value; i++) {
             ASSERT_EQ(numbers[i], data[i]);
         }
+        ASSERT_TRUE(mapped.advise(tdc::io::MMapAdvice::sequential));
+    }
+
+    // map windows at unaligned offsets, cut off at the end of the file
+    {
+        tdc::io::MMapReadOnlyFile mapped(filename, 3 * sizeof(uint64_t), 2 * sizeof(uint64_t), true);
+        ASSERT_EQ(mapped.size(), 2 * sizeof(uint64_t));
+        ASSERT_EQ(mapped.file_size(), sizeof(numbers));
+        ASSERT_EQ(((const uint64_t*)mapped.data())[0], numbers[3]);
+        ASSERT_EQ(((const uint64_t*)mapped.data())[1], numbers[4]);
+
+        ASSERT_TRUE(mapped.map(6 * sizeof(uint64_t), SIZE_MAX));
+        ASSERT_EQ(mapped.offset(), 6 * sizeof(uint64_t));
+        ASSERT_EQ(mapped.size(), 2 * sizeof(uint64_t));
+        ASSERT_EQ(((const uint64_t*)mapped.data())[1], numbers[7]);
+
+        ASSERT_FALSE(mapped.map(sizeof(numbers), 1));
+        ASSERT_EQ(mapped.data(), nullptr);
+    }
+
+    // failures are reported
+    {
+        tdc::io::MMapReadOnlyFile mapped("missing");
+        ASSERT_EQ(mapped.data(), nullptr);
+        ASSERT_EQ(mapped.error(), ENOENT);
+    }
+
+    // open the file for writing and grow it
+    {
+        tdc::io::MMapFile mapped(filename);
+        ASSERT_EQ(mapped.size(), sizeof(numbers));
+        ASSERT_EQ(std::memcmp(mapped.data(), numbers, sizeof(numbers)), 0);
+
+        uint64_t* data = (uint64_t*)mapped.data();
+        data[0] = 100;
+
+        const size_t n = 100000;
+        for(size_t i = 8; i < n; i++) {
+            if((i + 1) * sizeof(uint64_t) > mapped.size()) {
+                mapped.resize((i + 1) * sizeof(uint64_t));
+                data = (uint64_t*)mapped.data();
+                ASSERT_EQ(data[i], 0U);
+            }
+            data[i] = i;
+        }
+        ASSERT_EQ(mapped.size(), n * sizeof(uint64_t));
+        ASSERT_GEQ(mapped.capacity(), mapped.size());
+        mapped.advise(tdc::io::MMapAdvice::huge_page); // may not be supported for files
+        mapped.sync();
+
+        // the changes are visible through the file
+        tdc::io::MMapReadOnlyFile check(filename);
+        const uint64_t* check_data = (const uint64_t*)check.data();
+        ASSERT_EQ(check.size(), n * sizeof(uint64_t));
+        ASSERT_EQ(check_data[0], 100U);
+        for(size_t i = 1; i < 8; i++) ASSERT_EQ(check_data[i], numbers[i]);
+        for(size_t i = 8; i < n; i++) ASSERT_EQ(check_data[i], i);
+
+        // shrink
+        mapped.resize(sizeof(uint64_t));
+        ASSERT_EQ(mapped.size(), sizeof(uint64_t));
+    }
+    ASSERT_EQ(std::filesystem::file_size(filename), sizeof(uint64_t));
+
+    // create a file of a given size
+    {
+        tdc::io::MMapFile mapped(filename, 3 * sizeof(uint64_t), true);
+        const uint64_t* data = (const uint64_t*)mapped.data();
+        ASSERT_EQ(data[0] + data[1] + data[2], 0U);
+
+        tdc::io::MMapFile empty(filename, 0);
+        ASSERT_EQ(empty.data(), nullptr);
+        empty.resize(1);
+        ASSERT_NEQ(empty.data(), nullptr);
+    }
+
+    // failures are reported
+    {
+        bool thrown = false;
+        try {
+            tdc::io::MMapFile mapped("missing/numbers");
+        } catch(const std::system_error&) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
     }
-    
+
     // remove file
     {
         std::filesystem::remove(filename);
@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <divsufsort.h>
+
+#include <tdc/util/lcp.hpp>
+#include <tdc/util/parallel_sa.hpp>
+#include <tdc/test/assert.hpp>
+
+using idx_t = uint32_t;
+
+// reference suffix array, computed using divsufsort for byte texts and naively for wider characters
+template<typename char_t>
+std::vector<idx_t> reference_sa(const std::vector<char_t>& text) {
+    const size_t n = text.size();
+    std::vector<idx_t> sa(n);
+    if constexpr(sizeof(char_t) == 1) {
+        std::vector<saidx_t> dsa(n);
+        if(n > 0) divsufsort((const sauchar_t*)text.data(), dsa.data(), saidx_t(n));
+        std::copy(dsa.begin(), dsa.end(), sa.begin());
+    } else {
+        std::iota(sa.begin(), sa.end(), idx_t(0));
+        std::sort(sa.begin(), sa.end(), [&](const idx_t a, const idx_t b){
+            return std::lexicographical_compare(text.begin() + a, text.end(), text.begin() + b, text.end());
+        });
+    }
+    return sa;
+}
+
+// reference LCP array, computed using Kasai et al. on the text with a unique zero-terminator appended
+template<typename char_t>
+std::vector<idx_t> reference_lcp(const std::vector<char_t>& text, const std::vector<idx_t>& sa) {
+    using uchar_t = std::make_unsigned_t<char_t>;
+    const size_t n = text.size();
+
+    // shift the alphabet so that the terminator does not occur in the text
+    std::vector<uint64_t> ztext(n + 1);
+    for(size_t i = 0; i < n; i++) ztext[i] = uint64_t((uchar_t)text[i]) + 1;
+    ztext[n] = 0;
+
+    // the terminator is the smallest suffix
+    std::vector<idx_t> zsa(n + 1);
+    zsa[0] = idx_t(n);
+    std::copy(sa.begin(), sa.end(), zsa.begin() + 1);
+
+    std::vector<idx_t> zlcp(n + 1), plcp(n + 1);
+    tdc::lcp_kasai(ztext.data(), n + 1, zsa.data(), zlcp.data(), plcp.data());
+
+    std::vector<idx_t> lcp(n);
+    for(size_t i = 1; i < n; i++) lcp[i] = zlcp[i + 1];
+    return lcp;
+}
+
+template<typename char_t>
+void test(const std::vector<char_t>& text) {
+    const size_t n = text.size();
+    const auto expected_sa = reference_sa(text);
+    const auto expected_lcp = reference_lcp(text, expected_sa);
+
+    for(const size_t num_threads : { 1, 2, 3, 4, 7 }) {
+        std::vector<idx_t> sa(n);
+        tdc::parallel_suffix_array(text.data(), n, sa.data(), num_threads);
+        ASSERT_TRUE((sa == expected_sa));
+
+        std::vector<idx_t> lcp(n), plcp(n);
+        tdc::lcp_phi_parallel(text.data(), n, sa.data(), lcp.data(), plcp.data(), num_threads);
+        ASSERT_TRUE((lcp == expected_lcp));
+    }
+}
+
+void test(const std::string& s) {
+    test(std::vector<char>(s.begin(), s.end()));
+}
+
+int main(int argc, char** argv) {
+    test("");
+    test("a");
+    test("ab");
+    test("ba");
+    test("abracadabra");
+
+    // a single repeated character yields a single group spanning all chunks until the last rounds
+    test(std::string(1000, 'a'));
+
+    // periodic texts yield groups spanning chunk boundaries in every round
+    for(const std::string period : { "ab", "abc", "abcabd" }) {
+        std::string s;
+        while(s.length() < 1000) s.append(period);
+        test(s);
+        test(s + "a");
+    }
+
+    std::mt19937_64 gen(53);
+    for(const size_t sigma : { 2, 4, 256 }) {
+        for(const size_t n : { 10, 100, 1000, 10000 }) {
+            std::cout << "test sigma=" << sigma << " n=" << n << std::endl;
+
+            std::vector<char> text(n);
+            for(auto& c : text) c = char(gen() % sigma);
+            test(text);
+        }
+    }
+
+    // with 32-bit characters, only two characters fit into the initial key
+    test(std::vector<uint32_t>(1000, 0xFFFFFFFFU));
+    for(const uint64_t sigma : { 2ULL, 1ULL << 32 }) {
+        for(const size_t n : { 1, 2, 3, 100, 1000 }) {
+            std::cout << "test 32-bit sigma=" << sigma << " n=" << n << std::endl;
+
+            std::vector<uint32_t> text(n);
+            for(auto& c : text) c = uint32_t(gen() % sigma);
+            test(text);
+        }
+    }
+}
@@ -0,0 +1,93 @@
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <tdc/comp/rlz/rlz.hpp>
+#include <tdc/test/assert.hpp>
+
+using namespace tdc::comp::rlz;
+
+struct StatMap {
+    std::map<std::string, size_t> stats;
+
+    void log(const std::string& key, const size_t value) {
+        stats[key] = value;
+    }
+};
+
+// number of factors of the greedy parse of s against ref, computed naively
+size_t naive_num_factors(const std::string& ref, const std::string& s, const size_t min_len) {
+    size_t num = 0;
+    for(size_t i = 0; i < s.length();) {
+        size_t len = 0;
+        while(i + len < s.length() && ref.find(s.substr(i, len + 1)) != std::string::npos) ++len;
+        i += (len >= min_len) ? len : 1;
+        ++num;
+    }
+    return num;
+}
+
+std::string mutate(std::mt19937_64& gen, std::string s, const size_t num_edits, const size_t sigma) {
+    for(size_t k = 0; k < num_edits && !s.empty(); k++) {
+        s[gen() % s.length()] = char('a' + gen() % sigma);
+    }
+    return s;
+}
+
+void test(const std::string& ref, const std::vector<std::string>& docs, const size_t min_len) {
+    RLZ rlz(std::vector<tdc::char_t>(ref.begin(), ref.end()), min_len);
+    size_t expected_factors = 0;
+    for(const auto& doc : docs) {
+        const size_t id = rlz.add((const tdc::char_t*)doc.data(), doc.length());
+        ASSERT_EQ(id, rlz.num_documents() - 1);
+        expected_factors += naive_num_factors(ref, doc, min_len);
+    }
+
+    StatMap stats;
+    rlz.log_stats(stats);
+    ASSERT_EQ(stats.stats["num_refs"] + stats.stats["num_literals"], expected_factors);
+
+    // decode documents in random order
+    std::mt19937_64 gen(57);
+    for(size_t k = 0; k < docs.size(); k++) {
+        const size_t i = gen() % docs.size();
+        ASSERT_EQ(rlz.document_size(i), docs[i].length());
+        const auto dec = rlz.decode(i);
+        ASSERT_EQ(std::string(dec.begin(), dec.end()), docs[i]);
+    }
+}
+
+int main(int argc, char** argv) {
+    std::mt19937_64 gen(57);
+
+    // empty reference and empty documents
+    test("", { "", "abc", "" }, 3);
+    test("abc", { "", "abcabc", "xyz" }, 1);
+
+    for(size_t sigma : { 2, 4, 26 }) {
+        for(size_t n : { 10, 100, 1000 }) {
+            std::cout << "test sigma=" << sigma << " n=" << n << std::endl;
+
+            std::string base;
+            for(size_t i = 0; i < n; i++) base.push_back(char('a' + gen() % sigma));
+
+            std::vector<std::string> docs;
+            for(size_t k = 0; k < 20; k++) docs.push_back(mutate(gen, base, 1 + n / 50, sigma));
+
+            std::string all;
+            for(const auto& doc : docs) all += doc;
+
+            for(size_t ref_size : { n / 2, n, 4 * n }) {
+                const auto sample = RLZ::sample_reference((const tdc::char_t*)all.data(), all.length(), ref_size, 16);
+                ASSERT_LEQ(sample.size(), ref_size);
+
+                const std::string ref(sample.begin(), sample.end());
+                for(size_t min_len : { 1, 3 }) {
+                    test(ref, docs, min_len);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include <tdc/comp/lz77/factor_buffer.hpp>
+#include <tdc/comp/lz77/lz77_sst.hpp>
+#include <tdc/test/assert.hpp>
+
+using namespace tdc::comp::lz77;
+
+// longest previous factor starting within the window, computed naively
+size_t longest_match(const std::string& s, const size_t i, const size_t w) {
+    size_t max = 0;
+    for(size_t j = (i > w ? i - w : 0); j < i; j++) {
+        size_t l = 0;
+        while(i + l < s.length() && s[j + l] == s[i + l]) ++l;
+        max = std::max(max, l);
+    }
+    return max;
+}
+
+void test(const std::string& s, const size_t w) {
+    std::istringstream in(s);
+    FactorBuffer buf;
+    LZ77SlidingSuffixTree c(w);
+    c.compress(in, buf);
+
+    // check that factors are greedy
+    size_t i = 0;
+    for(const auto& f : buf.factors()) {
+        const size_t max = std::min(longest_match(s, i, w), w); // factors are limited to the window size
+        if(f.is_reference()) {
+            ASSERT_GEQ(f.src + w, i);
+            ASSERT_LT(f.src, i);
+            ASSERT_EQ(f.len, max);
+        } else {
+            ASSERT_LEQ(max, 1);
+        }
+        i += f.decoded_length();
+    }
+    ASSERT_EQ(i, s.length());
+
+    // check that factorization decodes to the input
+    ASSERT_TRUE((buf.decode() == s));
+}
+
+int main(int argc, char** argv) {
+    std::mt19937 gen(147);
+    for(size_t w : { 1, 2, 3, 8, 17, 64 }) {
+        std::cout << "test w=" << w << std::endl;
+        for(size_t sigma : { 1, 2, 4, 26 }) {
+            for(size_t t = 0; t < 10; t++) {
+                // generate a random text with repetitions
+                const size_t n = gen() % 5000;
+                std::string s;
+                while(s.length() < n) {
+                    if(s.length() > 0 && gen() % 8 == 0) {
+                        const size_t src = gen() % s.length();
+                        const size_t len = gen() % (2 * w);
+                        for(size_t k = 0; k < len && s.length() < n; k++) s.push_back(s[src + k]);
+                    } else {
+                        s.push_back('a' + gen() % sigma);
+                    }
+                }
+                test(s, w);
+            }
+        }
+    }
+}
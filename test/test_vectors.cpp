@@ -1,8 +1,21 @@
+#include <filesystem>
+#include <memory>
 #include <numeric>
+#include <random>
 
+#include <tdc/vec/bit_rank.hpp>
+#include <tdc/vec/bit_select.hpp>
+#include <tdc/vec/bit_vector.hpp>
 #include <tdc/vec/fixed_width_int_vector.hpp>
+#include <tdc/vec/int_vector.hpp>
+#include <tdc/vec/static_vector.hpp>
 #include <tdc/test/assert.hpp>
 
+using namespace tdc::vec;
+
+// small write-behind window so that it is triggered while building
+const FileStorage storage { "vector", false, 4096 };
+
 template<size_t bits>
 void test_fixed_width_builder() {
     auto vec = typename tdc::vec::FixedWidthIntVector<bits>::builder_type(2);
@@ -42,6 +55,90 @@ void test_fixed_width_builder() {
     ASSERT_EQ(vec.capacity(), 3);
 }
 
+void test_file_int_vector() {
+    const size_t n = 100000;
+
+    // build sequentially
+    IntVectorBuilder builder(IntVector(0, 17, storage));
+    for(size_t i = 0; i < n; i++) builder.push_back(i * 7);
+    IntVector iv = builder.finalize();
+    ASSERT_TRUE(iv.is_file());
+    ASSERT_FALSE(std::filesystem::exists(storage.filename));
+    ASSERT_EQ(iv.size(), n);
+    for(size_t i = 0; i < n; i++) ASSERT_EQ(iv[i], ((i * 7) & 0x1FFFFULL));
+
+    // copies are on the heap
+    IntVector copy = iv;
+    ASSERT_FALSE(copy.is_file());
+    ASSERT_EQ(uint64_t(copy[n - 1]), uint64_t(iv[n - 1]));
+
+    // shrink and grow again, new integers are zero
+    iv.resize(n / 2 + 3);
+    iv.resize(n);
+    for(size_t i = 0; i < n / 2 + 3; i++) ASSERT_EQ(uint64_t(iv[i]), uint64_t(copy[i]));
+    for(size_t i = n / 2 + 3; i < n; i++) ASSERT_EQ(iv[i], 0U);
+
+    // change the width in place
+    iv.resize(n, 33);
+    ASSERT_EQ(iv.width(), 33U);
+    for(size_t i = 0; i < n / 2 + 3; i++) ASSERT_EQ(uint64_t(iv[i]), uint64_t(copy[i]));
+    for(size_t i = n / 2 + 3; i < n; i++) ASSERT_EQ(iv[i], 0U);
+
+    iv.resize(n / 4, 9);
+    iv.resize(n, 9);
+    for(size_t i = 0; i < n / 4; i++) ASSERT_EQ(iv[i], (copy[i] & 0x1FFULL));
+    for(size_t i = n / 4; i < n; i++) ASSERT_EQ(iv[i], 0U);
+}
+
+void test_file_static_vector() {
+    const size_t n = 100000;
+
+    StaticVector<uint32_t>::builder_type builder(StaticVector<uint32_t>(0, storage));
+    for(size_t i = 0; i < n; i++) builder.push_back(i * i);
+    StaticVector<uint32_t> v = builder.finalize();
+    ASSERT_TRUE(v.is_file());
+    ASSERT_EQ(v.size(), n);
+    for(size_t i = 0; i < n; i++) ASSERT_EQ(v[i], uint32_t(i * i));
+
+    v.resize(n + 1);
+    ASSERT_EQ(v[n], 0U);
+}
+
+void test_file_bit_vector() {
+    const size_t n = 1000003;
+
+    // build the same random bit vector on the heap and in a file
+    std::mt19937 gen(147);
+    std::bernoulli_distribution coin(0.3);
+    auto heap = std::make_shared<BitVector>(n);
+    BitVector::builder_type builder(BitVector(0, storage));
+    for(size_t i = 0; i < n; i++) {
+        const bool b = coin(gen);
+        (*heap)[i] = b;
+        builder.push_back(b);
+    }
+    auto file = std::make_shared<BitVector>(builder.finalize());
+    ASSERT_TRUE(file->is_file());
+    ASSERT_EQ(file->size(), n);
+
+    // rank and select work the same over both
+    BitRank rank_heap(heap), rank_file(file);
+    BitSelect1 select_heap(heap), select_file(file);
+    for(size_t i = 0; i < n; i += 17) ASSERT_EQ(rank_file(i), rank_heap(i));
+
+    const size_t num_ones = rank_heap(n - 1);
+    for(size_t k = 1; k <= num_ones; k += 13) ASSERT_EQ(select_file(k), select_heap(k));
+
+    // shrink and grow again, new bits are zero
+    file->resize(n - 40);
+    file->resize(n);
+    for(size_t i = 0; i < n - 40; i++) ASSERT_EQ(bool((*file)[i]), bool((*heap)[i]));
+    for(size_t i = n - 40; i < n; i++) ASSERT_FALSE((*file)[i]);
+}
+
 int main(int argc, char** argv) {
     test_fixed_width_builder<16>();
+    test_file_int_vector();
+    test_file_static_vector();
+    test_file_bit_vector();
 }